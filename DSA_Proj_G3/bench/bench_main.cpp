@@ -0,0 +1,363 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+#include "benchmark.h"
+#include "../include/trie.h"
+#include "../include/editdistance.h"
+#include "../include/bktree.h"
+#include "../include/bloomfilter.h"
+#include "../include/hashtable.h"
+#include "../include/lrucache.h"
+#include "../include/priorityqueue.h"
+#include "../include/filehandler.h"
+#include "../include/workload.h"
+#include "../include/tracing.h"
+#include "../include/jsonwriter.h"
+#include "../include/utils.h"
+
+/**
+ * Microbenchmarks for the core data structures
+ *
+ * Usage: benchmark [--dict file | --synthetic n] [--json file] [--filter text]
+ *                  [--samples n] [--warmup n] [--min-sample-us n]
+ *
+ * Inputs are the dictionary words plus misspellings derived from them
+ * with a fixed seed, so two runs on the same dictionary time the same
+ * operations.
+ */
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --dict <file>          Dictionary to benchmark with (default: data/dictionary.txt)\n"
+              << "  --synthetic <n>        Benchmark with n generated words instead (see workloadgen)\n"
+              << "  --json <file>          Write results as JSON (default: build/bench.json)\n"
+              << "  --filter <text>        Only run benchmarks whose name contains <text>\n"
+              << "  --samples <n>          Measured samples per benchmark (default: 50)\n"
+              << "  --warmup <n>           Discarded warmup samples (default: 5)\n"
+              << "  --min-sample-us <n>    Calibration target per sample (default: 1000)\n";
+}
+
+/**
+ * Misspell every word once: one random substitution, deletion,
+ * insertion or transposition (fixed seed)
+ */
+std::vector<std::string> makeTypos(const std::vector<std::string>& words) {
+    std::mt19937 rng(42);
+    std::vector<std::string> typos;
+    typos.reserve(words.size());
+
+    for (std::string word : words) {
+        if (word.size() < 2) {
+            typos.push_back(word);
+            continue;
+        }
+        size_t pos = rng() % word.size();
+        char letter = static_cast<char>('a' + rng() % 26);
+        switch (rng() % 4) {
+            case 0: word[pos] = letter; break;
+            case 1: word.erase(pos, 1); break;
+            case 2: word.insert(pos, 1, letter); break;
+            default:
+                if (pos + 1 < word.size()) std::swap(word[pos], word[pos + 1]);
+                else word[pos] = letter;
+                break;
+        }
+        typos.push_back(word);
+    }
+
+    // Shuffle so consecutive queries do not walk the same subtree
+    std::shuffle(typos.begin(), typos.end(), rng);
+    return typos;
+}
+
+/**
+ * Distinct 2-3 letter prefixes of the dictionary, as typed by a user
+ */
+std::vector<std::string> makePrefixes(const std::vector<std::string>& words) {
+    std::vector<std::string> prefixes;
+    for (size_t i = 0; i < words.size(); i++) {
+        size_t length = 2 + i % 2;
+        if (words[i].size() > length) {
+            prefixes.push_back(words[i].substr(0, length));
+        }
+    }
+    std::sort(prefixes.begin(), prefixes.end());
+    prefixes.erase(std::unique(prefixes.begin(), prefixes.end()), prefixes.end());
+    return prefixes;
+}
+
+int main(int argc, char* argv[]) {
+    std::string dictFile = "data/dictionary.txt";
+    std::string jsonFile = "build/bench.json";
+    size_t syntheticWords = 0;
+    BenchmarkSuite::Config config;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if (arg == "--dict" && i + 1 < argc) {
+            dictFile = argv[++i];
+        }
+        else if (arg == "--synthetic" && i + 1 < argc) {
+            syntheticWords = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--json" && i + 1 < argc) {
+            jsonFile = argv[++i];
+        }
+        else if (arg == "--filter" && i + 1 < argc) {
+            config.filter = argv[++i];
+        }
+        else if (arg == "--samples" && i + 1 < argc) {
+            config.samples = std::atoi(argv[++i]);
+        }
+        else if (arg == "--warmup" && i + 1 < argc) {
+            config.warmupSamples = std::atoi(argv[++i]);
+        }
+        else if (arg == "--min-sample-us" && i + 1 < argc) {
+            config.minSampleUs = std::atof(argv[++i]);
+        }
+        else if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        else {
+            Utils::logError("Unknown or incomplete option: " + arg);
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<std::pair<std::string, int>> dictionary;
+    if (syntheticWords > 0) {
+        WorkloadGenerator::DictionaryConfig synthetic;
+        synthetic.words = syntheticWords;
+        dictionary.reserve(syntheticWords);
+        WorkloadGenerator::generateDictionary(synthetic, [&dictionary](const std::string& word, int frequency) {
+            dictionary.push_back({word, frequency});
+        });
+        dictFile = "synthetic:" + std::to_string(syntheticWords);
+    } else {
+        dictionary = FileHandler::readDictionary(dictFile);
+    }
+    if (dictionary.empty()) {
+        Utils::logError("No words loaded from " + dictFile);
+        return 1;
+    }
+
+    std::vector<std::string> words;
+    words.reserve(dictionary.size());
+    for (const auto& entry : dictionary) {
+        words.push_back(entry.first);
+    }
+    std::vector<std::string> typos = makeTypos(words);
+    std::vector<std::string> prefixes = makePrefixes(words);
+    const size_t n = words.size();
+
+    // Structures shared by the read-only benchmarks
+    Trie trie;
+    BKTree bktree;
+    const int bloomBits = static_cast<int>(std::max<size_t>(10000, words.size() * 10));
+    BloomFilter bloom(bloomBits, 4);
+    HashTable table(1000);
+    for (const auto& entry : dictionary) {
+        trie.insertWord(entry.first, entry.second);
+        bktree.insert(entry.first);
+        bloom.addWord(entry.first);
+        table.insert(entry.first, entry.second);
+    }
+
+    BenchmarkSuite suite(config);
+    size_t cursor = 0;   // Rotates through the inputs across samples
+
+    // ---------- Trie ----------
+    Trie* insertTrie = nullptr;
+    suite.add("trie/insert",
+        [&]() { delete insertTrie; insertTrie = new Trie(); },
+        [&](size_t ops) {
+            for (size_t i = 0; i < ops; i++) {
+                insertTrie->insertWord(dictionary[i].first, dictionary[i].second);
+            }
+        }, n);
+    suite.add("trie/search_hit", [&](size_t ops) {
+        for (size_t i = 0; i < ops; i++) {
+            BenchmarkSuite::keep(trie.searchWord(words[cursor++ % n]));
+        }
+    });
+    suite.add("trie/search_miss", [&](size_t ops) {
+        for (size_t i = 0; i < ops; i++) {
+            BenchmarkSuite::keep(trie.searchWord(typos[cursor++ % n]));
+        }
+    });
+    suite.add("trie/suggest_top10", [&](size_t ops) {
+        for (size_t i = 0; i < ops; i++) {
+            BenchmarkSuite::keep(trie.suggestWords(prefixes[cursor++ % prefixes.size()], 10));
+        }
+    });
+
+    // ---------- Edit distance ----------
+    suite.add("editdistance/calculate", [&](size_t ops) {
+        for (size_t i = 0; i < ops; i++) {
+            size_t k = cursor++ % n;
+            BenchmarkSuite::keep(EditDistance::calculate(typos[k], words[k]));
+        }
+    });
+    suite.add("editdistance/calculateOptimized", [&](size_t ops) {
+        for (size_t i = 0; i < ops; i++) {
+            size_t k = cursor++ % n;
+            BenchmarkSuite::keep(EditDistance::calculateOptimized(typos[k], words[k]));
+        }
+    });
+
+    // ---------- BK-Tree ----------
+    for (int distance = 1; distance <= 3; distance++) {
+        suite.add("bktree/search_d" + std::to_string(distance), [&, distance](size_t ops) {
+            for (size_t i = 0; i < ops; i++) {
+                BenchmarkSuite::keep(bktree.searchByDistance(typos[cursor++ % n], distance));
+            }
+        });
+    }
+
+    // ---------- Bloom Filter ----------
+    BloomFilter* insertBloom = nullptr;
+    suite.add("bloomfilter/add",
+        [&]() { delete insertBloom; insertBloom = new BloomFilter(bloomBits, 4); },
+        [&](size_t ops) {
+            for (size_t i = 0; i < ops; i++) {
+                insertBloom->addWord(words[i]);
+            }
+        }, n);
+    suite.add("bloomfilter/contains", [&](size_t ops) {
+        for (size_t i = 0; i < ops; i++) {
+            // Alternate hits and (mostly) misses
+            size_t k = cursor++ % n;
+            BenchmarkSuite::keep(bloom.containsWord(k % 2 ? words[k] : typos[k]));
+        }
+    });
+
+    // ---------- Hash Table ----------
+    HashTable* insertTable = nullptr;
+    suite.add("hashtable/insert",
+        [&]() { delete insertTable; insertTable = new HashTable(1000); },
+        [&](size_t ops) {
+            for (size_t i = 0; i < ops; i++) {
+                insertTable->insert(dictionary[i].first, dictionary[i].second);
+            }
+        }, n);
+    suite.add("hashtable/search", [&](size_t ops) {
+        int value = 0;
+        for (size_t i = 0; i < ops; i++) {
+            size_t k = cursor++ % n;
+            BenchmarkSuite::keep(table.search(k % 2 ? words[k] : typos[k], value));
+        }
+    });
+
+    // ---------- LRU Cache ----------
+    // Capacity 100 as in the SpellChecker; keys drawn from 200 so about
+    // half the lookups miss and every miss evicts
+    LRUCache cache(100);
+    suite.add("lrucache/get_put", [&](size_t ops) {
+        std::string value;
+        for (size_t i = 0; i < ops; i++) {
+            const std::string& key = words[(cursor++ * 7919) % 200];
+            if (!cache.get(key, value)) {
+                cache.put(key, key);
+            }
+        }
+    });
+
+    // ---------- Priority Queue ----------
+    PriorityQueue* heap = nullptr;
+    suite.add("priorityqueue/insert",
+        [&]() { delete heap; heap = new PriorityQueue(); },
+        [&](size_t ops) {
+            for (size_t i = 0; i < ops; i++) {
+                heap->insert(dictionary[i].first, dictionary[i].second);
+            }
+        }, n);
+    suite.add("priorityqueue/extractMax",
+        [&]() { delete heap; heap = new PriorityQueue(); heap->buildHeap(dictionary); },
+        [&](size_t ops) {
+            for (size_t i = 0; i < ops; i++) {
+                BenchmarkSuite::keep(heap->extractMax());
+            }
+        }, n);
+
+    // ---------- Tracing ----------
+    // Cost of one span: off should be a load and a branch
+    suite.add("tracing/span_disabled", [&](size_t ops) {
+        Tracing::setEnabled(false);
+        for (size_t i = 0; i < ops; i++) {
+            Tracing::Span span("bench");
+            BenchmarkSuite::keep(i);
+        }
+    });
+    suite.add("tracing/span_enabled", [&](size_t ops) {
+        Tracing::setEnabled(true);
+        for (size_t i = 0; i < ops; i++) {
+            Tracing::Span span("bench");
+            BenchmarkSuite::keep(i);
+        }
+        Tracing::setEnabled(false);
+    });
+
+    // ---------- JSON ----------
+    // A /query autocomplete response serialized into a reused buffer
+    std::vector<std::pair<std::string, int>> ranked;
+    for (size_t i = 0; i < 10 && i < words.size(); i++) {
+        ranked.push_back({words[i], static_cast<int>(1000 - i)});
+    }
+    std::string responseBuffer;
+    suite.add("json/query_response", [&](size_t ops) {
+        for (size_t i = 0; i < ops; i++) {
+            responseBuffer.clear();
+            JSONWriter json(responseBuffer);
+            json.beginObject().field("query", words[i % n]).field("mode", "autocomplete");
+            json.key("suggestions").beginArray();
+            for (const auto& item : ranked) {
+                json.beginObject().field("word", item.first).field("score", item.second).endObject();
+            }
+            json.endArray().field("count", ranked.size()).field("source", "local").endObject();
+            BenchmarkSuite::keep(responseBuffer.size());
+        }
+    });
+
+    Utils::printHeader("MICROBENCHMARKS");
+    std::cout << "Dictionary: " << dictFile << " (" << n << " words), "
+              << config.samples << " samples after " << config.warmupSamples << " warmup\n\n";
+
+    int ran = suite.runAll();
+
+    delete insertTrie;
+    delete insertBloom;
+    delete insertTable;
+    delete heap;
+
+    if (ran == 0) {
+        Utils::logError("No benchmark matches filter: " + config.filter);
+        return 1;
+    }
+
+    std::vector<std::pair<std::string, std::string>> context = {
+        {"dictionary", dictFile},
+        {"words", std::to_string(n)},
+        {"trie_bytes", std::to_string(trie.getMemoryBytes())},
+        {"bktree_bytes", std::to_string(bktree.getMemoryBytes())},
+        {"bloomfilter_bytes", std::to_string(bloom.getMemoryBytes())},
+        {"hashtable_bytes", std::to_string(table.getMemoryBytes())},
+        {"rss_bytes", std::to_string(Utils::getResidentMemoryBytes())},
+#ifdef __VERSION__
+        {"compiler", __VERSION__},
+#endif
+#ifdef BENCH_CXXFLAGS
+        {"cxxflags", BENCH_CXXFLAGS},
+#endif
+    };
+    if (!suite.writeJSON(jsonFile, context)) {
+        return 1;
+    }
+    std::cout << "\nResults written to: " << jsonFile << "\n";
+    return 0;
+}
@@ -0,0 +1,170 @@
+#include "benchmark.h"
+#include "../include/utils.h"
+#include "../include/filehandler.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <fstream>
+#include <algorithm>
+#include <cmath>
+
+BenchmarkSuite::Config::Config()
+    : warmupSamples(5), samples(50), minSampleUs(1000) {}
+
+BenchmarkSuite::BenchmarkSuite(const Config& cfg) : config(cfg) {
+    if (config.samples < 1) config.samples = 1;
+    if (config.warmupSamples < 0) config.warmupSamples = 0;
+}
+
+void BenchmarkSuite::add(const std::string& name, const std::function<void(size_t)>& run) {
+    cases.push_back({name, run, nullptr, 0});
+}
+
+void BenchmarkSuite::add(const std::string& name, const std::function<void()>& setup,
+                         const std::function<void(size_t)>& run, size_t batch) {
+    cases.push_back({name, run, setup, batch == 0 ? 1 : batch});
+}
+
+double BenchmarkSuite::timeSample(const Case& benchCase, size_t ops) {
+    if (benchCase.setup) {
+        benchCase.setup();
+    }
+
+    Utils::Timer timer;
+    timer.start();
+    benchCase.run(ops);
+    timer.stop();
+    return timer.elapsedMicroseconds();
+}
+
+size_t BenchmarkSuite::calibrate(const Case& benchCase) const {
+    if (benchCase.batch > 0) {
+        return benchCase.batch;
+    }
+
+    // Double until one sample is long enough to time reliably
+    size_t ops = 1;
+    while (ops < (size_t(1) << 30)) {
+        double elapsed = timeSample(benchCase, ops);
+        if (elapsed >= config.minSampleUs) {
+            break;
+        }
+        // Jump close to the target once the timing is meaningful
+        if (elapsed > config.minSampleUs / 16) {
+            ops = static_cast<size_t>(std::ceil(ops * config.minSampleUs / elapsed));
+            break;
+        }
+        ops *= 2;
+    }
+    return ops;
+}
+
+BenchmarkSuite::Result BenchmarkSuite::measure(const Case& benchCase) const {
+    size_t ops = calibrate(benchCase);
+
+    for (int i = 0; i < config.warmupSamples; i++) {
+        timeSample(benchCase, ops);
+    }
+
+    std::vector<double> nsPerOp;
+    nsPerOp.reserve(config.samples);
+    for (int i = 0; i < config.samples; i++) {
+        nsPerOp.push_back(timeSample(benchCase, ops) * 1000.0 / ops);
+    }
+    std::sort(nsPerOp.begin(), nsPerOp.end());
+
+    Result result;
+    result.name = benchCase.name;
+    result.opsPerSample = ops;
+    result.samples = config.samples;
+    result.meanNs = Utils::average(nsPerOp);
+    result.minNs = nsPerOp.front();
+    result.p50Ns = percentile(nsPerOp, 50);
+    result.p90Ns = percentile(nsPerOp, 90);
+    result.p99Ns = percentile(nsPerOp, 99);
+    result.maxNs = nsPerOp.back();
+    result.opsPerSecond = result.meanNs > 0 ? 1e9 / result.meanNs : 0;
+    return result;
+}
+
+double BenchmarkSuite::percentile(const std::vector<double>& sorted, double percent) {
+    if (sorted.size() == 1) {
+        return sorted[0];
+    }
+    double rank = percent / 100.0 * (sorted.size() - 1);
+    size_t lower = static_cast<size_t>(rank);
+    if (lower + 1 >= sorted.size()) {
+        return sorted.back();
+    }
+    double fraction = rank - lower;
+    return sorted[lower] + (sorted[lower + 1] - sorted[lower]) * fraction;
+}
+
+int BenchmarkSuite::runAll() {
+    results.clear();
+
+    std::cout << std::left << std::setw(34) << "benchmark"
+              << std::right << std::setw(10) << "ops"
+              << std::setw(12) << "mean ns"
+              << std::setw(12) << "p50 ns"
+              << std::setw(12) << "p90 ns"
+              << std::setw(12) << "p99 ns" << std::endl;
+    Utils::printSeparator(92, '-');
+
+    for (const Case& benchCase : cases) {
+        if (!config.filter.empty() && benchCase.name.find(config.filter) == std::string::npos) {
+            continue;
+        }
+
+        Result result = measure(benchCase);
+        results.push_back(result);
+
+        std::cout << std::left << std::setw(34) << result.name
+                  << std::right << std::setw(10) << result.opsPerSample
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(12) << result.meanNs
+                  << std::setw(12) << result.p50Ns
+                  << std::setw(12) << result.p90Ns
+                  << std::setw(12) << result.p99Ns << std::endl;
+    }
+
+    return static_cast<int>(results.size());
+}
+
+bool BenchmarkSuite::writeJSON(const std::string& filename,
+                               const std::vector<std::pair<std::string, std::string>>& context) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        Utils::logError("Cannot write benchmark results to " + filename);
+        return false;
+    }
+
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(2);
+    json << "{\n";
+    json << "  \"timestamp\": \"" << FileHandler::escapeJSON(Utils::getCurrentTimestamp()) << "\",\n";
+    for (const auto& entry : context) {
+        json << "  \"" << FileHandler::escapeJSON(entry.first) << "\": \""
+             << FileHandler::escapeJSON(entry.second) << "\",\n";
+    }
+    json << "  \"warmupSamples\": " << config.warmupSamples << ",\n";
+    json << "  \"samples\": " << config.samples << ",\n";
+    json << "  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        json << (i == 0 ? "\n" : ",\n");
+        json << "    {\"name\": \"" << FileHandler::escapeJSON(r.name) << "\""
+             << ", \"opsPerSample\": " << r.opsPerSample
+             << ", \"meanNs\": " << r.meanNs
+             << ", \"minNs\": " << r.minNs
+             << ", \"p50Ns\": " << r.p50Ns
+             << ", \"p90Ns\": " << r.p90Ns
+             << ", \"p99Ns\": " << r.p99Ns
+             << ", \"maxNs\": " << r.maxNs
+             << ", \"opsPerSecond\": " << r.opsPerSecond << "}";
+    }
+    json << "\n  ]\n}\n";
+
+    file << json.str();
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,152 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstddef>
+
+/**
+ * Benchmark Harness
+ *
+ * Purpose: Time the core data structures the same way from release to
+ *          release and write the numbers as JSON
+ *
+ * Each case runs `ops` operations per sample:
+ * 1. Calibration doubles the batch until one sample takes at least
+ *    Config::minSampleUs (unless the case fixes its batch size)
+ * 2. Warmup samples are run and thrown away (caches, branch predictors,
+ *    allocator)
+ * 3. Every measured sample yields one ns/op figure; mean, min, max and
+ *    the p50 / p90 / p99 percentiles are taken over the samples
+ *
+ * A batch is timed as a whole, so operations far shorter than the clock
+ * resolution are still measured accurately; the percentiles describe
+ * sample-to-sample variance, not single-operation tail latency.
+ */
+class BenchmarkSuite {
+public:
+    /**
+     * Run settings
+     */
+    struct Config {
+        int warmupSamples;      // Discarded samples per case (default: 5)
+        int samples;            // Measured samples per case (default: 50)
+        double minSampleUs;     // Calibration target per sample (default: 1000)
+        std::string filter;     // Run only cases whose name contains this
+
+        Config();
+    };
+
+    /**
+     * One benchmark case
+     */
+    struct Case {
+        std::string name;                   // "structure/operation"
+        std::function<void(size_t)> run;    // Runs `ops` operations (timed)
+        std::function<void()> setup;        // Before every sample, untimed (optional)
+        size_t batch;                       // Ops per sample (0 = calibrate)
+    };
+
+    /**
+     * Timings of one case, in nanoseconds per operation
+     */
+    struct Result {
+        std::string name;
+        size_t opsPerSample;
+        int samples;
+        double meanNs;
+        double minNs;
+        double p50Ns;
+        double p90Ns;
+        double p99Ns;
+        double maxNs;
+        double opsPerSecond;    // From the mean
+    };
+
+private:
+    Config config;
+    std::vector<Case> cases;
+    std::vector<Result> results;
+
+    /**
+     * Time one sample of `ops` operations
+     * @return: Elapsed microseconds
+     */
+    static double timeSample(const Case& benchCase, size_t ops);
+
+    /**
+     * Find the batch size that makes one sample take minSampleUs
+     */
+    size_t calibrate(const Case& benchCase) const;
+
+    /**
+     * Run one case and compute its statistics
+     */
+    Result measure(const Case& benchCase) const;
+
+public:
+    /**
+     * Constructor
+     * @param config: Sample counts and filter
+     */
+    explicit BenchmarkSuite(const Config& config = Config());
+
+    /**
+     * Register a case whose batch size is calibrated
+     * @param name: Case name ("structure/operation")
+     * @param run: Runs the given number of operations
+     */
+    void add(const std::string& name, const std::function<void(size_t)>& run);
+
+    /**
+     * Register a case with untimed per-sample setup and a fixed batch
+     * (e.g. inserts into a structure that setup empties again)
+     * @param name: Case name
+     * @param setup: Called before every sample, outside the timing
+     * @param run: Runs the given number of operations
+     * @param batch: Operations per sample
+     */
+    void add(const std::string& name, const std::function<void()>& setup,
+             const std::function<void(size_t)>& run, size_t batch);
+
+    /**
+     * Run every registered case that matches the filter, printing a table
+     * @return: Number of cases run
+     */
+    int runAll();
+
+    /**
+     * Write the results as JSON
+     * @param filename: Output path
+     * @param context: Extra "key": "value" pairs for the header (dictionary,
+     *                 build flags, ...)
+     * @return: false if the file could not be written
+     */
+    bool writeJSON(const std::string& filename,
+                   const std::vector<std::pair<std::string, std::string>>& context) const;
+
+    const std::vector<Result>& getResults() const { return results; }
+
+    /**
+     * Percentile of a sorted sample by linear interpolation
+     * @param sorted: Samples in ascending order (not empty)
+     * @param percent: 0-100
+     */
+    static double percentile(const std::vector<double>& sorted, double percent);
+
+    /**
+     * Keep the compiler from optimizing away a benchmarked result
+     */
+    template <typename T>
+    static void keep(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+};
+
+#endif // BENCHMARK_H
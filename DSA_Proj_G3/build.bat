@@ -27,6 +27,9 @@ echo.
 echo [2/5] Compiling source files...
 g++ -std=c++17 -Wall -Wextra -O2 -Iinclude ^
     src/trie.cpp ^
+    src/metrics.cpp ^
+    src/tracing.cpp ^
+    src/decayedscore.cpp ^
     src/bloomfilter.cpp ^
     src/hashtable.cpp ^
     src/lrucache.cpp ^
@@ -34,8 +37,16 @@ g++ -std=c++17 -Wall -Wextra -O2 -Iinclude ^
     src/bktree.cpp ^
     src/editdistance.cpp ^
     src/sort.cpp ^
+    src/threadpool.cpp ^
     src/spellchecker.cpp ^
+    src/frequencylog.cpp ^
+    src/tokenizer.cpp ^
+    src/documentchecker.cpp ^
+    src/jsonwriter.cpp ^
+    src/jsonreader.cpp ^
     src/filehandler.cpp ^
+    src/querydaemon.cpp ^
+    src/batchprocessor.cpp ^
     src/utils.cpp ^
     src/main.cpp ^
     -o autocomplete.exe
@@ -68,37 +68,31 @@ namespace APIFetcher {
      */
     DictionaryEntry fetchDefinition(const std::string& word);
 
-    // ==================== HTTP UTILITIES ====================
-    
-    /**
-     * Make HTTP GET request using Windows API
-     * @param url: Full URL to fetch
-     * @return: Response body as string
-     */
-    std::string httpGet(const std::string& url);
+    // ==================== RESPONSE PARSING ====================
 
     /**
-     * Parse JSON response (lightweight parser for specific APIs)
-     * @param json: JSON string
-     * @return: Parsed data as key-value pairs
+     * Parse a Datamuse response ([{"word": ..., "score": ...}, ...])
+     * @param response: Raw response body
+     * @return: Vector of word suggestions with scores
      */
-    std::vector<std::pair<std::string, std::string>> parseJSON(const std::string& json);
+    std::vector<WordSuggestion> parseSuggestions(const std::string& response);
 
     /**
-     * Extract value from JSON by key
-     * @param json: JSON string
-     * @param key: Key to search for
-     * @return: Value as string (empty if not found)
+     * Parse a DictionaryAPI response
+     * @param word: Word that was looked up
+     * @param response: Raw response body (empty = not found)
+     * @return: DictionaryEntry (found is false if the word is unknown)
      */
-    std::string extractJSONValue(const std::string& json, const std::string& key);
+    DictionaryEntry parseDefinition(const std::string& word, const std::string& response);
 
+    // ==================== HTTP UTILITIES ====================
+    
     /**
-     * Extract array from JSON
-     * @param json: JSON string
-     * @param arrayName: Name of array field
-     * @return: Vector of JSON objects as strings
+     * Make HTTP GET request using Windows API
+     * @param url: Full URL to fetch
+     * @return: Response body as string
      */
-    std::vector<std::string> extractJSONArray(const std::string& json, const std::string& arrayName);
+    std::string httpGet(const std::string& url);
 
     // ==================== URL ENCODING ====================
     
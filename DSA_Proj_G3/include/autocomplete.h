@@ -9,26 +9,28 @@
 class Trie;
 class HashTable;
 class PriorityQueue;
+class SpellChecker;
 
 /**
  * Autocomplete Engine Module
  * Provides intelligent word completion using Trie + Heap + Sorting
+ *
+ * Ownership: the engine never owns its Trie / HashTable. It either reads
+ * structures supplied by the caller, or shares a SpellChecker's index so a
+ * single dictionary load serves both (the SpellChecker must outlive the
+ * engine).
  */
 
 class AutocompleteEngine {
 private:
     Trie* trie;
     HashTable* frequencyMap;
+    SpellChecker* sharedIndex;   // Set when reading a SpellChecker's index
     int maxSuggestions;
 
-    // Collect all words with given prefix from Trie
-    void collectSuggestions(const std::string& prefix, 
-                           std::vector<std::string>& results);
-
-    // Rank suggestions by frequency
-    std::vector<std::pair<std::string, int>> rankByFrequency(
-        const std::vector<std::string>& words
-    );
+    // Top maxSuggestions (word, frequency) pairs for a prefix, read from
+    // the Trie in one traversal with a bounded heap: O(n log k)
+    std::vector<std::pair<std::string, int>> collectSuggestions(const std::string& prefix);
 
 public:
     /**
@@ -39,6 +41,14 @@ public:
      */
     AutocompleteEngine(Trie* t, HashTable* hm, int maxSugg = 10);
 
+    /**
+     * Constructor over a SpellChecker's index (no second dictionary load)
+     * @param index: SpellChecker whose Trie and HashTable are read; must
+     *               outlive the engine
+     * @param maxSugg: Maximum number of suggestions to return
+     */
+    explicit AutocompleteEngine(SpellChecker* index, int maxSugg = 10);
+
     /**
      * Get autocomplete suggestions for a prefix
      * @param prefix: Input prefix
@@ -48,6 +58,8 @@ public:
 
     /**
      * Add word to autocomplete system
+     * On a shared index the word goes through SpellChecker::addWord so the
+     * Bloom Filter and BK-Tree see it too
      * @param word: Word to add
      * @param frequency: Frequency score (default: 1)
      */
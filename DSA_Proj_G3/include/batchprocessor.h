@@ -0,0 +1,114 @@
+#ifndef BATCHPROCESSOR_H
+#define BATCHPROCESSOR_H
+
+#include <string>
+#include <vector>
+#include <istream>
+#include <ostream>
+
+class SpellChecker;
+class ThreadPool;
+
+/**
+ * Batch Query Processor
+ *
+ * Purpose: Answer bulk query files (one query per line, millions of lines)
+ *          offline, on several threads, without the interactive menu
+ *
+ * Pipeline:
+ * 1. Read a block of lines from the input (blank lines skipped)
+ * 2. Split the block into slices and answer them on the thread pool
+ *    through the SpellChecker's read-only, cache-free lookups
+ * 3. Write one JSON line per query, in input order, with the fields of
+ *    the CLI's output.json (timeTaken is the query's own time in ms)
+ *
+ * Only one block is held in memory, so input size is unbounded. The
+ * SpellChecker must not be modified while a batch runs.
+ */
+class BatchProcessor {
+public:
+    enum Mode {
+        AUTOCOMPLETE,
+        SPELLCHECK
+    };
+
+    /**
+     * Summary of a batch run
+     */
+    struct Stats {
+        size_t queries;
+        double elapsedMs;
+        int threads;
+
+        Stats() : queries(0), elapsedMs(0.0), threads(0) {}
+
+        /**
+         * Throughput in queries per second (0 if nothing was timed)
+         */
+        double queriesPerSecond() const;
+    };
+
+private:
+    SpellChecker* checker;  // Not owned
+    ThreadPool* pool;       // nullptr = answer on the calling thread only
+    bool ownsPool;          // false for ThreadPool::shared()
+    int threadCount;
+    int maxResults;
+    size_t blockSize;
+
+    /**
+     * Answer one query as a JSON line (no trailing newline)
+     * @param out: Replaced with the answer; reusing it across blocks keeps
+     *             its capacity, so steady-state answers allocate no output
+     */
+    void answer(const std::string& query, Mode mode, std::string& out) const;
+
+    /**
+     * Answer a block of queries on the pool, results in input order
+     */
+    void answerBlock(const std::vector<std::string>& queries, Mode mode,
+                     std::vector<std::string>& results);
+
+public:
+    /**
+     * Constructor
+     * @param spellChecker: Loaded dictionary to answer from
+     * @param threads: Worker threads (0 = one per hardware thread)
+     * @param maxSuggestions: Suggestions per autocomplete query
+     * @param queriesPerBlock: Queries read and answered per block
+     */
+    BatchProcessor(SpellChecker* spellChecker, int threads = 0,
+                   int maxSuggestions = 10, size_t queriesPerBlock = 16384);
+
+    /**
+     * Destructor
+     */
+    ~BatchProcessor();
+
+    BatchProcessor(const BatchProcessor&) = delete;
+    BatchProcessor& operator=(const BatchProcessor&) = delete;
+
+    /**
+     * Answer every line of a stream
+     * @param input: One query per line
+     * @param output: Receives one JSON line per query
+     * @param mode: Autocomplete or spell check
+     * @return: Query count, wall time and thread count
+     */
+    Stats processStream(std::istream& input, std::ostream& output, Mode mode);
+
+    /**
+     * Same, over a file ("-" reads from stdin)
+     */
+    Stats processFile(const std::string& filename, std::ostream& output, Mode mode);
+
+    /**
+     * Parse a mode name ("autocomplete" or "spellcheck")
+     * @return: false if the name is unknown
+     */
+    static bool parseMode(const std::string& name, Mode& mode);
+
+    int getThreadCount() const { return threadCount; }
+};
+
+#endif // BATCHPROCESSOR_H
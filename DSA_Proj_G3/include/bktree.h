@@ -12,8 +12,9 @@
 struct BKNode {
     std::string word;
     std::map<int, BKNode*> children;  // Key: edit distance, Value: child node
+    bool deleted;                     // Removed word: still routes searches, never returned
 
-    BKNode(const std::string& w) : word(w) {}
+    BKNode(const std::string& w) : word(w), deleted(false) {}
     ~BKNode();
 };
 
@@ -39,6 +40,7 @@ struct BKNode {
 class BKTree {
 private:
     BKNode* root;
+    size_t memoryBytes;  // Nodes, word buffers and child map entries (see getMemoryBytes)
 
     /**
      * Helper function to recursively insert a word
@@ -78,6 +80,17 @@ public:
      */
     void insert(const std::string& word);
 
+    /**
+     * Remove a word from the BK-Tree
+     * The node stays as a tombstone: its children are placed by distance
+     * to it, so unlinking it would mean rebuilding the subtree. Inserting
+     * the word again revives it.
+     * Time Complexity: O(depth) edit distance computations
+     * @param word: The word to remove
+     * @return: true if the word was present
+     */
+    bool remove(const std::string& word);
+
     /**
      * Search for words within a given edit distance
      * @param word: The query word
@@ -108,10 +121,19 @@ public:
     bool isEmpty() const { return root == nullptr; }
 
     /**
-     * Get the number of words in the tree
+     * Get the number of words in the tree (tombstones excluded)
      */
     int size();
 
+    /**
+     * Bytes held by the tree: nodes, word buffers and child maps
+     * Map nodes are estimated from the usual red-black tree layout
+     * (color, parent, left, right, then the entry)
+     * Time Complexity: O(1) (counted as nodes are added)
+     * @return: Bytes requested from the allocator
+     */
+    size_t getMemoryBytes() const;
+
     /**
      * Clear the entire tree
      */
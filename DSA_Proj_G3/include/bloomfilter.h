@@ -2,6 +2,7 @@
 #define BLOOMFILTER_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 /**
@@ -80,6 +81,14 @@ public:
      */
     bool containsWord(const std::string& word);
 
+    /**
+     * Check a word that is already lowercased (see Tokenizer)
+     * Produces the same answer as containsWord() without case folding
+     * or allocating the index vector
+     * @param word: Lowercase word
+     */
+    bool containsNormalized(std::string_view word) const;
+
     /**
      * Calculate the theoretical false positive rate
      * @return: Estimated false positive probability (0.0 to 1.0)
@@ -101,6 +110,11 @@ public:
      */
     int getNumHashFunctions() const { return numHashFunctions; }
 
+    /**
+     * Bytes held by the filter (bits are packed, one word per 64)
+     */
+    size_t getMemoryBytes() const;
+
     /**
      * Reset the bloom filter
      */
@@ -0,0 +1,60 @@
+#ifndef DECAYEDSCORE_H
+#define DECAYEDSCORE_H
+
+#include <cstdint>
+
+/**
+ * Decayed Score (exponentially time-decayed usage counter)
+ *
+ * Purpose: Rank words by how often they were used recently, so a burst of
+ *          popularity fades instead of dominating forever
+ *
+ * Each use adds 1; the total halves every half-life. The score is stored
+ * together with the time it was last brought up to date, and decay is only
+ * applied when the score is read or updated (lazy normalization): no
+ * counter is ever touched by a global rescan.
+ *
+ * Bounded: a word used r times per second converges to about
+ * r * halfLife / ln 2, so the counter cannot overflow.
+ *
+ * Size: 8 bytes (it lives in every TrieNode)
+ */
+struct DecayedScore {
+    static const uint32_t DEFAULT_HALF_LIFE_SECONDS = 24 * 60 * 60;
+
+    float value;        // Score as of 'stamp'
+    uint32_t stamp;     // Seconds since the Unix epoch
+
+    DecayedScore() : value(0.0f), stamp(0) {}
+
+    /**
+     * Score at a given time
+     * @param now: Current time (seconds since the Unix epoch)
+     * @param halfLifeSeconds: Time for the score to halve
+     * @return: Decayed score (0 if never used)
+     */
+    double valueAt(uint32_t now, double halfLifeSeconds) const;
+
+    /**
+     * Add uses at a given time: decay to 'now', then add
+     * @param amount: Uses to add (may be fractional, e.g. on replay)
+     * @param now: Current time (seconds since the Unix epoch)
+     * @param halfLifeSeconds: Time for the score to halve
+     */
+    void add(double amount, uint32_t now, double halfLifeSeconds);
+
+    /**
+     * Add another score (e.g. a second log entry for the same word):
+     * both are decayed to the later stamp, then summed
+     * @param other: Score to add
+     * @param halfLifeSeconds: Time for the score to halve
+     */
+    void merge(const DecayedScore& other, double halfLifeSeconds);
+
+    /**
+     * Current wall-clock time in the unit used by 'stamp'
+     */
+    static uint32_t nowSeconds();
+};
+
+#endif // DECAYEDSCORE_H
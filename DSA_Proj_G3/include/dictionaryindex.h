@@ -0,0 +1,178 @@
+#ifndef DICTIONARYINDEX_H
+#define DICTIONARYINDEX_H
+
+#include <string>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "spellchecker.h"
+#include "autocomplete.h"
+
+/**
+ * Dictionary Index
+ *
+ * Purpose: One loaded dictionary - the SpellChecker (Trie, Bloom Filter,
+ *          Hash Table, BK-Tree, LRU cache) and the AutocompleteEngine
+ *          reading the same structures
+ *
+ * Lifetime: shared through std::shared_ptr snapshots (see
+ * DictionaryManager). Whoever holds a snapshot can keep querying it after a
+ * newer index was published; it is destroyed with the last snapshot.
+ */
+class DictionaryIndex {
+private:
+    SpellChecker* spellchecker;        // Owned
+    AutocompleteEngine* engine;        // Owned; reads spellchecker's index
+    std::string source;
+    int wordCount;
+
+public:
+    /**
+     * Wrap an already populated SpellChecker (takes ownership)
+     * @param spellCheck: Loaded spell checker
+     * @param source: Where the words came from (for /health)
+     * @param maxSuggestions: Autocomplete result count
+     */
+    DictionaryIndex(SpellChecker* spellCheck, const std::string& source, int maxSuggestions = 10);
+
+    ~DictionaryIndex();
+
+    DictionaryIndex(const DictionaryIndex&) = delete;
+    DictionaryIndex& operator=(const DictionaryIndex&) = delete;
+
+    /**
+     * Build a new index from a dictionary file
+     * @param filename: Dictionary path
+     * @param learned: Frequency log whose learned totals are applied and
+     *                 which records further updates (nullptr = none)
+     * @return: The index, or nullptr if nothing could be loaded
+     */
+    static std::shared_ptr<DictionaryIndex> load(const std::string& filename,
+                                                 FrequencyLog* learned = nullptr);
+
+    /**
+     * Apply a dictionary delta to this index in place
+     * Not synchronized with queries on the index: call it from the thread
+     * that serves them. The next full reload starts from the dictionary
+     * file again, so deltas that must survive it go into the file too.
+     * @param data: Delta text (see FileHandler::scanDelta)
+     * @param size: Length of the text
+     * @return: Counts and apply time
+     */
+    SpellChecker::DeltaStats applyDelta(const char* data, size_t size);
+
+    SpellChecker* getSpellChecker() const { return spellchecker; }
+    AutocompleteEngine* getEngine() const { return engine; }
+    const std::string& getSource() const { return source; }
+    int getWordCount() const { return wordCount; }
+};
+
+/**
+ * Dictionary Manager
+ *
+ * Purpose: Publish the current DictionaryIndex and hot-reload it without
+ *          stopping the server
+ *
+ * Reload:
+ * 1. A background thread builds a complete new index while the current
+ *    one keeps serving
+ * 2. The new index is published with an atomic shared_ptr store; queries
+ *    that start afterwards see it, queries in flight finish on their
+ *    snapshot of the old one
+ * 3. The old index (and its LRU cache) is freed when its last snapshot is
+ *    released - no query ever sees cached results from another dictionary
+ *
+ * If the new dictionary fails to load, the current index stays published.
+ */
+class DictionaryManager {
+public:
+    /**
+     * Reload counters (for /health)
+     */
+    struct Stats {
+        int generation;        // Published indexes, starting at 1
+        int reloads;           // Successful reloads
+        int failedReloads;
+        double lastReloadMs;   // Build time of the last successful reload
+        bool reloading;
+    };
+
+private:
+    std::string filename;
+    FrequencyLog* frequencyLog;        // Not owned; may be nullptr
+
+    // Read and written with std::atomic_load / std::atomic_store only
+    std::shared_ptr<DictionaryIndex> current;
+
+    std::mutex buildMutex;             // One build at a time
+
+    std::thread reloader;
+    std::mutex reloadMutex;
+    std::condition_variable reloadWake;
+    std::atomic<bool> reloadPending;   // Set by requestReload (signal-safe)
+    bool stopping;
+
+    mutable std::mutex statsMutex;
+    Stats stats;
+
+    /**
+     * Background thread: run requested reloads one at a time
+     */
+    void reloadLoop();
+
+public:
+    /**
+     * Constructor: starts the reload thread (nothing loaded yet)
+     * @param dictionaryFile: File reloaded on request
+     * @param learned: Learned frequencies applied to every load (optional)
+     */
+    explicit DictionaryManager(const std::string& dictionaryFile, FrequencyLog* learned = nullptr);
+
+    /**
+     * Constructor over an existing index (tests, embedded use)
+     * @param index: Index to publish
+     * @param dictionaryFile: File reloaded on request ("" = reload disabled)
+     * @param learned: Learned frequencies applied to reloads (optional)
+     */
+    DictionaryManager(std::shared_ptr<DictionaryIndex> index, const std::string& dictionaryFile = "",
+                      FrequencyLog* learned = nullptr);
+
+    /**
+     * Destructor: stops the reload thread (an unfinished build completes)
+     */
+    ~DictionaryManager();
+
+    DictionaryManager(const DictionaryManager&) = delete;
+    DictionaryManager& operator=(const DictionaryManager&) = delete;
+
+    /**
+     * Snapshot of the current index; hold it for the whole query
+     * @return: Current index (nullptr before the first load)
+     */
+    std::shared_ptr<DictionaryIndex> acquire() const;
+
+    /**
+     * Build a new index now, on the calling thread, and publish it
+     * @return: true if the new index was published
+     */
+    bool reload();
+
+    /**
+     * Ask the background thread to reload. Returns immediately.
+     * Only touches an atomic flag, so it is safe in a signal handler;
+     * the thread notices within a fraction of a second.
+     */
+    void requestReload();
+
+    /**
+     * Get reload counters
+     */
+    Stats getStats() const;
+
+    const std::string& getFilename() const { return filename; }
+    FrequencyLog* getFrequencyLog() const { return frequencyLog; }
+};
+
+#endif // DICTIONARYINDEX_H
@@ -0,0 +1,183 @@
+#ifndef DOCUMENTCHECKER_H
+#define DOCUMENTCHECKER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <istream>
+#include <functional>
+#include <unordered_map>
+#include "tokenizer.h"
+
+class SpellChecker;
+
+/**
+ * Streaming Document Checker
+ *
+ * Purpose: Spell-check whole documents (logs, tickets, large text dumps)
+ *          without loading them into memory at once
+ *
+ * Pipeline:
+ * 1. Read input in fixed-size chunks, carrying a partial token over
+ *    the chunk boundary
+ * 2. Tokenize and lowercase in one vectorized pass (Tokenizer) into
+ *    runs of ASCII letters (runs glued to digits or '_' such as
+ *    identifiers and hex ids are skipped)
+ * 3. Deduplicate tokens within a sliding window of the last windowSize
+ *    unique tokens, so repeated words are checked only once; once it is
+ *    full, the oldest tokens are forgotten first
+ * 4. Run the Bloom Filter / Trie membership test in batches on the
+ *    pre-normalized tokens
+ * 5. Emit byte offsets and BK-Tree corrections for misspelled tokens,
+ *    in document order
+ *
+ * Time Complexity: O(n) tokenization + O(u * m) membership tests,
+ *                  where u is the number of unique tokens per window
+ */
+class DocumentChecker {
+public:
+    /**
+     * A misspelled token found in the document
+     */
+    struct Misspelling {
+        size_t offset;                        // Byte offset of the token
+        std::string word;                     // Token as it appeared
+        std::vector<std::string> corrections; // Suggested corrections
+    };
+
+    /**
+     * Summary of a document check
+     */
+    struct Stats {
+        size_t bytesProcessed;
+        size_t tokensChecked;
+        size_t uniqueLookups;    // Tokens that missed the dedup window
+        size_t misspellings;
+        double elapsedMs;
+
+        Stats() : bytesProcessed(0), tokensChecked(0), uniqueLookups(0),
+                  misspellings(0), elapsedMs(0.0) {}
+
+        /**
+         * Throughput in MB/s (0 if nothing was timed)
+         */
+        double throughputMBps() const;
+    };
+
+    using MisspellingCallback = std::function<void(const Misspelling&)>;
+
+private:
+    struct Verdict {
+        bool correct;
+        std::vector<std::string> corrections;
+
+        Verdict() : correct(true) {}
+    };
+
+    struct Occurrence {
+        size_t offset;           // Absolute offset in the document
+        const char* text;        // Original bytes (valid until the chunk is recycled)
+        size_t length;
+        const Verdict* verdict;  // Entry in the dedup window
+    };
+
+    SpellChecker* checker;
+    size_t chunkSize;
+    size_t windowSize;
+    size_t batchSize;
+    int maxDistance;
+    int maxCorrections;
+    bool skippingRun;  // Inside an over-long run spanning chunks
+
+    // Dedup window: lowercased token -> verdict, and its keys oldest first
+    std::unordered_map<std::string, Verdict> window;
+    std::deque<std::string_view> windowOrder;
+
+    // Tokens waiting for the next batched membership test
+    std::vector<Occurrence> pending;
+    std::vector<std::string_view> batchKeys;  // Views of window keys
+    std::vector<Verdict*> batchVerdicts;      // Matching window entries
+
+    // Reused tokenizer output
+    std::string normalized;
+    std::vector<Tokenizer::Token> tokens;
+    std::string lookupKey;
+
+    /**
+     * Tokenize [data, data + length) and queue the tokens
+     * @param baseOffset: Absolute offset of data[0] in the document
+     * @param isLast: true if no more input follows
+     * @return: Number of bytes consumed (the rest is a partial token)
+     */
+    size_t tokenizeChunk(const char* data, size_t length, size_t baseOffset,
+                         bool isLast, Stats& stats, const MisspellingCallback& onMisspelling);
+
+    /**
+     * Queue a token occurrence, flushing the batch when it is full
+     */
+    void addToken(const char* original, std::string_view normalizedToken, size_t offset,
+                  Stats& stats, const MisspellingCallback& onMisspelling);
+
+    /**
+     * Resolve all pending tokens and emit misspellings in document order
+     * Must run before the chunk buffer the occurrences point into is reused
+     */
+    void flush(Stats& stats, const MisspellingCallback& onMisspelling);
+
+public:
+    /**
+     * Constructor
+     * @param spellChecker: Loaded SpellChecker (not owned)
+     * @param chunkSize: Bytes read per chunk (default: 64 KB)
+     * @param windowSize: Unique tokens remembered for deduplication
+     * @param batchSize: Unique tokens per batched membership test
+     */
+    DocumentChecker(SpellChecker* spellChecker,
+                    size_t chunkSize = 64 * 1024,
+                    size_t windowSize = 8192,
+                    size_t batchSize = 256);
+
+    /**
+     * Set correction parameters used for misspelled tokens
+     * @param distance: Maximum edit distance (default: 2)
+     * @param results: Maximum corrections per token (default: 5)
+     */
+    void setCorrectionLimits(int distance, int results);
+
+    /**
+     * Check a stream chunk by chunk
+     * @param input: Input stream (file, stdin, string stream)
+     * @param onMisspelling: Called for each misspelled token, in order
+     * @return: Statistics including throughput
+     */
+    Stats checkStream(std::istream& input, const MisspellingCallback& onMisspelling);
+
+    /**
+     * Check a file ("-" reads from stdin)
+     */
+    Stats checkFile(const std::string& filename, const MisspellingCallback& onMisspelling);
+
+    /**
+     * Check an in-memory document
+     */
+    Stats checkText(const std::string& text, const MisspellingCallback& onMisspelling);
+
+    /**
+     * Format a misspelling as a single-line JSON object
+     * {"offset": 12, "word": "teh", "corrections": ["the", "ten"]}
+     */
+    static std::string misspellingToJSON(const Misspelling& misspelling);
+
+    /**
+     * Same, appended to a buffer (e.g. a pending response chunk)
+     */
+    static void appendMisspellingJSON(std::string& buffer, const Misspelling& misspelling);
+
+    /**
+     * Format statistics as a single-line JSON object
+     */
+    static std::string statsToJSON(const Stats& stats);
+};
+
+#endif // DOCUMENTCHECKER_H
@@ -2,7 +2,53 @@
 #define FILEHANDLER_H
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <utility>
+#include <functional>
+
+class ThreadPool;
+class JSONWriter;
+
+/**
+ * Read-only view of a whole file
+ *
+ * POSIX: the file is mmap'ed, so pages load on demand and nothing is
+ * copied; string_views into data() stay valid until close()
+ * Windows: the file is read into an owned buffer
+ */
+class MappedFile {
+private:
+    const char* bytes;
+    size_t length;
+#ifdef _WIN32
+    std::string buffer;
+#else
+    bool mapped;
+#endif
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * Map a file (closes any previous mapping)
+     * @param filename: Path to the file
+     * @return: true on success (an empty file maps to size() == 0)
+     */
+    bool open(const std::string& filename);
+
+    /**
+     * Release the mapping; views into it become invalid
+     */
+    void close();
+
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+};
 
 /**
  * FileHandler Utility
@@ -15,6 +61,57 @@
  */
 class FileHandler {
 public:
+    /**
+     * Receives one dictionary entry; the word views the scanned buffer
+     */
+    using DictionaryCallback = std::function<void(std::string_view word, int frequency)>;
+
+    /**
+     * Scan dictionary text in place (no per-line allocation)
+     * Lines are found with memchr; a trailing '\r' is ignored. Malformed
+     * lines (empty word, frequency field that is not an int) are skipped.
+     * @param data: Text to scan
+     * @param size: Length of the text
+     * @param onEntry: Called for each entry, in order
+     * @return: Number of malformed lines skipped
+     */
+    static int scanDictionary(const char* data, size_t size, const DictionaryCallback& onEntry);
+
+    /**
+     * Scan a mapped dictionary in parallel chunks
+     * @param file: Mapped dictionary; must outlive the returned views
+     * @param pool: Threads that scan the chunks
+     * @param skipped: Set to the number of malformed lines skipped
+     * @return: (word, frequency) views into the mapping, in file order
+     */
+    static std::vector<std::pair<std::string_view, int>> scanDictionaryParallel(
+        const MappedFile& file, ThreadPool& pool, int& skipped);
+
+    /**
+     * Operation on one line of a dictionary delta
+     */
+    enum class DeltaOp { Add, Remove, SetFrequency };
+
+    /**
+     * Receives one delta line; the word views the scanned buffer
+     */
+    using DeltaCallback = std::function<void(DeltaOp op, std::string_view word, int frequency)>;
+
+    /**
+     * Scan dictionary delta text in place
+     * Format, one change per line ('#' starts a comment line):
+     *   add <word> [frequency]      (frequency defaults to 1)
+     *   remove <word>
+     *   set <word> <frequency>
+     * Words may be phrases, as in the dictionary. Unknown operations and
+     * malformed lines are skipped.
+     * @param data: Text to scan
+     * @param size: Length of the text
+     * @param onChange: Called for each change, in order
+     * @return: Number of malformed lines skipped
+     */
+    static int scanDelta(const char* data, size_t size, const DeltaCallback& onChange);
+
     /**
      * Read dictionary file and return list of words
      * @param filename: Path to dictionary file (one word per line)
@@ -22,11 +119,13 @@ public:
      * 
      * Format: plain text, one word per line
      * Optional: word frequency_count (space-separated)
+     * Malformed lines are skipped (see scanDictionary)
      */
     static std::vector<std::pair<std::string, int>> readDictionary(const std::string& filename);
 
     /**
-     * Read simple word list (no frequencies)
+     * Read simple word list (no frequencies): one word or phrase per
+     * line, empty lines skipped; scanned like readDictionary
      */
     static std::vector<std::string> readWordList(const std::string& filename);
 
@@ -71,6 +170,51 @@ public:
         double timeTaken
     );
 
+    /**
+     * Autocomplete result as a one-line JSON object (the fields
+     * writeAutocompleteOutput writes)
+     */
+    static std::string autocompleteOutputToJSON(
+        const std::string& query,
+        const std::vector<std::string>& suggestions,
+        double timeTaken,
+        bool cacheHit,
+        const std::vector<std::string>& dsUsed
+    );
+
+    /**
+     * Spell check result as a one-line JSON object (the fields
+     * writeSpellCheckOutput writes)
+     */
+    static std::string spellCheckOutputToJSON(
+        const std::string& query,
+        bool isCorrect,
+        const std::vector<std::string>& corrections,
+        double timeTaken
+    );
+
+    /**
+     * Write the fields of an autocomplete / spell check result into an
+     * object already begun on a writer, so callers can add their own
+     * fields (e.g. a request id) without re-serializing
+     */
+    static void appendAutocompleteFields(
+        JSONWriter& json,
+        const std::string& query,
+        const std::vector<std::string>& suggestions,
+        double timeTaken,
+        bool cacheHit,
+        const std::vector<std::string>& dsUsed
+    );
+
+    static void appendSpellCheckFields(
+        JSONWriter& json,
+        const std::string& query,
+        bool isCorrect,
+        const std::vector<std::string>& corrections,
+        double timeTaken
+    );
+
     /**
      * Write general output to JSON file
      * @param filename: Output file path
@@ -94,7 +238,7 @@ public:
     static std::string vectorToJSON(const std::vector<std::string>& vec);
 
     /**
-     * Escape string for JSON
+     * Escape string for JSON (see JSONWriter::appendEscaped)
      */
     static std::string escapeJSON(const std::string& str);
 };
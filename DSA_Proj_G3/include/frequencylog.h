@@ -0,0 +1,190 @@
+#ifndef FREQUENCYLOG_H
+#define FREQUENCYLOG_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <cstdio>
+#include "decayedscore.h"
+
+/**
+ * Frequency Log (write-ahead log for learned frequencies)
+ *
+ * Purpose: Keep the recent-usage scores learned from user selections
+ *          across restarts and dictionary reloads
+ *
+ * Files (same "word count" lines as the dictionary, after a header):
+ * - Log:      append-only usage deltas since the last compaction, in
+ *             batches that each start with a "#t <seconds>" time line
+ * - Snapshot: decayed score per word as of the compaction time
+ *
+ * Scores decay like the Trie's (DecayedScore, default half-life), so words
+ * nobody picks any more drop out of the snapshot at the next compaction.
+ *
+ * Write path:
+ * 1. record() only appends to an in-memory batch under a mutex - no I/O
+ *    on the query path
+ * 2. A background flusher writes each batch (deltas for the same word
+ *    summed) with a single write, and optionally one fsync: group commit
+ * 3. Once the log grows past a threshold the flusher compacts it: the
+ *    learned scores are written to a new snapshot (temporary file, then
+ *    rename) and the log starts over
+ *
+ * Both files carry an epoch in their header. The snapshot covers every log
+ * up to its epoch, so a crash between the snapshot rename and the log reset
+ * cannot apply the same deltas twice. A torn last line (crash mid-write) is
+ * ignored and cut off.
+ *
+ * Deltas recorded since the last flush are lost in a crash; with fsync off,
+ * so is whatever the OS had not written out yet.
+ */
+class FrequencyLog {
+public:
+    /**
+     * Log settings
+     */
+    struct Config {
+        std::string logPath;            // Default: data/frequency.log
+        std::string snapshotPath;       // Default: logPath + ".snapshot"
+        int flushIntervalMs;            // Group commit interval (default: 200)
+        int maxBatchRecords;            // Flush early at this many records (default: 4096)
+        bool syncOnFlush;               // fsync after each batch (default: false)
+        long long compactThresholdBytes;// Compact when the log is larger (default: 1 MB)
+
+        Config();
+
+        /**
+         * Defaults overridden by environment variables:
+         * AUTOCOMPLETE_FREQUENCY_LOG (path, "off" disables learning
+         * persistence), AUTOCOMPLETE_FREQUENCY_LOG_FSYNC (1 = fsync),
+         * AUTOCOMPLETE_FREQUENCY_LOG_FLUSH_MS
+         */
+        static Config fromEnvironment();
+    };
+
+    /**
+     * Counters (for logs and /health)
+     */
+    struct Stats {
+        long long recorded;     // record() calls
+        long long flushed;      // Records written to the log
+        long long batches;      // Group commits
+        long long compactions;
+        long long logBytes;     // Current log size
+        int learnedWords;       // Words with a learned score
+    };
+
+private:
+    Config config;
+    std::FILE* logFile;
+    long long epoch;            // Epoch of the open log
+    long long logBytes;
+    bool replayed;
+    bool resumeLog;             // replay() found a current log to append to
+
+    // Learned scores (snapshot + flushed log); written under fileMutex
+    std::unordered_map<std::string, DecayedScore> learned;
+    mutable std::mutex learnedMutex;
+
+    // Records waiting for the next group commit
+    std::vector<std::pair<std::string, int>> pending;
+    mutable std::mutex pendingMutex;
+    std::condition_variable pendingReady;
+    long long recorded;         // Guarded by pendingMutex
+
+    std::mutex fileMutex;       // One flush or compaction at a time
+    std::thread flusher;
+    bool stopping;
+
+    Stats stats;
+    mutable std::mutex statsMutex;
+
+    /**
+     * Background thread: group-commit batches, compact when due
+     */
+    void flushLoop();
+
+    /**
+     * Write one batch to the log (fileMutex held)
+     */
+    bool writeBatch(const std::vector<std::pair<std::string, int>>& batch);
+
+    /**
+     * Start a fresh log with the given epoch (fileMutex held)
+     */
+    bool resetLog(long long newEpoch);
+
+    /**
+     * Write the decayed learned scores as snapshot for the current epoch and
+     * start the next log (fileMutex held)
+     */
+    bool compactLocked();
+
+public:
+    /**
+     * Constructor: nothing is read or written until replay() / start()
+     * @param config: File paths and flush policy
+     */
+    explicit FrequencyLog(const Config& config = Config());
+
+    /**
+     * Destructor: flushes pending records and stops the flusher
+     */
+    ~FrequencyLog();
+
+    FrequencyLog(const FrequencyLog&) = delete;
+    FrequencyLog& operator=(const FrequencyLog&) = delete;
+
+    /**
+     * Read the snapshot and the log into the learned scores
+     * Call once, before start()
+     * @return: Number of delta records read (snapshot entries included)
+     */
+    int replay();
+
+    /**
+     * Open the log for appending and start the flusher
+     * @return: false if the log cannot be written (learning stays in memory)
+     */
+    bool start();
+
+    /**
+     * Queue a frequency delta; returns without doing I/O
+     * @param word: Word whose frequency changed; words containing
+     *              whitespace or control characters are rejected
+     * @param delta: Change in frequency
+     */
+    void record(const std::string& word, int delta);
+
+    /**
+     * Write everything queued so far, on the calling thread
+     * @return: false if the write failed
+     */
+    bool flush();
+
+    /**
+     * Flush, then compact the log into a new snapshot now
+     * @return: false if the snapshot could not be written
+     */
+    bool compact();
+
+    /**
+     * Visit every learned score (e.g. to apply them to a freshly loaded
+     * dictionary). Records not flushed yet are not included.
+     * @param visit: Called with (word, score)
+     */
+    void forEachLearned(const std::function<void(const std::string&, const DecayedScore&)>& visit) const;
+
+    /**
+     * Get counters
+     */
+    Stats getStats() const;
+
+    const Config& getConfig() const { return config; }
+};
+
+#endif // FREQUENCYLOG_H
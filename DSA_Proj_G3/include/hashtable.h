@@ -41,6 +41,7 @@ private:
     std::vector<HashNode*> table;
     int tableSize;
     int elementCount;
+    size_t nodeBytes;  // Chain nodes and key buffers (see getMemoryBytes)
     
     /**
      * Hash function: Maps string key to table index
@@ -126,6 +127,13 @@ public:
      */
     int getTableSize() const { return tableSize; }
 
+    /**
+     * Bytes held by the table: bucket array, chain nodes and key buffers
+     * Time Complexity: O(1) (counted as entries are added and removed)
+     * @return: Bytes requested from the allocator
+     */
+    size_t getMemoryBytes() const;
+
     /**
      * Clear all elements from the table
      */
@@ -4,8 +4,11 @@
 #include <string>
 #include <functional>
 #include <map>
-#include "autocomplete.h"
-#include "spellchecker.h"
+#include <chrono>
+#include "dictionaryindex.h"
+#include "upstreamclient.h"
+#include "queryrouter.h"
+#include "jsonwriter.h"
 
 /**
  * Lightweight HTTP Server for Version 3.0
@@ -14,7 +17,18 @@
  * Features:
  * - GET/POST request handling
  * - JSON request/response parsing
+ * - Chunked streaming responses for whole-document checks (/check)
+ * - Local-first query routing: the Trie / BK-Tree answer immediately and
+ *   remote API results are merged in when they arrive within a budget
  * - Integration with AutocompleteEngine and SpellChecker
+ * - Hot dictionary reload (POST /admin/reload from localhost): requests
+ *   keep being served from the current index while the new one builds
+ * - Incremental dictionary deltas (POST /admin/delta from localhost)
+ * - Prometheus metrics (GET /metrics): request counts and latency
+ *   histograms per endpoint and mode, per-stage engine latencies, and
+ *   memory held by each data structure
+ * - Per-request stage tracing (/admin/trace from localhost), dumped in
+ *   the Chrome trace format
  * - CORS support for local development
  */
 
@@ -22,8 +36,14 @@ class HTTPServer {
 private:
     int port;
     bool running;
-    AutocompleteEngine* autocomplete;
-    SpellChecker* spellchecker;
+    DictionaryManager* dictionary;  // Not owned; current index for every request
+    UpstreamClient* upstream;  // Owned; configured from the environment
+    QueryRouter* router;       // Owned; combines local engines and upstream
+
+    // Reused for every connection (served one at a time), so responses
+    // are serialized into buffers that have already grown to size
+    std::string bodyBuffer;
+    std::string responseBuffer;
 
     // Helper: Parse HTTP request
     struct HTTPRequest {
@@ -31,6 +51,8 @@ private:
         std::string path;        // /query, /api/autocomplete
         std::map<std::string, std::string> headers;
         std::string body;
+        std::string query;       // From a /query JSON body (see parseQueryBody)
+        std::string mode;
     };
 
     // Helper: Build HTTP response
@@ -49,55 +71,97 @@ private:
     HTTPRequest parseRequest(const std::string& rawRequest);
 
     /**
-     * Build HTTP response string
+     * Build HTTP response text
      * @param response: HTTPResponse object
-     * @return: Formatted HTTP response string
+     * @param out: Status line, headers and body are appended here
      */
-    std::string buildResponse(const HTTPResponse& response);
+    void buildResponse(const HTTPResponse& response, std::string& out);
+
+    /**
+     * Read query and mode from a /query JSON body in one pass
+     * @param req: Request; query and mode are filled from its body
+     * @return: false if the body is not a JSON object
+     */
+    bool parseQueryBody(HTTPRequest& req);
 
     /**
      * Handle /query endpoint
-     * @param requestBody: JSON request body {query: "word", mode: "autocomplete"}
-     * @return: JSON response with suggestions
+     * @param req: Request with JSON body {query: "word", mode: "autocomplete"};
+     *             its query and mode are filled in
+     * @param out: Replaced with the JSON response with suggestions
      */
-    std::string handleQuery(const std::string& requestBody);
+    void handleQuery(HTTPRequest& req, std::string& out);
 
     /**
-     * Handle /health endpoint
-     * @return: JSON health status
+     * Handle /check endpoint: spell-check a whole document
+     * Misspellings are streamed as NDJSON lines followed by a summary line
+     * @param document: Raw request body (plain text)
+     * @param sendChunk: Sends one chunk of the response, false if the client is gone
      */
-    std::string handleHealth();
+    void handleDocumentCheck(const std::string& document,
+                             const std::function<bool(const std::string&)>& sendChunk);
+
+    /**
+     * Handle /admin/reload: start a background dictionary reload
+     * @param fromLoopback: Request came from 127.0.0.1 (others are refused)
+     * @param response: Filled with 202 Accepted or 403 Forbidden
+     */
+    void handleReload(bool fromLoopback, HTTPResponse& response);
+
+    /**
+     * Handle /admin/delta: apply the delta in the body to the current index
+     * Runs on the serving thread, between requests
+     * @param body: Delta text (add / remove / set lines)
+     * @param fromLoopback: Request came from 127.0.0.1 (others are refused)
+     * @param response: Filled with the apply counts, or 403 Forbidden
+     */
+    void handleDelta(const std::string& body, bool fromLoopback, HTTPResponse& response);
+
+    /**
+     * Handle /admin/trace: GET dumps the buffered spans as Chrome trace
+     * JSON; POST with "on", "off" or "clear" controls recording
+     * @param req: The request (method and body)
+     * @param fromLoopback: Request came from 127.0.0.1 (others are refused)
+     * @param response: Filled with the trace or the tracing state
+     */
+    void handleTrace(const HTTPRequest& req, bool fromLoopback, HTTPResponse& response);
 
     /**
-     * Extract JSON value by key
-     * @param json: JSON string
-     * @param key: Key to extract
-     * @return: Value string
+     * Count a finished request and record its latency by endpoint and mode
+     * @param req: The request (path, and mode for /query)
+     * @param statusCode: Status sent
+     * @param start: When the request was received
      */
-    std::string extractJSONValue(const std::string& json, const std::string& key);
+    void recordRequest(const HTTPRequest& req, int statusCode, std::chrono::steady_clock::time_point start);
 
     /**
-     * Build JSON array from vector of strings
-     * @param items: Vector of strings
-     * @return: JSON array string ["item1", "item2"]
+     * Handle /metrics endpoint
+     * Memory gauges are measured here, once per scrape
+     * @return: Every metric in the Prometheus text format
      */
-    std::string buildJSONArray(const std::vector<std::string>& items);
+    std::string handleMetrics();
+
+    /**
+     * Handle /health endpoint
+     * @return: JSON health status including upstream breaker states
+     */
+    std::string handleHealth();
 
     /**
-     * Build JSON array from vector of pairs
+     * Write JSON array from vector of pairs
+     * @param json: Writer positioned where the array goes
      * @param items: Vector of word-score pairs
-     * @return: JSON array string [{"word": "hello", "score": 10}]
+     *               -> [{"word":"hello","score":10}]
      */
-    std::string buildJSONArray(const std::vector<std::pair<std::string, int>>& items);
+    void writeJSONArray(JSONWriter& json, const std::vector<std::pair<std::string, int>>& items);
 
 public:
     /**
      * Constructor
      * @param serverPort: Port to listen on (default: 8080)
-     * @param autoEngine: Pointer to AutocompleteEngine
-     * @param spellCheck: Pointer to SpellChecker
+     * @param dictionaries: Publishes the current dictionary index
      */
-    HTTPServer(int serverPort, AutocompleteEngine* autoEngine, SpellChecker* spellCheck);
+    HTTPServer(int serverPort, DictionaryManager* dictionaries);
 
     /**
      * Destructor
@@ -0,0 +1,173 @@
+#ifndef JSONREADER_H
+#define JSONREADER_H
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+/**
+ * JSON Reader
+ *
+ * Purpose: Read request bodies and upstream API responses in one pass,
+ *          pulling out only the fields a caller needs
+ *
+ * A cursor over the input: the caller walks objects and arrays in
+ * document order, reads the values it wants and skips the rest. Nothing
+ * is rescanned and no tree is built; skipped values are only checked
+ * for balanced brackets and well-formed strings.
+ *
+ * Usage:
+ *   JSONReader json(body);
+ *   std::string key;
+ *   if (json.beginObject()) {
+ *       while (json.nextMember(key)) {
+ *           if (key == "query") json.readString(query);
+ *           else json.skipValue();
+ *       }
+ *   }
+ *   bool valid = json.finish();
+ *
+ * Errors are sticky: after the first malformed token every call returns
+ * false and ok() / finish() report the failure.
+ *
+ * Objects and arrays may nest up to MAX_DEPTH levels.
+ */
+class JSONReader {
+public:
+    enum Type {
+        STRING,
+        NUMBER,
+        OBJECT,
+        ARRAY,
+        BOOLEAN,
+        NULL_VALUE,
+        INVALID  // Malformed input, end of input, or a closing bracket
+    };
+
+    static const int MAX_DEPTH = 64;
+
+private:
+    std::string_view text;
+    size_t pos;
+    uint64_t hasElements;  // Bit d: container at depth d + 1 already had an element
+    int depth;
+    bool failed;
+
+    bool fail() {
+        failed = true;
+        return false;
+    }
+
+    void skipSpace() {
+        while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' ||
+                                     text[pos] == '\n' || text[pos] == '\r')) {
+            pos++;
+        }
+    }
+
+    /**
+     * Enter a container after its opening bracket
+     */
+    bool open(char bracket);
+
+    /**
+     * Move to the next element of the current container
+     * @param closing: '}' or ']'
+     * @return: false at the closing bracket (consumed) or on error
+     */
+    bool next(char closing);
+
+    /**
+     * nextMember(), with the key skipped instead of decoded if nullptr
+     */
+    bool nextMemberKey(std::string* key);
+
+    /**
+     * Scan a string starting at its opening quote
+     * @param out: Decoded string, or nullptr to only validate it
+     */
+    bool scanString(std::string* out);
+
+    /**
+     * Scan a number token
+     * @return: The token (empty on error)
+     */
+    std::string_view scanNumber();
+
+    /**
+     * Match a literal (true, false, null)
+     */
+    bool scanLiteral(std::string_view literal);
+
+public:
+    /**
+     * Constructor
+     * @param input: JSON text; must outlive the reader
+     */
+    explicit JSONReader(std::string_view input)
+        : text(input), pos(0), hasElements(0), depth(0), failed(false) {}
+
+    /**
+     * Type of the next value (does not consume it)
+     */
+    Type peek();
+
+    /**
+     * Enter an object / array
+     * @return: false if the next value is not one
+     */
+    bool beginObject();
+    bool beginArray();
+
+    /**
+     * Advance to the next member of the current object
+     * @param key: Decoded member name; its value is read next
+     * @return: false after the last member (the '}' is consumed) or on error
+     */
+    bool nextMember(std::string& key);
+
+    /**
+     * Advance to the next element of the current array
+     * @return: false after the last element (the ']' is consumed) or on error
+     */
+    bool nextElement();
+
+    /**
+     * Read a value of the given type
+     * @return: false (and the reader fails) if the next value has another type
+     */
+    bool readString(std::string& out);
+    bool readNumber(double& out);
+    bool readInt(long long& out);  // Integers only: 1.5 or 1e3 fail
+    bool readBool(bool& out);
+    bool readNull();
+
+    /**
+     * Skip the next value, including everything nested in it
+     */
+    bool skipValue();
+
+    /**
+     * Skip the next value and return its text as written
+     * (e.g. a number or nested object kept verbatim)
+     */
+    std::string_view rawValue();
+
+    /**
+     * No error so far
+     */
+    bool ok() const { return !failed; }
+
+    /**
+     * Check that the whole input was one complete value
+     * @return: true if nothing but whitespace follows and no error occurred
+     */
+    bool finish();
+
+    /**
+     * Byte offset of the cursor (where an error was found)
+     */
+    size_t position() const { return pos; }
+};
+
+#endif // JSONREADER_H
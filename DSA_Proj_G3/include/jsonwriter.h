@@ -0,0 +1,200 @@
+#ifndef JSONWRITER_H
+#define JSONWRITER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <charconv>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * JSON Writer
+ *
+ * Purpose: Serialize responses by appending straight into a caller-owned
+ *          buffer, instead of building them through string streams
+ *
+ * - Strings are escaped (quotes, backslashes, control characters)
+ * - Integers and doubles are formatted with std::to_chars
+ * - Commas between members / elements are inserted automatically
+ *
+ * Nothing is allocated once the buffer has grown to its working size, so
+ * a buffer kept per connection, per thread or per batch slot and cleared
+ * between uses makes serialization allocation-free.
+ *
+ * Usage:
+ *   std::string& out = buffer;  // cleared by the caller if needed
+ *   JSONWriter json(out);
+ *   json.beginObject().field("query", query).field("count", 3).endObject();
+ *
+ * Objects and arrays may nest up to MAX_DEPTH levels.
+ */
+class JSONWriter {
+public:
+    enum Style {
+        COMPACT,  // {"a":1,"b":[1,2]}          (HTTP responses)
+        SPACED    // {"a": 1, "b": [1, 2]}      (CLI / file output)
+    };
+
+    static const int MAX_DEPTH = 64;
+
+private:
+    std::string& out;
+    std::string_view comma;
+    std::string_view colon;
+    uint64_t hasElements;  // Bit d: container at depth d + 1 already has an element
+    int depth;
+    bool afterKey;         // A key was written; its value needs no comma
+
+    /**
+     * Write the comma owed before the next value or key
+     */
+    void separate() {
+        if (afterKey) {
+            afterKey = false;
+            return;
+        }
+        if (depth == 0) return;
+
+        uint64_t bit = uint64_t(1) << (depth - 1);
+        if (hasElements & bit) {
+            out += comma;
+        } else {
+            hasElements |= bit;
+        }
+    }
+
+    JSONWriter& open(char bracket) {
+        separate();
+        out += bracket;
+        depth++;
+        hasElements &= ~(uint64_t(1) << (depth - 1));
+        return *this;
+    }
+
+    JSONWriter& close(char bracket) {
+        out += bracket;
+        depth--;
+        return *this;
+    }
+
+public:
+    /**
+     * Constructor
+     * @param buffer: Output is appended here (not cleared)
+     * @param style: Separator spacing
+     */
+    explicit JSONWriter(std::string& buffer, Style style = COMPACT)
+        : out(buffer), comma(style == SPACED ? ", " : ","), colon(style == SPACED ? ": " : ":"),
+          hasElements(0), depth(0), afterKey(false) {}
+
+    JSONWriter& beginObject() { return open('{'); }
+    JSONWriter& endObject() { return close('}'); }
+    JSONWriter& beginArray() { return open('['); }
+    JSONWriter& endArray() { return close(']'); }
+
+    /**
+     * Object member name (escaped); the next call writes its value
+     */
+    JSONWriter& key(std::string_view name) {
+        separate();
+        appendString(out, name);
+        out += colon;
+        afterKey = true;
+        return *this;
+    }
+
+    /**
+     * String value (escaped)
+     */
+    JSONWriter& value(std::string_view text) {
+        separate();
+        appendString(out, text);
+        return *this;
+    }
+
+    // Without this overload string literals would convert to bool
+    JSONWriter& value(const char* text) { return value(std::string_view(text)); }
+
+    JSONWriter& value(bool flag) {
+        separate();
+        out += flag ? "true" : "false";
+        return *this;
+    }
+
+    /**
+     * Integer value (any integral type but bool)
+     */
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, JSONWriter&>::type
+    value(T number) {
+        separate();
+        char digits[24];
+        std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), number);
+        out.append(digits, result.ptr);
+        return *this;
+    }
+
+    /**
+     * Double with 6 significant digits (as std::ostream prints it)
+     * Infinity and NaN are written as null
+     */
+    JSONWriter& value(double number);
+
+    /**
+     * Double with a fixed number of decimals (as Utils::formatDouble)
+     */
+    JSONWriter& fixed(double number, int decimals);
+
+    JSONWriter& null() {
+        separate();
+        out += "null";
+        return *this;
+    }
+
+    /**
+     * Already-serialized JSON value, copied as is
+     */
+    JSONWriter& raw(std::string_view json) {
+        separate();
+        out += json;
+        return *this;
+    }
+
+    /**
+     * Array of strings
+     */
+    JSONWriter& stringArray(const std::vector<std::string>& items) {
+        beginArray();
+        for (const std::string& item : items) {
+            value(item);
+        }
+        return endArray();
+    }
+
+    /**
+     * Object member: key(name).value(v)
+     */
+    template <typename T>
+    JSONWriter& field(std::string_view name, const T& v) {
+        key(name);
+        return value(v);
+    }
+
+    /**
+     * Append text with JSON escapes (no surrounding quotes)
+     * Control characters without a short escape become \u00XX
+     */
+    static void appendEscaped(std::string& buffer, std::string_view text);
+
+    /**
+     * Append text as a quoted, escaped JSON string
+     */
+    static void appendString(std::string& buffer, std::string_view text) {
+        buffer += '"';
+        appendEscaped(buffer, text);
+        buffer += '"';
+    }
+};
+
+#endif // JSONWRITER_H
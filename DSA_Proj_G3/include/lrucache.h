@@ -11,11 +11,12 @@
 struct CacheNode {
     std::string key;
     std::string value;
+    long long expiresAt;  // Steady-clock milliseconds, 0 = never expires
     CacheNode* prev;
     CacheNode* next;
 
     CacheNode(const std::string& k, const std::string& v) 
-        : key(k), value(v), prev(nullptr), next(nullptr) {}
+        : key(k), value(v), expiresAt(0), prev(nullptr), next(nullptr) {}
 };
 
 /**
@@ -35,11 +36,14 @@ struct CacheNode {
  * 
  * Eviction Policy:
  * When cache is full, removes the least recently used item (tail of list)
+ * With a time-to-live set, entries older than the TTL are treated as
+ * misses and removed when they are next looked up
  */
 class LRUCache {
 private:
     int capacity;
     int size;
+    int timeToLiveMs;  // 0 = entries never expire
     CacheNode* head;  // Most recently used
     CacheNode* tail;  // Least recently used
     std::unordered_map<std::string, CacheNode*> cache;
@@ -64,6 +68,16 @@ private:
      */
     CacheNode* removeTail();
 
+    /**
+     * Remove a node from both the list and the map
+     */
+    void evict(CacheNode* node);
+
+    /**
+     * Check whether a node has outlived the time-to-live
+     */
+    bool isExpired(const CacheNode* node) const;
+
 public:
     /**
      * Constructor
@@ -71,6 +85,13 @@ public:
      */
     LRUCache(int capacity = 100);
 
+    /**
+     * Constructor with expiry
+     * @param capacity: Maximum number of items in cache
+     * @param timeToLiveMs: Lifetime of an entry in milliseconds (0 = forever)
+     */
+    LRUCache(int capacity, int timeToLiveMs);
+
     /**
      * Destructor: Clean up all nodes
      */
@@ -99,6 +120,13 @@ public:
      */
     bool contains(const std::string& key);
 
+    /**
+     * Drop one entry (e.g. a result made stale by a dictionary update)
+     * @param key: The key to remove
+     * @return: true if the key was cached
+     */
+    bool remove(const std::string& key);
+
     /**
      * Get the current size of cache
      */
@@ -109,6 +137,17 @@ public:
      */
     int getCapacity() const { return capacity; }
 
+    /**
+     * Set the lifetime of entries inserted from now on
+     * @param milliseconds: Time-to-live (0 = entries never expire)
+     */
+    void setTimeToLive(int milliseconds) { timeToLiveMs = milliseconds; }
+
+    /**
+     * Get the time-to-live in milliseconds (0 = entries never expire)
+     */
+    int getTimeToLive() const { return timeToLiveMs; }
+
     /**
      * Calculate cache hit rate
      * @param hits: Number of cache hits
@@ -126,6 +165,15 @@ public:
      * Get all keys currently in cache (for debugging/testing)
      */
     std::vector<std::string> getKeys() const;
+
+    /**
+     * Bytes held by the cache: list nodes with their key and value
+     * buffers, plus the index (buckets, and per entry a node holding a
+     * key copy, the node pointer, a next pointer and the cached hash)
+     * Time Complexity: O(n)
+     * @return: Bytes requested from the allocator
+     */
+    size_t getMemoryBytes() const;
 };
 
 #endif // LRUCACHE_H
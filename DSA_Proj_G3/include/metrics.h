@@ -0,0 +1,206 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * Metrics
+ *
+ * Purpose: Count events and record latency distributions on the query path
+ *          without locks, and expose them in the Prometheus text format
+ *          (GET /metrics)
+ *
+ * - Counter:   per-thread shards, summed when read
+ * - Gauge:     a value set from outside (e.g. bytes in use)
+ * - Histogram: HDR-style log-linear buckets (16 per power of two, so any
+ *              value is known within 6.25%) from 1 ns to ~18 minutes;
+ *              recording is one relaxed atomic add per field
+ *
+ * Metrics live in a process-wide registry, keyed by family name plus a
+ * label string such as stage="trie". Looking one up takes a mutex, so hot
+ * paths resolve their metrics once and keep the reference; metrics are
+ * never destroyed.
+ */
+class Metrics {
+public:
+    /**
+     * Monotonic counter, sharded per thread
+     */
+    class Counter {
+    private:
+        static const int SHARDS = 16;
+
+        // One cache line per shard so threads do not share lines
+        struct alignas(64) Shard {
+            std::atomic<uint64_t> value;
+        };
+        Shard shards[SHARDS];
+
+    public:
+        Counter();
+        Counter(const Counter&) = delete;
+        Counter& operator=(const Counter&) = delete;
+
+        /**
+         * Add to the calling thread's shard
+         * Time Complexity: O(1), no lock, no shared cache line
+         */
+        void add(uint64_t amount = 1);
+
+        /**
+         * Sum of all shards (concurrent adds may or may not be included)
+         */
+        uint64_t value() const;
+
+        /**
+         * Set back to zero (not atomic with concurrent adds)
+         */
+        void reset();
+    };
+
+    /**
+     * Current value of something that goes up and down
+     */
+    class Gauge {
+    private:
+        std::atomic<double> current;
+
+    public:
+        Gauge() : current(0.0) {}
+        Gauge(const Gauge&) = delete;
+        Gauge& operator=(const Gauge&) = delete;
+
+        void set(double value) { current.store(value, std::memory_order_relaxed); }
+        double value() const { return current.load(std::memory_order_relaxed); }
+    };
+
+    /**
+     * Latency histogram (nanoseconds)
+     */
+    class Histogram {
+    public:
+        static const int SUB_BUCKET_BITS = 4;
+        static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+        static const int MAX_MAGNITUDE = 40;     // 2^40 ns ~ 18 minutes
+        static const int BUCKETS = (MAX_MAGNITUDE - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+
+    private:
+        std::atomic<uint64_t> buckets[BUCKETS];
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> sumNs;
+
+    public:
+        Histogram();
+        Histogram(const Histogram&) = delete;
+        Histogram& operator=(const Histogram&) = delete;
+
+        /**
+         * Record one value
+         * @param nanoseconds: Duration; values past the range land in the
+         *                     last bucket
+         */
+        void record(uint64_t nanoseconds);
+
+        /**
+         * Record the time elapsed since start
+         */
+        void recordSince(std::chrono::steady_clock::time_point start);
+
+        /**
+         * Bucket holding a value
+         */
+        static int bucketIndex(uint64_t nanoseconds);
+
+        /**
+         * Smallest value in a bucket
+         */
+        static uint64_t bucketLowerBound(int index);
+
+        /**
+         * First value past a bucket
+         */
+        static uint64_t bucketUpperBound(int index);
+
+        /**
+         * Value at a quantile (upper bound of the bucket reaching it)
+         * @param quantile: 0.0 - 1.0
+         * @return: Nanoseconds (0 if nothing was recorded)
+         */
+        uint64_t valueAtQuantile(double quantile) const;
+
+        /**
+         * Number of recorded values no greater than a limit, counting only
+         * whole buckets (values within 6.25% of the limit may be left out)
+         */
+        uint64_t countAtOrBelow(uint64_t nanoseconds) const;
+
+        uint64_t getCount() const { return count.load(std::memory_order_relaxed); }
+        uint64_t getSumNs() const { return sumNs.load(std::memory_order_relaxed); }
+
+        void reset();
+    };
+
+    /**
+     * Times a scope into a histogram
+     */
+    class ScopedTimer {
+    private:
+        Histogram& histogram;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        explicit ScopedTimer(Histogram& target)
+            : histogram(target), start(std::chrono::steady_clock::now()) {}
+        ~ScopedTimer() { histogram.recordSince(start); }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+    };
+
+    /**
+     * Get (registering on first use) a counter
+     * @param name: Family name, e.g. "autocomplete_requests_total"
+     * @param labels: Label pairs without braces, e.g. endpoint="/query" ("" = none)
+     * @param help: Family description (taken from the first registration)
+     */
+    static Counter& counter(const std::string& name, const std::string& labels, const std::string& help);
+
+    /**
+     * Get (registering on first use) a gauge
+     * @param name: Family name, e.g. "autocomplete_memory_bytes"
+     * @param labels: Label pairs without braces
+     * @param help: Family description
+     */
+    static Gauge& gauge(const std::string& name, const std::string& labels, const std::string& help);
+
+    /**
+     * Get (registering on first use) a latency histogram, exposed in seconds
+     * @param name: Family name, e.g. "autocomplete_stage_duration_seconds"
+     * @param labels: Label pairs without braces
+     * @param help: Family description
+     */
+    static Histogram& histogram(const std::string& name, const std::string& labels, const std::string& help);
+
+    /**
+     * Latency of one engine stage (cache, trie, bktree, upstream)
+     */
+    static Histogram& stage(const std::string& stageName);
+
+    /**
+     * Render every metric in the Prometheus text exposition format
+     * Histograms get fixed "le" buckets from 10 us to 10 s, plus a gauge
+     * family with p50 / p90 / p99 / p99.9 from the full-resolution buckets
+     * ("x_duration_seconds" -> "x_duration_quantile_seconds").
+     */
+    static std::string exposition();
+
+    /**
+     * Quote a label value (backslash, quote and newline escaped)
+     */
+    static std::string labelValue(const std::string& value);
+};
+
+#endif // METRICS_H
@@ -0,0 +1,81 @@
+#ifndef QUERYDAEMON_H
+#define QUERYDAEMON_H
+
+#include <string>
+#include <istream>
+#include <ostream>
+
+class SpellChecker;
+
+/**
+ * Query Daemon
+ *
+ * Purpose: Keep one process with the dictionary loaded and answer queries
+ *          from local clients, instead of starting the CLI (and loading
+ *          the dictionary) for every query
+ *
+ * Protocol: newline-delimited JSON, one request per line, one response
+ * line per request, in order:
+ *
+ *   -> {"query": "prog", "mode": "autocomplete", "id": "7"}
+ *   <- {"id": "7", "type": "autocomplete", "query": "prog", "suggestions": [...], ...}
+ *
+ * - mode: "autocomplete" (default), "spellcheck" or "select" (record a
+ *   chosen suggestion)
+ * - id: optional, echoed back as a string
+ * - Responses carry the fields of the CLI's output.json; a bad request
+ *   gets {"error": "..."} and the connection stays open
+ *
+ * Transports: stdin/stdout (serveStream), or a Unix domain socket
+ * (serveSocket) with any number of clients served one line at a time.
+ * Requests are handled on one thread, so the SpellChecker needs no locks.
+ * Client sockets are non-blocking and answers are queued per client, so
+ * a client that stops reading only stalls itself; a client sending a
+ * line over 1 MB is disconnected.
+ */
+class QueryDaemon {
+private:
+    SpellChecker* checker;  // Not owned
+    int maxResults;
+    size_t requests;
+
+public:
+    /**
+     * Constructor
+     * @param spellChecker: Loaded dictionary to answer from
+     * @param maxSuggestions: Suggestions / corrections per answer
+     */
+    QueryDaemon(SpellChecker* spellChecker, int maxSuggestions = 10);
+
+    /**
+     * Answer one request line
+     * @param line: JSON request
+     * @return: JSON response (one line, no trailing newline)
+     */
+    std::string handleRequest(const std::string& line);
+
+    /**
+     * Answer request lines until the input ends
+     * Each response is flushed before the next request is read
+     * @return: Number of requests answered
+     */
+    size_t serveStream(std::istream& in, std::ostream& out);
+
+    /**
+     * Listen on a Unix domain socket and answer clients until stop()
+     * A stale socket file at the path is replaced; any other file there
+     * is an error. The socket file is removed on return
+     * @param path: Socket path
+     * @return: false if the socket cannot be set up
+     */
+    bool serveSocket(const std::string& path);
+
+    /**
+     * Ask serveSocket to return (async-signal-safe)
+     */
+    static void stop();
+
+    size_t getRequestCount() const { return requests; }
+};
+
+#endif // QUERYDAEMON_H
@@ -0,0 +1,169 @@
+#ifndef QUERYROUTER_H
+#define QUERYROUTER_H
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "dictionaryindex.h"
+#include "upstreamclient.h"
+
+/**
+ * Query Router
+ *
+ * Purpose: Decide how /query combines the local engines with the remote
+ *          APIs
+ *
+ * Modes:
+ * - LocalFirst (default): answer from the local Trie / BK-Tree right
+ *   away. Remote calls start at the same time; their results are merged
+ *   in only if they arrive within the remote budget (cache hits always
+ *   do). Late results still land in the upstream cache for next time.
+ * - RemoteFirst: the API answers, and local data is only a fallback
+ *   (waits up to the full upstream timeout)
+ *
+ * Merging uses reciprocal rank fusion, so the local frequency ranking and
+ * the remote scores never have to share a scale.
+ *
+ * Each query takes one DictionaryIndex snapshot and uses it throughout,
+ * so a dictionary reload never changes the index under a running query.
+ *
+ * Prefetching: autocomplete prefixes are counted; a background thread
+ * periodically warms the upstream cache for the most popular ones so
+ * their remote results are ready within the budget.
+ */
+class QueryRouter {
+public:
+    enum class Mode { LocalFirst, RemoteFirst };
+
+    /**
+     * Router configuration
+     */
+    struct Config {
+        Mode mode;                // Default: LocalFirst
+        int remoteBudgetMs;       // Wait for remote results (default: 25)
+        int maxSuggestions;       // Autocomplete results (default: 10)
+        int maxCorrections;       // Spellcheck corrections (default: 5)
+        int prefetchIntervalMs;   // 0 disables prefetching (default: 30 s)
+        int prefetchCount;        // Popular prefixes warmed per round (default: 32)
+
+        Config();
+
+        /**
+         * Defaults overridden by environment variables:
+         * AUTOCOMPLETE_ROUTING (local-first | remote-first),
+         * AUTOCOMPLETE_REMOTE_BUDGET_MS
+         */
+        static Config fromEnvironment();
+    };
+
+    /**
+     * Routed answer for one query
+     */
+    struct Answer {
+        std::vector<std::pair<std::string, int>> suggestions;
+        bool isCorrect;       // Spellcheck only
+        std::string source;   // local, datamuse-api, dictionaryapi, local+datamuse, unavailable
+
+        Answer() : isCorrect(false) {}
+    };
+
+private:
+    DictionaryManager* dictionary;     // Not owned
+    UpstreamClient* upstream;          // Not owned
+    Config config;
+
+    // Autocomplete prefix -> query count since the last prefetch round
+    std::unordered_map<std::string, int> popularity;
+    std::mutex popularityMutex;
+
+    std::thread prefetcher;
+    std::mutex prefetchMutex;
+    std::condition_variable prefetchWake;
+    bool stopping;
+
+    /**
+     * Count an autocomplete prefix for prefetching
+     */
+    void recordQuery(const std::string& prefix);
+
+    /**
+     * Background loop: warm the cache for popular prefixes
+     */
+    void prefetchLoop();
+
+    /**
+     * Local corrections from the BK-Tree, scored by rank
+     */
+    std::vector<std::pair<std::string, int>> localCorrections(DictionaryIndex& index,
+                                                              const std::string& word);
+
+    Answer autocompleteLocalFirst(DictionaryIndex& index, const std::string& prefix);
+    Answer autocompleteRemoteFirst(DictionaryIndex& index, const std::string& prefix);
+    Answer spellcheckLocalFirst(DictionaryIndex& index, const std::string& word);
+    Answer spellcheckRemoteFirst(DictionaryIndex& index, const std::string& word);
+
+public:
+    /**
+     * Constructor: starts the prefetcher if enabled
+     * @param dictionaries: Source of the current local index
+     * @param client: Upstream API client
+     * @param config: Routing configuration
+     */
+    QueryRouter(DictionaryManager* dictionaries, UpstreamClient* client,
+                const Config& config = Config());
+
+    /**
+     * Destructor: stops the prefetcher
+     */
+    ~QueryRouter();
+
+    QueryRouter(const QueryRouter&) = delete;
+    QueryRouter& operator=(const QueryRouter&) = delete;
+
+    /**
+     * Route an autocomplete query
+     */
+    Answer autocomplete(const std::string& prefix);
+
+    /**
+     * Route a spellcheck query
+     */
+    Answer spellcheck(const std::string& word);
+
+    /**
+     * Run one prefetch round now (also called by the background thread)
+     * @return: Number of prefixes fetched
+     */
+    int prefetchPopular();
+
+    /**
+     * Get the routing mode
+     */
+    Mode getMode() const { return config.mode; }
+
+    /**
+     * Merge two ranked lists with reciprocal rank fusion
+     * score(w) = sum over lists of 1 / (60 + rank(w)); words are matched
+     * case-insensitively and reported scaled to integers
+     * @param local: Local results, best first
+     * @param remote: Remote results, best first
+     * @param maxResults: Size of the merged list
+     * @return: Merged list, best first
+     */
+    static std::vector<std::pair<std::string, int>> mergeRanked(
+        const std::vector<std::pair<std::string, int>>& local,
+        const std::vector<std::pair<std::string, int>>& remote,
+        int maxResults);
+
+    /**
+     * Convert a mode name ("local-first", "remote-first")
+     */
+    static Mode parseMode(const std::string& name);
+    static const char* modeName(Mode mode);
+};
+
+#endif // QUERYROUTER_H
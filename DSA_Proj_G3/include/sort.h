@@ -2,13 +2,22 @@
 #define SORT_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <utility>
 
+class ThreadPool;
+
 /**
  * Custom Sorting Algorithms for DSA Project
  * Implements QuickSort for lexicographic and frequency-based ranking
  * NO STL sort() used - all implementations are manual
+ *
+ * The public wrappers (sortLexicographic, sortByFrequency, sortByRank) use
+ * introsort: median-of-three quicksort that falls back to heapsort past a
+ * depth limit and to insertion sort on small ranges. That keeps them
+ * O(n log n) with O(log n) stack on the sorted, reverse-sorted and
+ * all-equal inputs where the plain quickSort* versions go quadratic.
  */
 
 namespace SortAlgorithms {
@@ -35,7 +44,17 @@ namespace SortAlgorithms {
     int partitionLexicographic(std::vector<std::string>& arr, int low, int high);
     
     /**
-     * Public wrapper for lexicographic sorting
+     * Introsort for lexicographic string sorting
+     * Time Complexity: O(n log n) worst case
+     * Space Complexity: O(log n) for recursion stack
+     * @param arr: Vector of strings to sort
+     * @param low: Starting index
+     * @param high: Ending index
+     */
+    void introSortLexicographic(std::vector<std::string>& arr, int low, int high);
+
+    /**
+     * Public wrapper for lexicographic sorting (introsort)
      * @param arr: Vector of strings to sort
      */
     void sortLexicographic(std::vector<std::string>& arr);
@@ -62,11 +81,31 @@ namespace SortAlgorithms {
     int partitionByFrequency(std::vector<std::pair<std::string, int>>& arr, int low, int high);
     
     /**
-     * Public wrapper for frequency sorting
+     * Introsort by frequency (descending), then lexicographic
+     * Time Complexity: O(n log n) worst case
+     * @param arr: Vector of (string, int) pairs
+     * @param low: Starting index
+     * @param high: Ending index
+     */
+    void introSortByFrequency(std::vector<std::pair<std::string, int>>& arr, int low, int high);
+
+    /**
+     * Public wrapper for frequency sorting (introsort)
      * @param arr: Vector of (word, frequency) pairs
      */
     void sortByFrequency(std::vector<std::pair<std::string, int>>& arr);
 
+    /**
+     * LSD radix sort by frequency (descending), 8 bits per pass
+     * Stable: pairs with equal frequency keep their input order, so words
+     * are NOT re-ordered lexicographically (unlike sortByFrequency)
+     * Passes where every key shares the same byte are skipped
+     * Time Complexity: O(n) - at most 4 passes
+     * Space Complexity: O(n)
+     * @param arr: Vector of (word, frequency) pairs
+     */
+    void radixSortByFrequency(std::vector<std::pair<std::string, int>>& arr);
+
     // ==================== DISTANCE + FREQUENCY SORTING ====================
     
     /**
@@ -95,7 +134,13 @@ namespace SortAlgorithms {
     int partitionByRank(std::vector<CorrectionCandidate>& arr, int low, int high);
     
     /**
-     * Public wrapper for correction ranking
+     * Introsort for correction ranking
+     * Time Complexity: O(n log n) worst case
+     */
+    void introSortByRank(std::vector<CorrectionCandidate>& arr, int low, int high);
+    
+    /**
+     * Public wrapper for correction ranking (introsort)
      */
     void sortByRank(std::vector<CorrectionCandidate>& arr);
 
@@ -109,6 +154,52 @@ namespace SortAlgorithms {
     void mergeSortLexicographic(std::vector<std::string>& arr, int left, int right);
     void merge(std::vector<std::string>& arr, int left, int mid, int right);
 
+    // ==================== PARALLEL SORTING ====================
+    
+    /**
+     * Parallel merge sort: one introsorted run per pool thread, then
+     * pairwise merges of the runs in parallel rounds
+     * Time Complexity: O((n log n) / p + n log p) for p threads
+     * Space Complexity: O(n)
+     * @param arr: Vector of strings to sort
+     * @param pool: Threads to use
+     */
+    void parallelMergeSortLexicographic(std::vector<std::string>& arr, ThreadPool& pool);
+    
+    /**
+     * Parallel sample sort: splitters chosen from a sorted sample split the
+     * input into buckets that are classified, scattered and introsorted in
+     * parallel. Scales better than merge sort (no sequential final merge);
+     * heavily duplicated keys land in one bucket and sort sequentially.
+     * Time Complexity: O((n log n) / p) expected
+     * Space Complexity: O(n)
+     * @param arr: Vector of strings to sort
+     * @param pool: Threads to use
+     */
+    void sampleSortLexicographic(std::vector<std::string>& arr, ThreadPool& pool);
+    
+    /**
+     * Sample sort of (word, frequency) pairs by word (lexicographic)
+     * Used to pre-sort dictionaries for the bulk builders
+     * @param arr: Vector of (word, frequency) pairs
+     * @param pool: Threads to use
+     */
+    void sampleSortByWord(std::vector<std::pair<std::string, int>>& arr, ThreadPool& pool);
+    
+    /**
+     * Same, over word views (e.g. into a mapped dictionary file)
+     */
+    void sampleSortByWord(std::vector<std::pair<std::string_view, int>>& arr, ThreadPool& pool);
+    
+    /**
+     * Drop duplicate words from a vector sorted by word (see
+     * sampleSortByWord), keeping the highest frequency of each
+     * @param arr: Vector of (word, frequency) pairs, sorted by word
+     * @return: Number of entries removed
+     */
+    int removeDuplicateWords(std::vector<std::pair<std::string, int>>& arr);
+    int removeDuplicateWords(std::vector<std::pair<std::string_view, int>>& arr);
+
     // ==================== UTILITY FUNCTIONS ====================
     
     /**
@@ -125,7 +216,7 @@ namespace SortAlgorithms {
      * Compare strings lexicographically
      * @return: -1 if a < b, 0 if a == b, 1 if a > b
      */
-    int compareStrings(const std::string& a, const std::string& b);
+    int compareStrings(std::string_view a, std::string_view b);
     
     /**
      * Get top N elements from sorted array
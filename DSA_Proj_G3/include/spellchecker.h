@@ -2,6 +2,7 @@
 #define SPELLCHECKER_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include "trie.h"
 #include "bloomfilter.h"
@@ -9,6 +10,8 @@
 #include "lrucache.h"
 #include "priorityqueue.h"
 #include "bktree.h"
+#include "frequencylog.h"
+#include "metrics.h"
 
 /**
  * SpellChecker Core Engine
@@ -37,17 +40,54 @@
  *    - Return top corrections
  */
 class SpellChecker {
+public:
+    /**
+     * Result of applying a dictionary delta
+     */
+    struct DeltaStats {
+        int added;
+        int removed;
+        int updated;           // Frequency set on an existing word
+        int skipped;           // Malformed lines, or words not in the dictionary
+        int invalidated;       // Cache entries dropped
+        double elapsedMs;
+    };
+
+    /**
+     * Bytes held by each structure (see their getMemoryBytes)
+     */
+    struct MemoryStats {
+        size_t trie;
+        size_t bkTree;
+        size_t hashTable;
+        size_t bloomFilter;
+        size_t cache;
+
+        size_t total() const { return trie + bkTree + hashTable + bloomFilter + cache; }
+    };
+
 private:
     Trie* trie;
     BloomFilter* bloomFilter;
     HashTable* frequencyTable;
     LRUCache* cache;
     BKTree* bkTree;
+    FrequencyLog* frequencyLog;  // Not owned; nullptr = learning is not persisted
+
+    // Statistics (sharded atomic counters: safe to bump from any thread)
+    Metrics::Counter cacheHits;
+    Metrics::Counter cacheMisses;
+    Metrics::Counter totalQueries;
 
-    // Statistics
-    int cacheHits;
-    int cacheMisses;
-    int totalQueries;
+    /**
+     * Drop the cached results a change to one word can affect: autocomplete
+     * entries for prefixes of the word and, if the word was added or
+     * removed, corrections for words within correction distance of it
+     * @param word: Changed word
+     * @param membershipChanged: Word was added or removed (not re-weighted)
+     * @return: Number of entries dropped
+     */
+    int invalidateCachedResults(const std::string& word, bool membershipChanged);
 
     /**
      * Rank suggestions by frequency
@@ -93,6 +133,21 @@ public:
      */
     bool checkSpelling(const std::string& word);
 
+    /**
+     * Check a batch of words in two passes: Bloom Filter over the whole
+     * batch, then Trie confirmation for the survivors only
+     * @param words: Words to check
+     * @param results: Filled with one flag per word (true = correct)
+     */
+    void checkSpellingBatch(const std::vector<std::string>& words, std::vector<bool>& results);
+
+    /**
+     * Batch check for words that are already lowercased (see Tokenizer)
+     * Same two passes without per-character case folding
+     */
+    void checkSpellingBatchNormalized(const std::vector<std::string_view>& words,
+                                      std::vector<bool>& results);
+
     /**
      * Get spelling corrections for a misspelled word
      * @param word: The misspelled word
@@ -107,10 +162,96 @@ public:
     );
 
     /**
-     * Update word frequency (when user selects a suggestion)
+     * Read-only lookups for concurrent callers (see BatchProcessor)
+     * Same answers as autocomplete() / getCorrections(), but the LRU cache
+     * is neither read nor filled. Any number of threads may call these and
+     * checkSpelling() at once, as long as no writer (addWord, applyDelta,
+     * updateFrequency, ...) runs at the same time.
+     */
+    std::vector<std::string> autocompleteUncached(const std::string& prefix, int maxResults = 10) const;
+    std::vector<std::string> getCorrectionsUncached(
+        const std::string& word,
+        int maxDistance = 2,
+        int maxResults = 5
+    ) const;
+
+    /**
+     * Add a word to every index structure (Trie, Bloom Filter, Hash Table,
+     * BK-Tree); bumps the frequency if the word already exists.
+     * Cached results that may now be stale are dropped.
+     * @param word: The word to add
+     * @param frequency: Frequency score (default: 1)
+     */
+    void addWord(const std::string& word, int frequency = 1);
+
+    /**
+     * Remove a word from the Trie, Hash Table and BK-Tree
+     * The Bloom Filter cannot forget it; the Trie check behind it rejects
+     * the word, so it only costs one more false positive.
+     * @param word: The word to remove
+     * @return: true if the word was in the dictionary
+     */
+    bool removeWord(const std::string& word);
+
+    /**
+     * Set the frequency of a dictionary word
      * @param word: The word to update
+     * @param frequency: New frequency score
+     * @return: true if the word was in the dictionary
+     */
+    bool setWordFrequency(const std::string& word, int frequency);
+
+    /**
+     * Apply a delta file (see FileHandler::scanDelta) to the live index
+     * Each change updates every structure in place and drops only the
+     * cached results it affects, so the cost is proportional to the delta
+     * rather than the dictionary. "add" of an existing word sets its
+     * frequency, so applying the same delta twice is harmless.
+     * @param filename: Path to the delta file
+     * @return: Counts and apply time
+     */
+    DeltaStats applyDelta(const std::string& filename);
+
+    /**
+     * Same, over delta text already in memory (e.g. an HTTP request body)
+     */
+    DeltaStats applyDelta(const char* data, size_t size);
+
+    /**
+     * Shared index access for engines that read the same dictionary
+     * (see AutocompleteEngine). The structures stay owned by this
+     * SpellChecker and are valid until it is destroyed; writers should
+     * go through addWord() / removeWord() / setWordFrequency() so all
+     * structures stay in sync.
      */
-    void updateFrequency(const std::string& word);
+    Trie* getTrie() const { return trie; }
+    HashTable* getFrequencyTable() const { return frequencyTable; }
+
+    /**
+     * Record that a user selected a word
+     * Raises its time-decayed recent-usage score, which autocomplete blends
+     * with the dictionary frequency; the frequency itself does not change.
+     * The use is recorded in the frequency log, if one is set, under the
+     * normalized Trie key (lowercase, unindexed characters dropped).
+     * Time Complexity: O(m) where m is the length of the word
+     * @param word: The selected word
+     * @return: true if the word is in the dictionary
+     */
+    bool updateFrequency(const std::string& word);
+
+    /**
+     * Persist learned frequency updates from now on
+     * @param log: Started frequency log (not owned), or nullptr
+     */
+    void setFrequencyLog(FrequencyLog* log) { frequencyLog = log; }
+
+    /**
+     * Restore the recent-usage scores of a replayed log on top of the
+     * loaded dictionary (not recorded again)
+     * @param log: Frequency log after replay()
+     * @return: Number of dictionary words adjusted
+     */
+    int applyLearnedFrequencies(const FrequencyLog& log);
 
     /**
      * Get cache statistics
@@ -127,6 +268,13 @@ public:
      */
     int getDictionarySize();
 
+    /**
+     * Measure the bytes held by each structure
+     * Trie, hash table and BK-tree counts are kept incrementally; only the
+     * cache walks its entries: O(cache entries), bounded by its capacity
+     */
+    MemoryStats getMemoryStats() const;
+
     /**
      * Clear all cached data
      */
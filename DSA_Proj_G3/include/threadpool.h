@@ -0,0 +1,75 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/**
+ * Thread Pool for CPU-bound work
+ *
+ * Purpose: Share one set of worker threads between the parallel sorts and
+ *          the bulk dictionary builders instead of each spawning its own
+ *
+ * Usage: build a batch of independent tasks and hand it to runAll(). The
+ * calling thread runs queued tasks too while it waits, so runAll() may be
+ * called from inside a task (nested parallelism) without deadlocking.
+ *
+ * Upstream network calls keep their own pool in UpstreamClient: those
+ * tasks block on I/O and must not starve CPU work.
+ */
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> queue;
+    std::mutex queueMutex;
+    std::condition_variable queueReady;
+    bool stopping;
+
+    /**
+     * Worker thread: run queued tasks until stopped
+     */
+    void workerLoop();
+
+    /**
+     * Run one queued task on the calling thread
+     * @return: false if the queue was empty
+     */
+    bool runPendingTask();
+
+public:
+    /**
+     * Constructor: starts the workers
+     * @param threads: Worker count (0 = one per hardware thread)
+     */
+    explicit ThreadPool(int threads = 0);
+
+    /**
+     * Destructor: finishes queued tasks, then joins the workers
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Run a batch of tasks and wait until all of them finished
+     * @param tasks: Independent tasks; the batch is consumed
+     */
+    void runAll(std::vector<std::function<void()>>& tasks);
+
+    /**
+     * Number of threads working on a batch (workers + the caller)
+     */
+    int getConcurrency() const { return static_cast<int>(workers.size()) + 1; }
+
+    /**
+     * Process-wide pool sized to the hardware, created on first use
+     */
+    static ThreadPool& shared();
+};
+
+#endif // THREADPOOL_H
@@ -0,0 +1,73 @@
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Vectorized Tokenizer and Lowercase Normalizer
+ *
+ * Purpose: Prepare bulk text for the spell-checking engines in a single
+ *          pass over the input
+ *
+ * For every block of input bytes the tokenizer:
+ * 1. ASCII-lowercases the block into a normalized output buffer
+ * 2. Classifies bytes as word characters [A-Za-z0-9_] and letters
+ * 3. Turns the classification bitmasks into token spans
+ *
+ * Implementations (selected at runtime):
+ * - AVX2:   32 bytes per instruction (x86 CPUs that support it)
+ * - SSE2:   16 bytes per instruction (all x86-64 CPUs)
+ * - Scalar: portable fallback
+ *
+ * The resulting tokens are string_views into the normalized buffer, so
+ * the engines can consume them with their *Normalized() methods and skip
+ * per-character tolower().
+ *
+ * Time Complexity: O(n) where n is the input length
+ * Space Complexity: O(n) for the normalized buffer
+ */
+class Tokenizer {
+public:
+    /**
+     * A maximal run of word characters
+     */
+    struct Token {
+        std::string_view text;  // Lowercased, points into the normalized buffer
+        size_t offset;          // Offset of the run in the input
+        bool lettersOnly;       // false if the run contains digits or '_'
+    };
+
+    /**
+     * Tokenize and normalize a buffer in one pass
+     * @param data: Input bytes
+     * @param length: Number of input bytes
+     * @param normalized: Receives the lowercased copy of the input
+     * @param tokens: Receives all word runs (views into normalized)
+     */
+    static void tokenize(const char* data, size_t length,
+                         std::string& normalized, std::vector<Token>& tokens);
+
+    /**
+     * ASCII-lowercase length bytes from input into output
+     * Output may alias input
+     */
+    static void toLowerASCII(const char* input, size_t length, char* output);
+
+    /**
+     * Name of the implementation selected for this CPU
+     * @return: "avx2", "sse2" or "scalar"
+     */
+    static const char* implementationName();
+
+    /**
+     * Force an implementation (e.g. to compare them in tests); not
+     * thread-safe, call before tokenizing from other threads
+     * @param name: "avx2", "sse2" or "scalar"
+     * @return: false if this CPU / build does not have it (unchanged)
+     */
+    static bool setImplementation(const std::string& name);
+};
+
+#endif // TOKENIZER_H
@@ -0,0 +1,113 @@
+#ifndef TRACING_H
+#define TRACING_H
+
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * Tracing
+ *
+ * Purpose: Record where a single request spends its time, stage by stage
+ *          (parse, cache, bloom, trie, rank, bktree, serialize, send), and
+ *          dump it in the Chrome trace event format (chrome://tracing or
+ *          Perfetto) on demand
+ *
+ * - Spans are scoped: a Span records one complete event when it leaves scope
+ * - Events go to a ring buffer owned by the recording thread, so recording
+ *   takes no lock; when a ring is full the oldest events are overwritten
+ * - Timestamps come from steady_clock (monotonic, ~20 ns per read)
+ * - While tracing is off a Span is one relaxed load and a branch
+ *
+ * Span names must be string literals (only the pointer is stored).
+ */
+class Tracing {
+public:
+    struct Config {
+        bool enabled;          // Record from startup
+        size_t ringEvents;     // Events kept per thread
+
+        Config();
+
+        /**
+         * Read AUTOCOMPLETE_TRACE (on/off) and AUTOCOMPLETE_TRACE_EVENTS
+         */
+        static Config fromEnvironment();
+    };
+
+    /**
+     * Times one stage; nested spans show up nested in the trace
+     */
+    class Span {
+    private:
+        const char* name;      // nullptr when tracing was off at entry
+        uint64_t startNs;
+
+    public:
+        explicit Span(const char* stageName)
+            : name(Tracing::isEnabled() ? stageName : nullptr), startNs(0) {
+            if (name) startNs = Tracing::now();
+        }
+        ~Span() {
+            if (name) Tracing::record(name, startNs, Tracing::now() - startNs);
+        }
+
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+    };
+
+    /**
+     * Apply a configuration (call before spans are recorded)
+     */
+    static void configure(const Config& config);
+
+    /**
+     * Turn recording on or off; spans already open finish as they started
+     */
+    static void setEnabled(bool on);
+
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * Nanoseconds since the process started tracing (steady_clock)
+     */
+    static uint64_t now();
+
+    /**
+     * Append a complete event to the calling thread's ring
+     * @param name: String literal naming the stage
+     * @param startNs: Start, from now()
+     * @param durationNs: Duration
+     */
+    static void record(const char* name, uint64_t startNs, uint64_t durationNs);
+
+    /**
+     * Every buffered event, as Chrome trace JSON
+     * {"traceEvents": [{"name", "ph": "X", "ts", "dur", "pid", "tid"}, ...]}
+     * Events recorded by other threads during the dump may be missing
+     * @return: JSON document (timestamps in microseconds)
+     */
+    static std::string chromeTraceJSON();
+
+    /**
+     * Write chromeTraceJSON() to a file
+     * @return: true if written
+     */
+    static bool writeChromeTrace(const std::string& filename);
+
+    /**
+     * Drop every buffered event (not atomic with concurrent spans)
+     */
+    static void clear();
+
+    /**
+     * Number of events currently buffered, across threads
+     */
+    static size_t bufferedEvents();
+
+private:
+    static std::atomic<bool> enabled;
+};
+
+#endif // TRACING_H
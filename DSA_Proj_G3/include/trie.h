@@ -2,24 +2,43 @@
 #define TRIE_H
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <functional>
+#include "decayedscore.h"
 
 /**
  * TrieNode represents a single node in the Trie data structure
  * Each node contains:
- * - children: Array of 26 pointers (for lowercase a-z)
+ * - children: Array of 36 pointers (digits 0-9, then lowercase a-z)
  * - isEndOfWord: Flag indicating if this node marks the end of a valid word
- * - frequency: Word usage frequency for ranking suggestions
+ * - frequency: Static (dictionary) frequency for ranking suggestions
+ * - recent: Time-decayed count of recent uses (see DecayedScore)
+ * - inArena: Node lives in a bulk-build block (see Trie::buildSorted)
  */
 class TrieNode {
 public:
-    static const int ALPHABET_SIZE = 26;
+    static const int ALPHABET_SIZE = 36;
     TrieNode* children[ALPHABET_SIZE];
     bool isEndOfWord;
+    bool inArena;       // Allocated by a bulk build, freed with its block
     int frequency;
+    DecayedScore recent;
 
     TrieNode();
     ~TrieNode();
+
+    /**
+     * Map a character to its child index (case-insensitive)
+     * Digits come first so that child order matches ASCII order
+     * @return: 0-35, or -1 for characters the Trie does not index
+     */
+    static int charToIndex(char ch);
+
+    /**
+     * Map a child index back to its (lowercase) character
+     */
+    static char indexToChar(int index);
 };
 
 /**
@@ -32,22 +51,58 @@ public:
  * - Search: O(m) where m is the length of the word
  * - Prefix Search: O(m + k) where k is the number of matching words
  * 
- * Space Complexity: O(N * M * 26) where N is number of words, M is average length
+ * Space Complexity: O(N * M * 36) where N is number of words, M is average length
  */
 class Trie {
 private:
     TrieNode* root;
     
+    // Node blocks from buildSorted(), released in the destructor
+    std::vector<TrieNode*> arenas;
+    
+    // Nodes allocated one at a time (root included), kept for getMemoryBytes
+    size_t looseNodes;
+    
+    // Ranking blend: frequency + recencyWeight * decayed recent uses
+    double recencyHalfLife;
+    double recencyWeight;
+    std::function<uint32_t()> clock;
+    
+    // Node that ends the given word, or nullptr
+    TrieNode* findWordNode(const std::string& word) const;
+    
+    // Blended ranking score of a word node at time 'now'
+    int rankingScore(const TrieNode* node, uint32_t now) const;
+    
     // Helper function for recursive word collection
     void collectWords(TrieNode* node, std::string currentWord, 
                      std::vector<std::pair<std::string, int>>& results);
     
+    // Helper for topKByFrequency: walks the subtree keeping the best k
+    // words in a bounded heap (worst ranked word on top)
+    void collectTopK(const TrieNode* node, std::string& currentWord, size_t k, uint32_t now,
+                     std::vector<std::pair<std::string, int>>& heap) const;
+
+    // Shared body of the buildSorted overloads
+    template<typename Word>
+    void buildSortedImpl(const std::vector<std::pair<Word, int>>& sortedWords);
+
     // Helper function for destroying the trie
     void destroyTrie(TrieNode* node);
 
 public:
     Trie();
+    
+    /**
+     * Bulk-build constructor (see buildSorted)
+     * @param sortedWords: (word, frequency) pairs sorted by word
+     */
+    explicit Trie(const std::vector<std::pair<std::string, int>>& sortedWords);
+    
     ~Trie();
+    
+    Trie(const Trie&) = delete;
+    Trie& operator=(const Trie&) = delete;
 
     /**
      * Insert a word into the Trie
@@ -56,6 +111,24 @@ public:
      */
     void insertWord(const std::string& word, int frequency = 1);
 
+    /**
+     * Insert a lexicographically sorted word list in one pass
+     * Each word starts from the path of the previous one (shared prefix)
+     * instead of the root, and new nodes come from contiguous blocks in
+     * creation order, i.e. DFS order: prefix traversals then walk memory
+     * mostly forward.
+     * Unsorted input still builds a correct Trie, only with less sharing
+     * and locality. Duplicates behave like insertWord (last one wins).
+     * Time Complexity: O(total characters), one allocation per 1024 nodes
+     * @param sortedWords: (word, frequency) pairs sorted by word
+     */
+    void buildSorted(const std::vector<std::pair<std::string, int>>& sortedWords);
+
+    /**
+     * Same, over word views (e.g. into a mapped dictionary file)
+     */
+    void buildSorted(const std::vector<std::pair<std::string_view, int>>& sortedWords);
+
     /**
      * Search for an exact word in the Trie
      * @param word: The word to search for
@@ -63,6 +136,14 @@ public:
      */
     bool searchWord(const std::string& word);
 
+    /**
+     * Search for a word that is already lowercased (see Tokenizer)
+     * Skips per-character case folding
+     * @param word: Lowercase word
+     * @return: true if word exists, false otherwise
+     */
+    bool searchWordNormalized(std::string_view word) const;
+
     /**
      * Search for all words with a given prefix
      * @param prefix: The prefix to search for
@@ -70,6 +151,20 @@ public:
      */
     std::vector<std::pair<std::string, int>> searchPrefix(const std::string& prefix);
 
+    /**
+     * Get the k best ranked words with a given prefix
+     * Score = static frequency + recency weight * decayed recent uses
+     * (just the frequency for words never used). Scores are computed
+     * during the traversal and kept in a heap of size k, so no full sort
+     * of the matches is needed
+     * Time Complexity: O(m + n log k) for n matching words
+     * @param prefix: The prefix to search for
+     * @param k: Maximum number of results
+     * @return: (word, score) pairs, highest score first, ties in
+     *          alphabetical order
+     */
+    std::vector<std::pair<std::string, int>> topKByFrequency(const std::string& prefix, int k) const;
+
     /**
      * Get autocomplete suggestions for a prefix
      * Returns words sorted by frequency
@@ -86,11 +181,77 @@ public:
      */
     void updateFrequency(const std::string& word, int increment = 1);
 
+    /**
+     * Record a use of a word (e.g. a selected suggestion)
+     * Adds to its decayed recent-usage score; the static frequency is
+     * left alone, so counters cannot grow without bound
+     * Time Complexity: O(m) where m is the length of the word
+     * @param word: The word that was used
+     * @param amount: Number of uses
+     * @return: true if the word exists
+     */
+    bool recordUse(const std::string& word, double amount = 1.0);
+
+    /**
+     * Restore a recent-usage score (e.g. replayed from a log)
+     * Merged into the word's current score, so several entries that
+     * resolve to the same word all count
+     * @param word: The word to update
+     * @param score: Score and the time it was taken at
+     * @return: true if the word exists
+     */
+    bool mergeRecentScore(const std::string& word, const DecayedScore& score);
+
+    /**
+     * Decayed recent-usage score of a word, as of now
+     * @return: Score (0 for unknown or unused words)
+     */
+    double getRecentScore(const std::string& word) const;
+
+    /**
+     * Configure the ranking blend
+     * @param halfLifeSeconds: Time for recent uses to lose half their weight
+     * @param weight: Frequency points one fresh use is worth
+     */
+    void setRecency(double halfLifeSeconds, double weight);
+
+    /**
+     * Replace the wall clock (seconds since the Unix epoch), e.g. in tests
+     */
+    void setClock(const std::function<uint32_t()>& now) { clock = now; }
+
+    /**
+     * Set the frequency of an existing word
+     * @param word: The word to update
+     * @param frequency: New frequency
+     * @return: true if the word exists
+     */
+    bool setFrequency(const std::string& word, int frequency);
+
+    /**
+     * Remove a word from the Trie
+     * Nodes left without words below them are unlinked; heap nodes are
+     * deleted, bulk-built ones stay in their block until the Trie goes
+     * Time Complexity: O(m) where m is the length of the word
+     * @param word: The word to remove
+     * @return: true if the word was present
+     */
+    bool removeWord(const std::string& word);
+
     /**
      * Get the total number of words in the Trie
      * @return: Count of unique words
      */
     int getWordCount();
+
+    /**
+     * Bytes held by the Trie: bulk-build blocks (used or not), nodes
+     * allocated one at a time, and the block list
+     * Time Complexity: O(1) (counted as nodes are added and removed)
+     * @return: Bytes requested from the allocator (its own overhead not
+     *          included)
+     */
+    size_t getMemoryBytes() const;
 };
 
 #endif // TRIE_H
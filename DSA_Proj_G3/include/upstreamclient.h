@@ -0,0 +1,342 @@
+#ifndef UPSTREAMCLIENT_H
+#define UPSTREAMCLIENT_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <deque>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <future>
+#include <functional>
+#include <chrono>
+#include "apifetcher.h"
+#include "lrucache.h"
+
+/**
+ * Circuit Breaker
+ *
+ * Purpose: Stop sending requests to an upstream that keeps failing, so
+ *          callers fall back to local data without waiting for a timeout
+ *
+ * States:
+ * - Closed:   Requests flow; consecutive failures are counted
+ * - Open:     Requests are rejected immediately until the cool-down ends
+ * - HalfOpen: One trial request is let through; success closes the
+ *             circuit, failure opens it again (a trial that never reports
+ *             back is replaced after another cool-down)
+ *
+ * Thread-safe.
+ */
+class CircuitBreaker {
+public:
+    enum class State { Closed, Open, HalfOpen };
+
+private:
+    int failureThreshold;
+    int openMs;
+    int consecutiveFailures;
+    bool trialInFlight;
+    State state;
+    std::chrono::steady_clock::time_point openedAt;
+    mutable std::mutex mutex;
+
+public:
+    /**
+     * Constructor
+     * @param failureThreshold: Consecutive failures that open the circuit
+     * @param openMs: Cool-down before a trial request is allowed
+     */
+    CircuitBreaker(int failureThreshold = 3, int openMs = 10000);
+
+    /**
+     * Check whether a request may be sent now
+     * @return: false if the circuit is open (caller should fall back)
+     */
+    bool allowRequest();
+
+    /**
+     * Record a successful request (closes the circuit)
+     */
+    void recordSuccess();
+
+    /**
+     * Record a failed request
+     * @return: true if this failure opened the circuit
+     */
+    bool recordFailure();
+
+    /**
+     * Get the current state
+     */
+    State getState() const;
+
+    /**
+     * Get a state name for logs and /health ("closed", "open", "half-open")
+     */
+    static const char* stateName(State state);
+};
+
+/**
+ * Asynchronous Upstream API Client
+ *
+ * Purpose: Query Datamuse and DictionaryAPI without letting a slow or
+ *          failing upstream stall the server
+ *
+ * Features:
+ * - Requests run on a small worker pool and return std::future results
+ * - Every call carries a deadline; socket I/O is bounded by poll()
+ * - Keep-alive connections are pooled and reused per host
+ * - Responses are cached in an LRU cache with a time-to-live
+ * - One circuit breaker per upstream; while open, calls complete
+ *   immediately with ok == false
+ * - Base URLs are configurable, so tests can point the client at a
+ *   local stand-in server
+ *
+ * Transport:
+ * - Windows: WinINet with one shared session and timeouts
+ * - POSIX:   plain HTTP/1.1 over sockets (https:// needs a TLS-capable
+ *            proxy in front; such URLs fail fast and trip the breaker)
+ */
+class UpstreamClient {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Deadline = Clock::time_point;
+
+    /**
+     * Client configuration
+     */
+    struct Config {
+        std::string datamuseBaseUrl;    // Default: https://api.datamuse.com
+        std::string dictionaryBaseUrl;  // Default: https://api.dictionaryapi.dev/api/v2/entries/en
+        int timeoutMs;                  // Per-call deadline (default: 800)
+        int workerThreads;              // Concurrent upstream calls (default: 4)
+        int maxQueuedRequests;          // Beyond this, calls fail fast (default: 64)
+        int maxIdlePerHost;             // Pooled keep-alive connections (default: 4)
+        int cacheCapacity;              // Cached responses (default: 1000)
+        int cacheTtlMs;                 // Response lifetime (default: 5 minutes)
+        int failureThreshold;           // Failures that open a breaker (default: 3)
+        int breakerOpenMs;              // Breaker cool-down (default: 10 s)
+
+        Config();
+
+        /**
+         * Defaults overridden by environment variables:
+         * AUTOCOMPLETE_DATAMUSE_URL, AUTOCOMPLETE_DICTIONARY_URL,
+         * AUTOCOMPLETE_UPSTREAM_TIMEOUT_MS, AUTOCOMPLETE_UPSTREAM_CACHE_TTL_MS
+         */
+        static Config fromEnvironment();
+    };
+
+    /**
+     * Result of a suggestion lookup
+     */
+    struct SuggestionResult {
+        bool ok;           // false: upstream unavailable, use local data
+        bool cached;       // Served from the response cache
+        std::vector<APIFetcher::WordSuggestion> suggestions;
+        std::string error;
+
+        SuggestionResult() : ok(false), cached(false) {}
+    };
+
+    /**
+     * Result of a definition lookup
+     */
+    struct DefinitionResult {
+        bool ok;           // false: upstream unavailable, use local data
+        bool cached;
+        APIFetcher::DictionaryEntry entry;  // entry.found is false for unknown words
+        std::string error;
+
+        DefinitionResult() : ok(false), cached(false) {}
+    };
+
+    /**
+     * Counters since construction
+     */
+    struct Stats {
+        size_t requests;           // Calls made by the application
+        size_t cacheHits;
+        size_t networkRequests;    // HTTP requests actually sent
+        size_t connectionsOpened;
+        size_t connectionsReused;
+        size_t failures;           // Errors and timeouts
+        size_t timeouts;
+        size_t shortCircuited;     // Rejected by an open breaker or full queue
+        size_t prefetches;         // Background fetches started by prefetch*()
+    };
+
+private:
+    struct HttpResult {
+        bool ok;
+        bool timedOut;
+        bool cached;
+        int status;
+        std::string body;
+        std::string error;
+
+        HttpResult() : ok(false), timedOut(false), cached(false), status(0) {}
+    };
+
+    Config config;
+
+    // Worker pool
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> queue;
+    std::mutex queueMutex;
+    std::condition_variable queueReady;
+    bool stopping;
+
+    // Response cache: URL -> body (guarded by cacheMutex)
+    LRUCache cache;
+    std::mutex cacheMutex;
+
+    CircuitBreaker datamuseBreaker;
+    CircuitBreaker dictionaryBreaker;
+
+#ifdef _WIN32
+    void* session;  // Shared WinINet session (HINTERNET)
+#else
+    // Idle keep-alive sockets per "host:port"
+    std::map<std::string, std::vector<int>> idleConnections;
+    std::mutex poolMutex;
+
+    int acquireConnection(const std::string& host, int port, Deadline deadline,
+                          bool& reused, std::string& error);
+    void releaseConnection(const std::string& host, int port, int socket);
+#endif
+
+    std::atomic<size_t> requests;
+    std::atomic<size_t> cacheHits;
+    std::atomic<size_t> networkRequests;
+    std::atomic<size_t> connectionsOpened;
+    std::atomic<size_t> connectionsReused;
+    std::atomic<size_t> failures;
+    std::atomic<size_t> timeouts;
+    std::atomic<size_t> shortCircuited;
+    std::atomic<size_t> prefetches;
+
+    /**
+     * Worker thread main loop
+     */
+    void workerLoop();
+
+    /**
+     * Queue a task for the worker pool
+     * @return: false if the queue is full or the client is shutting down
+     */
+    bool submit(std::function<void()> task);
+
+    /**
+     * Perform one GET request before the deadline
+     * @param url: Full URL
+     * @param deadline: Give up at this point in time
+     * @return: Status code and body, or an error
+     */
+    HttpResult httpGet(const std::string& url, Deadline deadline);
+
+    /**
+     * Cached, breaker-protected GET shared by all endpoints
+     * done runs right away on a cache hit, open breaker or full queue,
+     * otherwise on a worker thread once the request finishes
+     * @param notFoundIsEmpty: Treat 404 as a successful empty body
+     * @param done: Receives the body; ok == false when the upstream is unavailable
+     */
+    void fetch(const std::string& url, CircuitBreaker& breaker, bool notFoundIsEmpty,
+               Deadline deadline, const std::function<void(const HttpResult&)>& done);
+
+    /**
+     * Fetch and parse a Datamuse endpoint
+     */
+    std::future<SuggestionResult> fetchSuggestions(const std::string& url, Deadline deadline);
+
+    /**
+     * Endpoint URLs (also the cache keys)
+     */
+    std::string autocompleteUrl(const std::string& prefix, int maxResults) const;
+    std::string spellingUrl(const std::string& word, int maxResults) const;
+
+public:
+    /**
+     * Constructor: starts the worker pool
+     * @param config: Client configuration
+     */
+    explicit UpstreamClient(const Config& config = Config());
+
+    /**
+     * Destructor: finishes queued calls, joins workers, closes connections
+     */
+    ~UpstreamClient();
+
+    UpstreamClient(const UpstreamClient&) = delete;
+    UpstreamClient& operator=(const UpstreamClient&) = delete;
+
+    /**
+     * Deadline for a call started now, using the configured timeout
+     */
+    Deadline defaultDeadline() const;
+
+    /**
+     * Fetch autocomplete suggestions (Datamuse /sug)
+     * @param prefix: Word prefix
+     * @param maxResults: Maximum number of results
+     * @param deadline: Time by which the result must be available
+     * @return: Future result (ready immediately on cache hit or open breaker)
+     */
+    std::future<SuggestionResult> fetchAutocompleteAsync(const std::string& prefix,
+                                                         int maxResults, Deadline deadline);
+
+    /**
+     * Fetch spelling corrections (Datamuse /words?sp=)
+     */
+    std::future<SuggestionResult> fetchSpellingAsync(const std::string& word,
+                                                     int maxResults, Deadline deadline);
+
+    /**
+     * Fetch a definition (DictionaryAPI); unknown words give ok with found == false
+     */
+    std::future<DefinitionResult> fetchDefinitionAsync(const std::string& word,
+                                                       Deadline deadline);
+
+    /**
+     * Warm the cache for a prefix in the background
+     * Nothing is sent if the response is already cached
+     * @return: true if a fetch was started
+     */
+    bool prefetchAutocomplete(const std::string& prefix, int maxResults);
+
+    /**
+     * Wait for a result until the deadline
+     * @return: The result, or a failed result if the deadline passed first
+     */
+    template <typename Result>
+    static Result await(std::future<Result>& future, Deadline deadline) {
+        if (future.wait_until(deadline) != std::future_status::ready) {
+            Result timedOut;
+            timedOut.error = "Deadline exceeded";
+            return timedOut;
+        }
+        return future.get();
+    }
+
+    /**
+     * Get counters since construction
+     */
+    Stats getStats() const;
+
+    /**
+     * Get breaker states for monitoring
+     */
+    CircuitBreaker::State getDatamuseState() const { return datamuseBreaker.getState(); }
+    CircuitBreaker::State getDictionaryState() const { return dictionaryBreaker.getState(); }
+
+    /**
+     * Drop all cached responses
+     */
+    void clearCache();
+};
+
+#endif // UPSTREAMCLIENT_H
@@ -21,8 +21,8 @@ public:
      */
     class Timer {
     private:
-        std::chrono::high_resolution_clock::time_point startTime;
-        std::chrono::high_resolution_clock::time_point endTime;
+        std::chrono::steady_clock::time_point startTime;
+        std::chrono::steady_clock::time_point endTime;
         bool running;
 
     public:
@@ -89,6 +89,12 @@ public:
      */
     static void log(const std::string& message, const std::string& level = "INFO");
 
+    /**
+     * Send log output to stderr instead of stdout
+     * Used by non-interactive modes that write results to stdout
+     */
+    static void setLogToStderr(bool enabled);
+
     /**
      * Log error message
      */
@@ -124,6 +130,11 @@ public:
      */
     static std::string formatDouble(double value, int precision = 2);
 
+    /**
+     * Format a byte count with a binary unit (e.g., 1536 -> "1.50 KB")
+     */
+    static std::string formatBytes(size_t bytes);
+
     /**
      * Calculate average of vector of doubles
      */
@@ -135,10 +146,22 @@ public:
     static double standardDeviation(const std::vector<double>& values);
 
     /**
-     * Get memory usage in MB (approximate)
+     * Get memory usage in MB (resident set size, see getResidentMemoryBytes)
      */
     static double getMemoryUsageMB();
 
+    /**
+     * Resident set size of this process
+     * @return: Bytes (Linux: from /proc/self/statm; 0 where unsupported)
+     */
+    static size_t getResidentMemoryBytes();
+
+    /**
+     * Heap bytes owned by a string: its buffer, or 0 while the text fits
+     * in the string object itself (small-string optimization)
+     */
+    static size_t stringHeapBytes(const std::string& str);
+
     /**
      * Print a separator line
      */
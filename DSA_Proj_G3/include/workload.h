@@ -0,0 +1,154 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <random>
+#include <cstdint>
+
+/**
+ * Zipf Distribution
+ *
+ * Purpose: Draw ranks 1..n with P(k) proportional to 1 / k^exponent, the
+ *          shape of word frequencies in natural language
+ *
+ * Uses rejection-inversion sampling (Hoermann & Derflinger): O(1) time and
+ * memory per draw, so n can be far larger than a table would allow.
+ */
+class ZipfDistribution {
+private:
+    uint64_t n;
+    double exponent;
+    double hIntegralX1;
+    double hIntegralN;
+    double threshold;
+
+    double h(double x) const;
+    double hIntegral(double x) const;
+    double hIntegralInverse(double x) const;
+
+public:
+    /**
+     * Constructor
+     * @param n: Number of ranks (>= 1)
+     * @param exponent: Skew (> 0; about 1.0 for English)
+     */
+    ZipfDistribution(uint64_t n, double exponent);
+
+    /**
+     * Draw one rank
+     * @return: Rank in [1, n]; 1 is the most likely
+     */
+    uint64_t sample(std::mt19937_64& rng) const;
+};
+
+/**
+ * Workload Generator
+ *
+ * Purpose: Produce dictionaries and query streams at production scale for
+ *          benchmarks and load tests, fully offline and reproducible (every
+ *          output is a function of the config and its seed)
+ *
+ * Dictionary: pronounceable synthetic words (syllables cut to a length drawn
+ * from a clamped normal distribution), all distinct, with Zipf frequencies
+ * by rank. Written in rank order in the usual "word frequency" format.
+ *
+ * Queries: words are picked by Zipf rank from a dictionary, then turned into
+ * - Prefix:    one prefix of the word
+ * - Keystroke: the prefixes a user types one key at a time (1, 2, ...
+ *              characters) until they stop or the word is complete
+ * - Typo:      the word with one (sometimes two) realistic errors: a
+ *              neighbouring QWERTY key substituted or inserted, a letter
+ *              dropped or doubled, two letters transposed
+ */
+class WorkloadGenerator {
+public:
+    /**
+     * Dictionary settings
+     */
+    struct DictionaryConfig {
+        size_t words;           // Distinct words (default: 100000)
+        double zipfExponent;    // Frequency skew (default: 1.0)
+        int maxFrequency;       // Frequency of rank 1; the tail bottoms out at 1 (default: 1000000)
+        double lengthMean;      // Word length distribution (default: 7.5 +- 2.5, 2..20)
+        double lengthStddev;
+        int minLength;
+        int maxLength;
+        uint64_t seed;          // Default: 42
+
+        DictionaryConfig();
+    };
+
+    /**
+     * Query stream settings
+     */
+    struct QueryConfig {
+        size_t queries;         // Lines to produce (default: 100000)
+        double zipfExponent;    // Popularity skew of queried words (default: 1.0)
+        double prefixShare;     // Mix of query types (default: 50 / 30 / 20);
+        double keystrokeShare;  // normalized, so any non-negative weights work
+        double typoShare;
+        double secondErrorRate; // Chance a typo gets a second error (default: 0.1)
+        uint64_t seed;          // Default: 7
+
+        QueryConfig();
+    };
+
+    enum class QueryType { Prefix, Keystroke, Typo };
+
+    /**
+     * One generated query
+     */
+    struct Query {
+        QueryType type;
+        std::string text;       // What the user sent
+        std::string intended;   // Word they meant
+    };
+
+private:
+    std::vector<std::string> wordsByRank;   // Most frequent first
+    QueryConfig config;
+
+public:
+    /**
+     * Generate a dictionary, streaming the words to a callback
+     * @param config: Size, frequency and length distribution
+     * @param onWord: Called with (word, frequency) in rank order
+     * @return: Number of words produced
+     */
+    static size_t generateDictionary(const DictionaryConfig& config,
+                                     const std::function<void(const std::string&, int)>& onWord);
+
+    /**
+     * Constructor: rank the dictionary the queries are drawn from
+     * @param dictionary: (word, frequency) pairs in any order
+     * @param config: Query mix and seed
+     */
+    WorkloadGenerator(const std::vector<std::pair<std::string, int>>& dictionary,
+                      const QueryConfig& config = QueryConfig());
+
+    /**
+     * Generate the query stream
+     * @param onQuery: Called once per query, in order
+     * @return: Number of queries produced (0 if the dictionary is empty)
+     */
+    size_t generateQueries(const std::function<void(const Query&)>& onQuery) const;
+
+    /**
+     * Apply one realistic typing error (insert, delete, substitute or
+     * transpose); words shorter than 2 characters are returned unchanged
+     * @param word: Correct word
+     * @param rng: Random source
+     * @return: Misspelled word (never equal to word for longer words)
+     */
+    static std::string misspell(const std::string& word, std::mt19937_64& rng);
+
+    /**
+     * Name of a query type as written to query files
+     * @return: "prefix", "keystroke" or "typo"
+     */
+    static const char* typeName(QueryType type);
+};
+
+#endif // WORKLOAD_H
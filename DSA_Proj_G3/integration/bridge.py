@@ -5,10 +5,11 @@ Integration Bridge for Smart Autocomplete & Spell-Checker Suite
 This script serves as an optional bridge between the frontend and backend,
 providing a simple HTTP server that can:
 1. Receive queries from the frontend
-2. Write them to data/query.txt
-3. Execute the C++ backend binary
-4. Read results from data/output.json
-5. Return results to the frontend
+2. Pass them to one long-lived backend process (`autocomplete --daemon`),
+   which loads the dictionary once and answers JSON lines on stdin/stdout
+3. Return results to the frontend
+
+The backend is started on the first query and restarted if it exits.
 
 Usage:
     python bridge.py [--port PORT] [--binary PATH]
@@ -22,13 +23,86 @@ import subprocess
 import os
 import sys
 import time
+import queue
+import threading
 from http.server import HTTPServer, BaseHTTPRequestHandler
 from urllib.parse import parse_qs
 import argparse
 
+class BackendDaemon:
+    """One warm `autocomplete --daemon` process shared by all requests"""
+
+    # The first answer also waits for the dictionary load
+    STARTUP_TIMEOUT = 30.0
+
+    def __init__(self, binary_path, timeout=5.0):
+        self.binary_path = binary_path
+        self.timeout = timeout
+        self.process = None
+        self.lines = None
+        self.next_id = 0
+        self.answered = 0
+        self.lock = threading.Lock()
+
+    def start(self):
+        self.process = subprocess.Popen(
+            [self.binary_path, '--daemon'],
+            stdin=subprocess.PIPE,
+            stdout=subprocess.PIPE,
+            text=True,
+            bufsize=1
+        )
+        # Responses are read on a thread so a wait can time out portably
+        self.lines = queue.Queue()
+        threading.Thread(target=self._read_lines, args=(self.process, self.lines), daemon=True).start()
+        self.answered = 0
+
+    @staticmethod
+    def _read_lines(process, lines):
+        for line in process.stdout:
+            lines.put(line)
+        lines.put(None)  # Backend exited
+
+    def stop(self):
+        if self.process is not None:
+            self.process.kill()
+            self.process.wait()
+            self.process = None
+
+    def is_running(self):
+        return self.process is not None and self.process.poll() is None
+
+    def query(self, query, mode):
+        """Send one request and wait for its response line"""
+        with self.lock:
+            if not self.is_running():
+                self.start()
+
+            self.next_id += 1
+            request_id = str(self.next_id)
+            self.process.stdin.write(json.dumps({'id': request_id, 'query': query, 'mode': mode}) + '\n')
+            self.process.stdin.flush()
+
+            timeout = self.timeout if self.answered > 0 else self.STARTUP_TIMEOUT
+            try:
+                line = self.lines.get(timeout=timeout)
+            except queue.Empty:
+                self.stop()  # A late answer would be read by the next query
+                raise TimeoutError('Backend timeout')
+            if line is None:
+                self.stop()
+                raise RuntimeError('Backend exited')
+
+            self.answered += 1
+            response = json.loads(line)
+            response.pop('id', None)
+            return response
+
+
 class IntegrationHandler(BaseHTTPRequestHandler):
     binary_path = "./autocomplete"
     data_dir = "data"
+    backend = None
     
     def do_GET(self):
         """Handle GET requests"""
@@ -61,31 +135,10 @@ class IntegrationHandler(BaseHTTPRequestHandler):
                 self.send_json({'error': 'No query provided'}, 400)
                 return
             
-            # Write query to file
-            query_file = os.path.join(self.data_dir, 'query.txt')
-            with open(query_file, 'w') as f:
-                f.write(query)
-            
-            # Execute backend binary
+            # Ask the warm backend process
             try:
-                # Run with timeout
-                result = subprocess.run(
-                    [self.binary_path],
-                    timeout=5,
-                    capture_output=True,
-                    text=True
-                )
-                
-                # Read output
-                output_file = os.path.join(self.data_dir, 'output.json')
-                if os.path.exists(output_file):
-                    with open(output_file, 'r') as f:
-                        output_data = json.load(f)
-                    self.send_json(output_data)
-                else:
-                    self.send_json({'error': 'No output generated'}, 500)
-                    
-            except subprocess.TimeoutExpired:
+                self.send_json(self.backend.query(query, mode))
+            except TimeoutError:
                 self.send_json({'error': 'Backend timeout'}, 504)
             except FileNotFoundError:
                 self.send_json({'error': 'Backend binary not found'}, 500)
@@ -125,6 +178,7 @@ class IntegrationHandler(BaseHTTPRequestHandler):
             'status': 'running',
             'binary': self.binary_path,
             'binary_exists': os.path.exists(self.binary_path),
+            'backend_running': self.backend.is_running(),
             'data_dir': self.data_dir,
             'data_dir_exists': os.path.exists(self.data_dir)
         }
@@ -150,6 +204,7 @@ def main():
     
     IntegrationHandler.binary_path = args.binary
     IntegrationHandler.data_dir = args.data_dir
+    IntegrationHandler.backend = BackendDaemon(args.binary)
     
     # Create data directory if it doesn't exist
     os.makedirs(args.data_dir, exist_ok=True)
@@ -169,6 +224,7 @@ def main():
     except KeyboardInterrupt:
         print("\n\nShutting down server...")
         server.shutdown()
+        IntegrationHandler.backend.stop()
         print("Server stopped.")
 
 if __name__ == '__main__':
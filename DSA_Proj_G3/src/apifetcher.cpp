@@ -1,10 +1,14 @@
 #include "apifetcher.h"
+#include "jsonreader.h"
 #include <sstream>
 #include <iomanip>
+
+#ifdef _WIN32
 #include <windows.h>
 #include <wininet.h>
 
 #pragma comment(lib, "wininet.lib")
+#endif
 
 namespace APIFetcher {
 
@@ -12,6 +16,7 @@ namespace APIFetcher {
 
     // ==================== HTTP UTILITIES ====================
     
+#ifdef _WIN32
     std::string httpGet(const std::string& url) {
         std::string result;
         lastError.clear();
@@ -61,6 +66,14 @@ namespace APIFetcher {
 
         return result;
     }
+#else
+    std::string httpGet(const std::string& url) {
+        // No HTTPS client without WinINet: callers fall back to local data
+        (void)url;
+        lastError = "HTTP client not available on this platform";
+        return "";
+    }
+#endif
 
     std::string urlEncode(const std::string& str) {
         std::ostringstream encoded;
@@ -80,183 +93,182 @@ namespace APIFetcher {
         return encoded.str();
     }
 
-    // ==================== JSON PARSING ====================
-    
-    std::string extractJSONValue(const std::string& json, const std::string& key) {
-        std::string searchKey = "\"" + key + "\":";
-        size_t pos = json.find(searchKey);
-        
-        if (pos == std::string::npos) {
-            return "";
+    // ==================== RESPONSE PARSING ====================
+
+    /**
+     * First non-empty "audio" of a DictionaryAPI "phonetics" array
+     */
+    static void readFirstAudio(JSONReader& json, std::string& audioUrl) {
+        if (json.peek() != JSONReader::ARRAY) {
+            json.skipValue();
+            return;
         }
 
-        pos += searchKey.length();
-        
-        // Skip whitespace
-        while (pos < json.length() && (json[pos] == ' ' || json[pos] == '\t')) {
-            pos++;
+        std::string key;
+        json.beginArray();
+        while (json.nextElement()) {
+            if (!audioUrl.empty() || json.peek() != JSONReader::OBJECT) {
+                json.skipValue();
+                continue;
+            }
+            json.beginObject();
+            while (json.nextMember(key)) {
+                if (key == "audio" && json.peek() == JSONReader::STRING) {
+                    json.readString(audioUrl);
+                } else {
+                    json.skipValue();
+                }
+            }
         }
+    }
 
-        if (pos >= json.length()) return "";
+    /**
+     * First definition of a DictionaryAPI "meanings" array
+     * (meanings[].definitions[].definition)
+     */
+    static void readFirstDefinition(JSONReader& json, std::string& definition) {
+        if (json.peek() != JSONReader::ARRAY) {
+            json.skipValue();
+            return;
+        }
 
-        // Check if value is a string
-        if (json[pos] == '"') {
-            pos++; // Skip opening quote
-            size_t endPos = json.find('"', pos);
-            if (endPos != std::string::npos) {
-                return json.substr(pos, endPos - pos);
+        std::string key;
+        json.beginArray();
+        while (json.nextElement()) {
+            if (!definition.empty() || json.peek() != JSONReader::OBJECT) {
+                json.skipValue();
+                continue;
             }
-        }
-        // Check if value is a number
-        else if (isdigit(json[pos]) || json[pos] == '-') {
-            size_t endPos = pos;
-            while (endPos < json.length() && 
-                   (isdigit(json[endPos]) || json[endPos] == '.' || json[endPos] == '-')) {
-                endPos++;
+            json.beginObject();
+            while (json.nextMember(key)) {
+                if (key != "definitions" || json.peek() != JSONReader::ARRAY) {
+                    json.skipValue();
+                    continue;
+                }
+                json.beginArray();
+                while (json.nextElement()) {
+                    if (!definition.empty() || json.peek() != JSONReader::OBJECT) {
+                        json.skipValue();
+                        continue;
+                    }
+                    json.beginObject();
+                    while (json.nextMember(key)) {
+                        if (key == "definition" && json.peek() == JSONReader::STRING) {
+                            json.readString(definition);
+                        } else {
+                            json.skipValue();
+                        }
+                    }
+                }
             }
-            return json.substr(pos, endPos - pos);
         }
-
-        return "";
     }
 
-    std::vector<std::string> extractJSONArray(const std::string& json, const std::string& arrayName) {
-        std::vector<std::string> result;
-        
-        std::string searchKey = "\"" + arrayName + "\":[";
-        size_t startPos = json.find(searchKey);
-        
-        if (startPos == std::string::npos) {
-            // Try without quotes (Datamuse returns bare arrays)
-            startPos = json.find("[");
-            if (startPos == std::string::npos) return result;
-        } else {
-            startPos += searchKey.length() - 1;
+    std::vector<WordSuggestion> parseSuggestions(const std::string& response) {
+        std::vector<WordSuggestion> suggestions;
+
+        // [{"word": "hello", "score": 3000}, ...]
+        JSONReader json(response);
+        if (!json.beginArray()) return suggestions;
+
+        std::string key;
+        while (json.nextElement()) {
+            if (json.peek() != JSONReader::OBJECT) {
+                json.skipValue();
+                continue;
+            }
+
+            std::string word;
+            int score = 100;  // Datamuse omits the score for some results
+            json.beginObject();
+            while (json.nextMember(key)) {
+                if (key == "word" && json.peek() == JSONReader::STRING) {
+                    json.readString(word);
+                } else if (key == "score" && json.peek() == JSONReader::NUMBER) {
+                    double value;
+                    if (json.readNumber(value)) score = static_cast<int>(value);
+                } else {
+                    json.skipValue();
+                }
+            }
+
+            if (json.ok() && !word.empty()) {
+                suggestions.push_back(WordSuggestion(word, score));
+            }
         }
 
-        size_t endPos = json.find(']', startPos);
-        if (endPos == std::string::npos) return result;
+        return suggestions;
+    }
+
+    DictionaryEntry parseDefinition(const std::string& word, const std::string& response) {
+        DictionaryEntry entry;
+        entry.word = word;
 
-        std::string arrayContent = json.substr(startPos + 1, endPos - startPos - 1);
+        // Known words come as an array of entries; unknown ones as an
+        // object ({"title": "No Definitions Found", ...})
+        JSONReader json(response);
+        if (!json.beginArray()) return entry;
 
-        // Parse objects in array
-        size_t objStart = 0;
-        int braceCount = 0;
+        std::string key;
+        while (json.nextElement()) {
+            if (entry.found || json.peek() != JSONReader::OBJECT) {
+                json.skipValue();
+                continue;
+            }
 
-        for (size_t i = 0; i < arrayContent.length(); i++) {
-            if (arrayContent[i] == '{') {
-                if (braceCount == 0) objStart = i;
-                braceCount++;
-            } else if (arrayContent[i] == '}') {
-                braceCount--;
-                if (braceCount == 0) {
-                    result.push_back(arrayContent.substr(objStart, i - objStart + 1));
+            // Fields of the first entry
+            entry.found = true;
+            json.beginObject();
+            while (json.nextMember(key)) {
+                if (key == "phonetic" && json.peek() == JSONReader::STRING) {
+                    json.readString(entry.phonetic);
+                } else if (key == "phonetics") {
+                    readFirstAudio(json, entry.audioUrl);
+                } else if (key == "meanings") {
+                    readFirstDefinition(json, entry.definition);
+                } else {
+                    json.skipValue();
                 }
             }
         }
 
-        return result;
+        return entry;
     }
 
     // ==================== DATAMUSE API ====================
     
     std::vector<WordSuggestion> fetchAutocompleteSuggestions(const std::string& prefix, int maxResults) {
-        std::vector<WordSuggestion> suggestions;
-
-        if (prefix.empty()) return suggestions;
+        if (prefix.empty()) return std::vector<WordSuggestion>();
 
         // Build URL
         std::string url = "https://api.datamuse.com/sug?s=" + urlEncode(prefix) + 
                          "&max=" + std::to_string(maxResults);
 
-        // Fetch data
-        std::string response = httpGet(url);
-        
-        if (response.empty()) {
-            return suggestions;
-        }
-
-        // Parse JSON array
-        std::vector<std::string> items = extractJSONArray(response, "");
-
-        for (const std::string& item : items) {
-            std::string word = extractJSONValue(item, "word");
-            std::string scoreStr = extractJSONValue(item, "score");
-            
-            if (!word.empty()) {
-                int score = scoreStr.empty() ? 100 : std::stoi(scoreStr);
-                suggestions.push_back(WordSuggestion(word, score));
-            }
-        }
-
-        return suggestions;
+        // Fetch and parse
+        return parseSuggestions(httpGet(url));
     }
 
     std::vector<WordSuggestion> fetchSpellingSuggestions(const std::string& word, int maxResults) {
-        std::vector<WordSuggestion> suggestions;
-
-        if (word.empty()) return suggestions;
+        if (word.empty()) return std::vector<WordSuggestion>();
 
         // Build URL (use spelling API endpoint)
         std::string url = "https://api.datamuse.com/words?sp=" + urlEncode(word) + 
                          "&max=" + std::to_string(maxResults);
 
-        // Fetch data
-        std::string response = httpGet(url);
-        
-        if (response.empty()) {
-            return suggestions;
-        }
-
-        // Parse JSON array
-        std::vector<std::string> items = extractJSONArray(response, "");
-
-        for (const std::string& item : items) {
-            std::string correctedWord = extractJSONValue(item, "word");
-            std::string scoreStr = extractJSONValue(item, "score");
-            
-            if (!correctedWord.empty()) {
-                int score = scoreStr.empty() ? 100 : std::stoi(scoreStr);
-                suggestions.push_back(WordSuggestion(correctedWord, score));
-            }
-        }
-
-        return suggestions;
+        // Fetch and parse
+        return parseSuggestions(httpGet(url));
     }
 
     // ==================== DICTIONARY API ====================
     
     DictionaryEntry fetchDefinition(const std::string& word) {
-        DictionaryEntry entry;
-        entry.word = word;
-
-        if (word.empty()) return entry;
+        if (word.empty()) return parseDefinition(word, "");
 
         // Build URL
         std::string url = "https://api.dictionaryapi.dev/api/v2/entries/en/" + urlEncode(word);
 
-        // Fetch data
-        std::string response = httpGet(url);
-        
-        if (response.empty() || response.find("\"title\":\"No Definitions Found\"") != std::string::npos) {
-            return entry;
-        }
-
-        entry.found = true;
-
-        // Extract phonetic
-        entry.phonetic = extractJSONValue(response, "phonetic");
-
-        // Extract audio URL
-        entry.audioUrl = extractJSONValue(response, "audio");
-
-        // Extract first definition
-        size_t defStart = response.find("\"definition\":");
-        if (defStart != std::string::npos) {
-            entry.definition = extractJSONValue(response.substr(defStart), "definition");
-        }
-
-        return entry;
+        // Fetch and parse
+        return parseDefinition(word, httpGet(url));
     }
 
     // ==================== ERROR HANDLING ====================
@@ -1,69 +1,53 @@
 #include "autocomplete.h"
 #include "trie.h"
 #include "hashtable.h"
-#include "priorityqueue.h"
-#include "sort.h"
+#include "spellchecker.h"
+#include "metrics.h"
+#include "tracing.h"
 #include <algorithm>
 
-AutocompleteEngine::AutocompleteEngine(Trie* t, HashTable* hm, int maxSugg)
-    : trie(t), frequencyMap(hm), maxSuggestions(maxSugg) {
+namespace {
+    Metrics::Histogram& trieStage = Metrics::stage("trie");
 }
 
-AutocompleteEngine::~AutocompleteEngine() {
-    // Don't delete trie and hashtable, they're managed externally
+AutocompleteEngine::AutocompleteEngine(Trie* t, HashTable* hm, int maxSugg)
+    : trie(t), frequencyMap(hm), sharedIndex(nullptr), maxSuggestions(maxSugg) {
 }
 
-void AutocompleteEngine::collectSuggestions(const std::string& prefix, 
-                                           std::vector<std::string>& results) {
-    if (!trie) return;
-    
-    // Use Trie's suggestWords method (correct API)
-    results = trie->suggestWords(prefix, maxSuggestions * 2); // Get more for ranking
+AutocompleteEngine::AutocompleteEngine(SpellChecker* index, int maxSugg)
+    : trie(index ? index->getTrie() : nullptr),
+      frequencyMap(index ? index->getFrequencyTable() : nullptr),
+      sharedIndex(index), maxSuggestions(maxSugg) {
 }
 
-std::vector<std::pair<std::string, int>> AutocompleteEngine::rankByFrequency(
-    const std::vector<std::string>& words) {
-    
-    std::vector<std::pair<std::string, int>> ranked;
-    
-    // Get frequency for each word
-    // Note: HashTable API doesn't have get() method, using default frequency
-    // Trie already maintains frequency information internally
-    for (const std::string& word : words) {
-        int freq = 1; // Default frequency
-        ranked.push_back({word, freq});
-    }
-
-    // Sort using custom QuickSort (by frequency descending, then lexicographic)
-    // Provide low and high indices as required
-    if (!ranked.empty()) {
-        SortAlgorithms::quickSortByFrequency(ranked, 0, ranked.size() - 1);
-    }
+AutocompleteEngine::~AutocompleteEngine() {
+    // Don't delete trie and hashtable, they're managed externally
+}
 
-    // Limit to maxSuggestions
-    if (ranked.size() > static_cast<size_t>(maxSuggestions)) {
-        ranked.resize(maxSuggestions);
-    }
+std::vector<std::pair<std::string, int>> AutocompleteEngine::collectSuggestions(
+    const std::string& prefix) {
+    if (!trie) return {};
+    Metrics::ScopedTimer timer(trieStage);
+    Tracing::Span span("trie");
 
-    return ranked;
+    // Frequencies come from the Trie nodes; already ranked by frequency
+    // (descending), then lexicographic
+    return trie->topKByFrequency(prefix, maxSuggestions);
 }
 
 std::vector<std::pair<std::string, int>> AutocompleteEngine::getSuggestions(
     const std::string& prefix) {
-    
-    std::vector<std::string> words;
-    collectSuggestions(prefix, words);
-
-    if (words.empty()) {
-        return {};
-    }
-
-    return rankByFrequency(words);
+    return collectSuggestions(prefix);
 }
 
 void AutocompleteEngine::addWord(const std::string& word, int frequency) {
     if (!trie || word.empty()) return;
 
+    if (sharedIndex) {
+        sharedIndex->addWord(word, frequency);
+        return;
+    }
+
     // Add to Trie (correct method name: insertWord)
     trie->insertWord(word, frequency);
 
@@ -0,0 +1,163 @@
+#include "batchprocessor.h"
+#include "spellchecker.h"
+#include "filehandler.h"
+#include "jsonwriter.h"
+#include "threadpool.h"
+#include "utils.h"
+#include <fstream>
+#include <iostream>
+#include <functional>
+#include <algorithm>
+
+namespace {
+    // Corrections per spell check, as in the interactive CLI
+    const int MAX_CORRECTIONS = 5;
+    const int CORRECTION_DISTANCE = 2;
+
+    // Slices per thread: evens out blocks with a few slow queries
+    const size_t SLICES_PER_THREAD = 4;
+}
+
+double BatchProcessor::Stats::queriesPerSecond() const {
+    if (elapsedMs <= 0.0) return 0.0;
+    return queries / (elapsedMs / 1000.0);
+}
+
+BatchProcessor::BatchProcessor(SpellChecker* spellChecker, int threads,
+                               int maxSuggestions, size_t queriesPerBlock)
+    : checker(spellChecker), pool(nullptr), ownsPool(false),
+      maxResults(maxSuggestions), blockSize(queriesPerBlock > 0 ? queriesPerBlock : 1) {
+
+    if (threads <= 0) {
+        pool = &ThreadPool::shared();
+    } else if (threads > 1) {
+        // The calling thread works too
+        pool = new ThreadPool(threads - 1);
+        ownsPool = true;
+    }
+    threadCount = pool != nullptr ? pool->getConcurrency() : 1;
+}
+
+BatchProcessor::~BatchProcessor() {
+    if (ownsPool) {
+        delete pool;
+    }
+}
+
+void BatchProcessor::answer(const std::string& query, Mode mode, std::string& out) const {
+    static const std::vector<std::string> DATA_STRUCTURES = {"Trie", "Priority Queue"};
+
+    Utils::Timer timer;
+    timer.start();
+
+    out.clear();
+    JSONWriter json(out, JSONWriter::SPACED);
+    json.beginObject();
+
+    if (mode == AUTOCOMPLETE) {
+        std::vector<std::string> suggestions = checker->autocompleteUncached(query, maxResults);
+        timer.stop();
+        FileHandler::appendAutocompleteFields(json, query, suggestions, timer.elapsedMilliseconds(),
+                                              false, DATA_STRUCTURES);
+    } else {
+        bool isCorrect = checker->checkSpelling(query);
+        std::vector<std::string> corrections;
+        if (!isCorrect) {
+            corrections = checker->getCorrectionsUncached(query, CORRECTION_DISTANCE, MAX_CORRECTIONS);
+        }
+        timer.stop();
+        FileHandler::appendSpellCheckFields(json, query, isCorrect, corrections, timer.elapsedMilliseconds());
+    }
+
+    json.endObject();
+}
+
+void BatchProcessor::answerBlock(const std::vector<std::string>& queries, Mode mode,
+                                 std::vector<std::string>& results) {
+    results.resize(queries.size());
+
+    if (pool == nullptr || queries.size() == 1) {
+        for (size_t i = 0; i < queries.size(); i++) {
+            answer(queries[i], mode, results[i]);
+        }
+        return;
+    }
+
+    // Contiguous slices; each task writes only its own result slots
+    size_t slices = std::min(queries.size(), static_cast<size_t>(threadCount) * SLICES_PER_THREAD);
+    size_t sliceSize = (queries.size() + slices - 1) / slices;
+
+    std::vector<std::function<void()>> tasks;
+    for (size_t start = 0; start < queries.size(); start += sliceSize) {
+        size_t end = std::min(queries.size(), start + sliceSize);
+        tasks.push_back([this, &queries, &results, mode, start, end]() {
+            for (size_t i = start; i < end; i++) {
+                answer(queries[i], mode, results[i]);
+            }
+        });
+    }
+    pool->runAll(tasks);
+}
+
+BatchProcessor::Stats BatchProcessor::processStream(std::istream& input, std::ostream& output, Mode mode) {
+    Stats stats;
+    stats.threads = threadCount;
+
+    Utils::Timer timer;
+    timer.start();
+
+    std::vector<std::string> queries;
+    std::vector<std::string> results;
+    queries.reserve(blockSize);
+
+    std::string line;
+    bool more = true;
+    while (more) {
+        queries.clear();
+        while (queries.size() < blockSize && (more = static_cast<bool>(std::getline(input, line)))) {
+            std::string query = Utils::trim(line);
+            if (!query.empty()) {
+                queries.push_back(query);
+            }
+        }
+        if (queries.empty()) break;
+
+        answerBlock(queries, mode, results);
+
+        for (const std::string& result : results) {
+            output << result << '\n';
+        }
+        stats.queries += queries.size();
+    }
+    output.flush();
+
+    timer.stop();
+    stats.elapsedMs = timer.elapsedMilliseconds();
+    return stats;
+}
+
+BatchProcessor::Stats BatchProcessor::processFile(const std::string& filename, std::ostream& output, Mode mode) {
+    if (filename == "-") {
+        return processStream(std::cin, output, mode);
+    }
+
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        Utils::logError("Cannot open query file: " + filename);
+        return Stats();
+    }
+
+    return processStream(file, output, mode);
+}
+
+bool BatchProcessor::parseMode(const std::string& name, Mode& mode) {
+    if (name == "autocomplete") {
+        mode = AUTOCOMPLETE;
+        return true;
+    }
+    if (name == "spellcheck") {
+        mode = SPELLCHECK;
+        return true;
+    }
+    return false;
+}
@@ -1,6 +1,12 @@
 #include "bktree.h"
+#include "utils.h"
 #include <algorithm>
 
+namespace {
+    // A std::map node: color, parent, left, right, then the entry
+    const size_t MAP_NODE_BYTES = 4 * sizeof(void*) + sizeof(std::pair<const int, BKNode*>);
+}
+
 // ==================== BKNode Implementation ====================
 
 BKNode::~BKNode() {
@@ -11,7 +17,7 @@ BKNode::~BKNode() {
 
 // ==================== BKTree Implementation ====================
 
-BKTree::BKTree() : root(nullptr) {
+BKTree::BKTree() : root(nullptr), memoryBytes(0) {
 }
 
 BKTree::~BKTree() {
@@ -19,12 +25,7 @@ BKTree::~BKTree() {
 }
 
 void BKTree::destroyTree(BKNode* node) {
-    if (node == nullptr) return;
-    
-    for (auto& pair : node->children) {
-        destroyTree(pair.second);
-    }
-    
+    // BKNode's destructor releases the whole subtree
     delete node;
 }
 
@@ -33,6 +34,7 @@ void BKTree::insert(const std::string& word) {
     
     if (root == nullptr) {
         root = new BKNode(word);
+        memoryBytes += sizeof(BKNode) + Utils::stringHeapBytes(root->word);
         return;
     }
     
@@ -42,20 +44,43 @@ void BKTree::insert(const std::string& word) {
 void BKTree::insertHelper(BKNode* node, const std::string& word) {
     int distance = EditDistance::calculate(node->word, word);
     
-    // If distance is 0, word already exists
+    // If distance is 0, word already exists (or was removed: revive it)
     if (distance == 0) {
+        node->deleted = false;
         return;
     }
     
     // If child with this distance doesn't exist, create it
     if (node->children.find(distance) == node->children.end()) {
-        node->children[distance] = new BKNode(word);
+        BKNode* child = new BKNode(word);
+        node->children[distance] = child;
+        memoryBytes += sizeof(BKNode) + Utils::stringHeapBytes(child->word) + MAP_NODE_BYTES;
     } else {
         // Recursively insert into the appropriate subtree
         insertHelper(node->children[distance], word);
     }
 }
 
+bool BKTree::remove(const std::string& word) {
+    BKNode* current = root;
+    
+    // Only one path can hold the word: follow the child at its distance
+    while (current != nullptr) {
+        int distance = EditDistance::calculate(current->word, word);
+        
+        if (distance == 0) {
+            bool wasPresent = !current->deleted;
+            current->deleted = true;
+            return wasPresent;
+        }
+        
+        auto child = current->children.find(distance);
+        current = child == current->children.end() ? nullptr : child->second;
+    }
+    
+    return false;
+}
+
 std::vector<std::pair<std::string, int>> BKTree::searchByDistance(
     const std::string& word, int maxDistance) {
     
@@ -81,7 +106,7 @@ void BKTree::searchHelper(BKNode* node, const std::string& word, int maxDistance
     int distance = EditDistance::calculate(node->word, word);
     
     // If within maxDistance, add to results
-    if (distance <= maxDistance) {
+    if (distance <= maxDistance && !node->deleted) {
         results.push_back({node->word, distance});
     }
     
@@ -131,7 +156,7 @@ int BKTree::size() {
 int BKTree::countNodes(BKNode* node) {
     if (node == nullptr) return 0;
     
-    int count = 1;
+    int count = node->deleted ? 0 : 1;
     for (auto& pair : node->children) {
         count += countNodes(pair.second);
     }
@@ -139,7 +164,12 @@ int BKTree::countNodes(BKNode* node) {
     return count;
 }
 
+size_t BKTree::getMemoryBytes() const {
+    return sizeof(BKTree) + memoryBytes;
+}
+
 void BKTree::clear() {
     destroyTree(root);
     root = nullptr;
+    memoryBytes = 0;
 }
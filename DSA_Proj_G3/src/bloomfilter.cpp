@@ -6,50 +6,79 @@ BloomFilter::BloomFilter(int size, int numHashFunctions)
     bitArray.resize(size, false);
 }
 
-int BloomFilter::hash1(const std::string& word) {
-    // Simple polynomial rolling hash
-    unsigned long hash = 0;
-    int prime = 31;
-    
-    for (char ch : word) {
-        hash = (hash * prime + tolower(ch)) % size;
+// The hash functions are templated on case folding so that pre-normalized
+// input (containsNormalized) hashes to the same bits without tolower()
+namespace {
+    template<bool FoldCase>
+    inline int fold(char ch) {
+        return FoldCase ? tolower(ch) : ch;
     }
-    
-    return hash;
+
+    template<bool FoldCase>
+    int polynomialHash(std::string_view word, int size) {
+        // Simple polynomial rolling hash
+        unsigned long hash = 0;
+        int prime = 31;
+        
+        for (char ch : word) {
+            hash = (hash * prime + fold<FoldCase>(ch)) % size;
+        }
+        
+        return hash;
+    }
+
+    template<bool FoldCase>
+    int djb2Hash(std::string_view word, int size) {
+        // DJB2 hash algorithm
+        unsigned long hash = 5381;
+        
+        for (char ch : word) {
+            hash = ((hash << 5) + hash) + fold<FoldCase>(ch);
+        }
+        
+        return hash % size;
+    }
+
+    template<bool FoldCase>
+    int sdbmHash(std::string_view word, int size) {
+        // SDBM hash algorithm
+        unsigned long hash = 0;
+        
+        for (char ch : word) {
+            hash = fold<FoldCase>(ch) + (hash << 6) + (hash << 16) - hash;
+        }
+        
+        return hash % size;
+    }
+
+    template<bool FoldCase>
+    int fnvHash(std::string_view word, int size) {
+        // Modified FNV-1a hash
+        unsigned long hash = 2166136261u;
+        
+        for (char ch : word) {
+            hash ^= fold<FoldCase>(ch);
+            hash *= 16777619;
+        }
+        
+        return hash % size;
+    }
+}
+
+int BloomFilter::hash1(const std::string& word) {
+    return polynomialHash<true>(word, size);
 }
 
 int BloomFilter::hash2(const std::string& word) {
-    // DJB2 hash algorithm
-    unsigned long hash = 5381;
-    
-    for (char ch : word) {
-        hash = ((hash << 5) + hash) + tolower(ch);
-    }
-    
-    return hash % size;
+    return djb2Hash<true>(word, size);
 }
 
 int BloomFilter::hash3(const std::string& word) {
-    // SDBM hash algorithm
-    unsigned long hash = 0;
-    
-    for (char ch : word) {
-        hash = tolower(ch) + (hash << 6) + (hash << 16) - hash;
-    }
-    
-    return hash % size;
+    return sdbmHash<true>(word, size);
 }
 
 int BloomFilter::hash4(const std::string& word) {
-    // Modified FNV-1a hash
-    unsigned long hash = 2166136261u;
-    
-    for (char ch : word) {
-        hash ^= tolower(ch);
-        hash *= 16777619;
-    }
-    
-    return hash % size;
+    return fnvHash<true>(word, size);
 }
 
 std::vector<int> BloomFilter::getHashIndices(const std::string& word) {
@@ -89,6 +118,23 @@ bool BloomFilter::containsWord(const std::string& word) {
     return true;  // Might be present (could be false positive)
 }
 
+bool BloomFilter::containsNormalized(std::string_view word) const {
+    if (word.empty()) return false;
+    
+    // Cheapest hashes first; stop at the first unset bit
+    if (numHashFunctions >= 1 && !bitArray[polynomialHash<false>(word, size)]) return false;
+    if (numHashFunctions >= 2 && !bitArray[djb2Hash<false>(word, size)]) return false;
+    if (numHashFunctions >= 3 && !bitArray[sdbmHash<false>(word, size)]) return false;
+    if (numHashFunctions >= 4 && !bitArray[fnvHash<false>(word, size)]) return false;
+    
+    return true;  // Might be present (could be false positive)
+}
+
+size_t BloomFilter::getMemoryBytes() const {
+    const size_t WORD_BITS = 8 * sizeof(unsigned long);
+    return sizeof(BloomFilter) + (bitArray.capacity() + WORD_BITS - 1) / WORD_BITS * sizeof(unsigned long);
+}
+
 double BloomFilter::getFalsePositiveRate() {
     if (elementCount == 0) return 0.0;
     
@@ -0,0 +1,27 @@
+#include "decayedscore.h"
+#include <chrono>
+#include <cmath>
+
+double DecayedScore::valueAt(uint32_t now, double halfLifeSeconds) const {
+    if (value == 0.0f) return 0.0;
+
+    // Clock stepped back (or a replayed future stamp): no decay
+    if (now <= stamp || halfLifeSeconds <= 0.0) return value;
+
+    return value * std::exp2(-static_cast<double>(now - stamp) / halfLifeSeconds);
+}
+
+void DecayedScore::add(double amount, uint32_t now, double halfLifeSeconds) {
+    value = static_cast<float>(valueAt(now, halfLifeSeconds) + amount);
+    if (now > stamp) stamp = now;
+}
+
+void DecayedScore::merge(const DecayedScore& other, double halfLifeSeconds) {
+    uint32_t latest = other.stamp > stamp ? other.stamp : stamp;
+    add(other.valueAt(latest, halfLifeSeconds), latest, halfLifeSeconds);
+}
+
+uint32_t DecayedScore::nowSeconds() {
+    auto sinceEpoch = std::chrono::system_clock::now().time_since_epoch();
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::seconds>(sinceEpoch).count());
+}
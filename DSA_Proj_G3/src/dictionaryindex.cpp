@@ -0,0 +1,152 @@
+#include "dictionaryindex.h"
+#include "utils.h"
+#include <chrono>
+
+namespace {
+    // How often the reload thread checks for a request made by a signal
+    // handler (which cannot notify a condition variable)
+    const int SIGNAL_POLL_MS = 200;
+}
+
+// ==================== DictionaryIndex ====================
+
+DictionaryIndex::DictionaryIndex(SpellChecker* spellCheck, const std::string& sourceName, int maxSuggestions)
+    : spellchecker(spellCheck), source(sourceName) {
+    engine = new AutocompleteEngine(spellchecker, maxSuggestions);
+    wordCount = engine->getWordCount();
+}
+
+DictionaryIndex::~DictionaryIndex() {
+    // The engine reads the spell checker's structures: delete it first
+    delete engine;
+    delete spellchecker;
+}
+
+std::shared_ptr<DictionaryIndex> DictionaryIndex::load(const std::string& filename, FrequencyLog* learned) {
+    SpellChecker* spellchecker = new SpellChecker();
+
+    if (spellchecker->loadDictionary(filename) == 0) {
+        delete spellchecker;
+        return nullptr;
+    }
+
+    // What users taught the previous index carries over
+    if (learned != nullptr) {
+        spellchecker->applyLearnedFrequencies(*learned);
+        spellchecker->setFrequencyLog(learned);
+    }
+
+    return std::make_shared<DictionaryIndex>(spellchecker, filename);
+}
+
+SpellChecker::DeltaStats DictionaryIndex::applyDelta(const char* data, size_t size) {
+    SpellChecker::DeltaStats stats = spellchecker->applyDelta(data, size);
+    wordCount += stats.added - stats.removed;
+    return stats;
+}
+
+// ==================== DictionaryManager ====================
+
+DictionaryManager::DictionaryManager(const std::string& dictionaryFile, FrequencyLog* learned)
+    : DictionaryManager(nullptr, dictionaryFile, learned) {
+}
+
+DictionaryManager::DictionaryManager(std::shared_ptr<DictionaryIndex> index, const std::string& dictionaryFile,
+                                     FrequencyLog* learned)
+    : filename(dictionaryFile), frequencyLog(learned), current(index), reloadPending(false), stopping(false) {
+    stats.generation = index ? 1 : 0;
+    stats.reloads = 0;
+    stats.failedReloads = 0;
+    stats.lastReloadMs = 0.0;
+    stats.reloading = false;
+
+    if (!filename.empty()) {
+        reloader = std::thread(&DictionaryManager::reloadLoop, this);
+    }
+}
+
+DictionaryManager::~DictionaryManager() {
+    {
+        std::lock_guard<std::mutex> lock(reloadMutex);
+        stopping = true;
+    }
+    reloadWake.notify_all();
+
+    if (reloader.joinable()) {
+        reloader.join();
+    }
+}
+
+std::shared_ptr<DictionaryIndex> DictionaryManager::acquire() const {
+    return std::atomic_load(&current);
+}
+
+bool DictionaryManager::reload() {
+    if (filename.empty()) return false;
+
+    std::lock_guard<std::mutex> build(buildMutex);
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.reloading = true;
+    }
+
+    // Build next to the serving index; nothing is shared with it
+    Utils::Timer timer;
+    timer.start();
+    std::shared_ptr<DictionaryIndex> fresh = DictionaryIndex::load(filename, frequencyLog);
+    double elapsedMs = timer.elapsedMilliseconds();
+
+    // Declared before the lock: if this is the last snapshot, the old index
+    // is destroyed after statsMutex is released
+    std::shared_ptr<DictionaryIndex> previous;
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats.reloading = false;
+
+    if (!fresh) {
+        stats.failedReloads++;
+        Utils::logError("Dictionary reload failed, still serving generation " +
+                        std::to_string(stats.generation));
+        return false;
+    }
+
+    // Publish. The previous index is released on return, or later by the
+    // last query still holding a snapshot of it
+    previous = std::atomic_exchange(&current, fresh);
+
+    stats.generation++;
+    if (stats.generation > 1) {
+        stats.reloads++;
+    }
+    stats.lastReloadMs = elapsedMs;
+    Utils::logInfo("Dictionary generation " + std::to_string(stats.generation) + " published: " +
+                   Utils::formatNumber(fresh->getWordCount()) + " words in " +
+                   Utils::formatDouble(elapsedMs, 1) + " ms");
+    return true;
+}
+
+void DictionaryManager::requestReload() {
+    reloadPending = true;
+
+    // No notify here: not allowed from a signal handler. The reload
+    // thread polls the flag.
+}
+
+void DictionaryManager::reloadLoop() {
+    std::unique_lock<std::mutex> lock(reloadMutex);
+
+    while (!stopping) {
+        reloadWake.wait_for(lock, std::chrono::milliseconds(SIGNAL_POLL_MS));
+        if (stopping) break;
+
+        if (reloadPending.exchange(false)) {
+            lock.unlock();
+            reload();
+            lock.lock();
+        }
+    }
+}
+
+DictionaryManager::Stats DictionaryManager::getStats() const {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return stats;
+}
@@ -0,0 +1,242 @@
+#include "documentchecker.h"
+#include "spellchecker.h"
+#include "jsonwriter.h"
+#include "utils.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <cstring>
+
+namespace {
+    // Tokens shorter than this are not checked (single letters, initials)
+    const size_t MIN_TOKEN_LENGTH = 2;
+
+    // Runs longer than this are not words (base64, hashes, minified data)
+    const size_t MAX_TOKEN_LENGTH = 64;
+}
+
+DocumentChecker::DocumentChecker(SpellChecker* spellChecker, size_t chunkSize,
+                                 size_t windowSize, size_t batchSize)
+    : checker(spellChecker),
+      chunkSize(chunkSize > 0 ? chunkSize : 64 * 1024),
+      windowSize(windowSize > 0 ? windowSize : 1),
+      batchSize(batchSize > 0 ? batchSize : 1),
+      maxDistance(2), maxCorrections(5), skippingRun(false) {
+}
+
+void DocumentChecker::setCorrectionLimits(int distance, int results) {
+    maxDistance = distance;
+    maxCorrections = results;
+}
+
+double DocumentChecker::Stats::throughputMBps() const {
+    if (elapsedMs <= 0.0) return 0.0;
+    return (bytesProcessed / (1024.0 * 1024.0)) / (elapsedMs / 1000.0);
+}
+
+size_t DocumentChecker::tokenizeChunk(const char* data, size_t length, size_t baseOffset,
+                                      bool isLast, Stats& stats,
+                                      const MisspellingCallback& onMisspelling) {
+    Tokenizer::tokenize(data, length, normalized, tokens);
+    size_t consumed = length;
+
+    // An over-long run from the previous chunk continues at offset 0
+    bool skipFirst = skippingRun && !tokens.empty() && tokens[0].offset == 0;
+    skippingRun = false;
+
+    for (size_t t = 0; t < tokens.size(); t++) {
+        const Tokenizer::Token& token = tokens[t];
+        size_t runLength = token.text.length();
+        bool atEnd = token.offset + runLength == length;
+
+        if (t == 0 && skipFirst) {
+            if (atEnd && !isLast) skippingRun = true;
+            continue;
+        }
+
+        if (atEnd && !isLast) {
+            // The run may continue in the next chunk
+            if (runLength <= MAX_TOKEN_LENGTH) {
+                consumed = token.offset;
+            } else {
+                skippingRun = true;
+            }
+            break;
+        }
+
+        if (token.lettersOnly && runLength >= MIN_TOKEN_LENGTH && runLength <= MAX_TOKEN_LENGTH) {
+            addToken(data + token.offset, token.text, baseOffset + token.offset,
+                     stats, onMisspelling);
+        }
+    }
+
+    // Occurrences point into this chunk: resolve them before it is reused
+    flush(stats, onMisspelling);
+
+    return consumed;
+}
+
+void DocumentChecker::addToken(const char* original, std::string_view normalizedToken,
+                               size_t offset, Stats& stats,
+                               const MisspellingCallback& onMisspelling) {
+    stats.tokensChecked++;
+
+    // First sighting in this window: schedule a lookup
+    lookupKey.assign(normalizedToken.data(), normalizedToken.length());
+    auto inserted = window.emplace(lookupKey, Verdict());
+    if (inserted.second) {
+        windowOrder.push_back(inserted.first->first);
+        batchKeys.push_back(inserted.first->first);
+        batchVerdicts.push_back(&inserted.first->second);
+    }
+
+    Occurrence occurrence;
+    occurrence.offset = offset;
+    occurrence.text = original;
+    occurrence.length = normalizedToken.length();
+    occurrence.verdict = &inserted.first->second;
+    pending.push_back(occurrence);
+
+    if (batchKeys.size() >= batchSize || pending.size() >= batchSize * 8) {
+        flush(stats, onMisspelling);
+    }
+}
+
+void DocumentChecker::flush(Stats& stats, const MisspellingCallback& onMisspelling) {
+    if (!batchKeys.empty()) {
+        std::vector<bool> results;
+        checker->checkSpellingBatchNormalized(batchKeys, results);
+        stats.uniqueLookups += batchKeys.size();
+
+        for (size_t i = 0; i < batchKeys.size(); i++) {
+            Verdict& verdict = *batchVerdicts[i];
+            verdict.correct = results[i];
+            if (!verdict.correct) {
+                verdict.corrections = checker->getCorrections(std::string(batchKeys[i]),
+                                                              maxDistance, maxCorrections);
+            }
+        }
+    }
+
+    // Emit in document order
+    for (const Occurrence& occurrence : pending) {
+        if (occurrence.verdict->correct) continue;
+
+        stats.misspellings++;
+        if (onMisspelling) {
+            Misspelling misspelling;
+            misspelling.offset = occurrence.offset;
+            misspelling.word.assign(occurrence.text, occurrence.length);
+            misspelling.corrections = occurrence.verdict->corrections;
+            onMisspelling(misspelling);
+        }
+    }
+
+    pending.clear();
+    batchKeys.clear();
+    batchVerdicts.clear();
+
+    // Slide the dedup window: forget the oldest tokens. Nothing pending
+    // points into the window any more, and map nodes do not move, so
+    // the views in windowOrder stay valid until their entry is erased.
+    while (window.size() > windowSize) {
+        lookupKey.assign(windowOrder.front().data(), windowOrder.front().length());
+        windowOrder.pop_front();
+        window.erase(lookupKey);
+    }
+}
+
+DocumentChecker::Stats DocumentChecker::checkStream(std::istream& input,
+                                                    const MisspellingCallback& onMisspelling) {
+    Stats stats;
+    window.clear();
+    windowOrder.clear();
+    pending.clear();
+    batchKeys.clear();
+    batchVerdicts.clear();
+    skippingRun = false;
+
+    Utils::Timer timer;
+    timer.start();
+
+    // Room for one chunk plus a carried-over partial token
+    std::vector<char> buffer(chunkSize + MAX_TOKEN_LENGTH + 1);
+    size_t carry = 0;
+    size_t baseOffset = 0;
+
+    while (true) {
+        input.read(buffer.data() + carry, chunkSize);
+        size_t bytesRead = static_cast<size_t>(input.gcount());
+        bool isLast = bytesRead < chunkSize;
+
+        stats.bytesProcessed += bytesRead;
+        size_t length = carry + bytesRead;
+
+        size_t consumed = tokenizeChunk(buffer.data(), length, baseOffset,
+                                        isLast, stats, onMisspelling);
+
+        carry = length - consumed;
+        if (carry > 0) {
+            std::memmove(buffer.data(), buffer.data() + consumed, carry);
+        }
+        baseOffset += consumed;
+
+        if (isLast) break;
+    }
+
+    flush(stats, onMisspelling);
+
+    timer.stop();
+    stats.elapsedMs = timer.elapsedMilliseconds();
+    return stats;
+}
+
+DocumentChecker::Stats DocumentChecker::checkFile(const std::string& filename,
+                                                  const MisspellingCallback& onMisspelling) {
+    if (filename == "-") {
+        return checkStream(std::cin, onMisspelling);
+    }
+
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        Utils::logError("Cannot open document: " + filename);
+        return Stats();
+    }
+
+    return checkStream(file, onMisspelling);
+}
+
+DocumentChecker::Stats DocumentChecker::checkText(const std::string& text,
+                                                  const MisspellingCallback& onMisspelling) {
+    std::istringstream stream(text);
+    return checkStream(stream, onMisspelling);
+}
+
+std::string DocumentChecker::misspellingToJSON(const Misspelling& misspelling) {
+    std::string out;
+    appendMisspellingJSON(out, misspelling);
+    return out;
+}
+
+void DocumentChecker::appendMisspellingJSON(std::string& buffer, const Misspelling& misspelling) {
+    JSONWriter json(buffer, JSONWriter::SPACED);
+    json.beginObject();
+    json.field("offset", misspelling.offset);
+    json.field("word", misspelling.word);
+    json.key("corrections").stringArray(misspelling.corrections);
+    json.endObject();
+}
+
+std::string DocumentChecker::statsToJSON(const Stats& stats) {
+    std::string out;
+    JSONWriter json(out, JSONWriter::SPACED);
+    json.beginObject();
+    json.field("bytes", stats.bytesProcessed);
+    json.field("tokens", stats.tokensChecked);
+    json.field("uniqueLookups", stats.uniqueLookups);
+    json.field("misspellings", stats.misspellings);
+    json.key("timeTaken").fixed(stats.elapsedMs, 3);
+    json.key("throughputMBps").fixed(stats.throughputMBps(), 2);
+    json.endObject();
+    return out;
+}
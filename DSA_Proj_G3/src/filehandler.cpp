@@ -1,53 +1,297 @@
 #include "filehandler.h"
+#include "threadpool.h"
+#include "utils.h"
+#include "jsonwriter.h"
 #include <fstream>
 #include <sstream>
+#include <cstring>
+#include <climits>
 #include <sys/stat.h>
+#ifdef _WIN32
 #include <direct.h>  // For _mkdir on Windows
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// ==================== MappedFile ====================
+
+MappedFile::MappedFile() : bytes(nullptr), length(0) {
+#ifndef _WIN32
+    mapped = false;
+#endif
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& filename) {
+    close();
+
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::ostringstream content;
+    content << file.rdbuf();
+    buffer = content.str();
+    bytes = buffer.data();
+    length = buffer.size();
+    return true;
+}
+
+void MappedFile::close() {
+    buffer.clear();
+    buffer.shrink_to_fit();
+    bytes = nullptr;
+    length = 0;
+}
+
+#else
+
+bool MappedFile::open(const std::string& filename) {
+    close();
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    // mmap rejects zero-length mappings; an empty file is still "open"
+    if (info.st_size > 0) {
+        void* address = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+
+        // One forward pass over the whole file follows
+        madvise(address, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+
+        bytes = static_cast<const char*>(address);
+        length = static_cast<size_t>(info.st_size);
+        mapped = true;
+    }
+
+    // The mapping keeps its own reference to the file
+    ::close(fd);
+    return true;
+}
+
+void MappedFile::close() {
+    if (mapped) {
+        munmap(const_cast<char*>(bytes), length);
+        mapped = false;
+    }
+    bytes = nullptr;
+    length = 0;
+}
+
+#endif
+
+// ==================== Dictionary Parsing ====================
+
+// Call onLine(begin, end) for each line of [data, data + size), found with
+// memchr; the newline and a trailing '\r' are not part of the line
+template <typename LineFn>
+static void forEachLine(const char* data, size_t size, LineFn onLine) {
+    const char* cursor = data;
+    const char* end = data + size;
+
+    while (cursor < end) {
+        const char* newline = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+        const char* lineEnd = newline ? newline : end;
+        if (lineEnd > cursor && lineEnd[-1] == '\r') lineEnd--;
+
+        onLine(cursor, lineEnd);
+        cursor = newline ? newline + 1 : end;
+    }
+}
+
+// Outcome of parsing one line
+enum class LineKind { Empty, Entry, Malformed };
+
+// Parse one dictionary line ("word" or "word frequency") in place
+// Phrases contain spaces, so the frequency is the last field
+static LineKind parseDictionaryLine(const char* begin, const char* end,
+                                    std::string_view& word, int& frequency) {
+    if (begin == end) return LineKind::Empty;
+
+    const char* space = end;
+    while (space > begin && space[-1] != ' ') space--;
+
+    if (space == begin) {
+        // No frequency specified, default to 1
+        word = std::string_view(begin, end - begin);
+        frequency = 1;
+        return LineKind::Entry;
+    }
+
+    // Frequency field: optional '-', then digits only, must fit an int
+    const char* digit = space;
+    bool negative = digit < end && *digit == '-';
+    if (negative) digit++;
+    if (digit == end) return LineKind::Malformed;
+
+    long long value = 0;
+    for (; digit < end; digit++) {
+        if (*digit < '0' || *digit > '9') return LineKind::Malformed;
+        value = value * 10 + (*digit - '0');
+        if (value > static_cast<long long>(INT_MAX) + 1) return LineKind::Malformed;
+    }
+    if (negative) value = -value;
+    if (value > INT_MAX || value < INT_MIN) return LineKind::Malformed;
+
+    if (space - 1 == begin) return LineKind::Malformed;  // " 42": no word
+    word = std::string_view(begin, space - 1 - begin);
+    frequency = static_cast<int>(value);
+    return LineKind::Entry;
+}
+
+int FileHandler::scanDictionary(const char* data, size_t size, const DictionaryCallback& onEntry) {
+    int skipped = 0;
+
+    forEachLine(data, size, [&onEntry, &skipped](const char* begin, const char* end) {
+        std::string_view word;
+        int frequency = 0;
+        LineKind kind = parseDictionaryLine(begin, end, word, frequency);
+        if (kind == LineKind::Entry) {
+            onEntry(word, frequency);
+        } else if (kind == LineKind::Malformed) {
+            skipped++;
+        }
+    });
+
+    return skipped;
+}
+
+std::vector<std::pair<std::string_view, int>> FileHandler::scanDictionaryParallel(
+    const MappedFile& file, ThreadPool& pool, int& skipped) {
+    const char* data = file.data();
+    size_t size = file.size();
+    skipped = 0;
+
+    // Chunk boundaries moved forward to the next line start; a few chunks
+    // per thread even out uneven line lengths
+    size_t chunkCount = static_cast<size_t>(pool.getConcurrency()) * 4;
+    std::vector<size_t> bounds(1, 0);
+    for (size_t c = 1; c < chunkCount && size > 0; c++) {
+        size_t cut = size * c / chunkCount;
+        if (cut < bounds.back()) continue;
+        const void* newline = std::memchr(data + cut, '\n', size - cut);
+        if (newline == nullptr) break;
+        bounds.push_back(static_cast<const char*>(newline) - data + 1);
+    }
+    bounds.push_back(size);
+
+    size_t chunks = bounds.size() - 1;
+    std::vector<std::vector<std::pair<std::string_view, int>>> parsed(chunks);
+    std::vector<int> skippedPerChunk(chunks, 0);
+    std::vector<std::function<void()>> tasks;
+
+    for (size_t c = 0; c < chunks; c++) {
+        tasks.push_back([&, c]() {
+            auto& entries = parsed[c];
+            skippedPerChunk[c] = scanDictionary(data + bounds[c], bounds[c + 1] - bounds[c],
+                [&entries](std::string_view word, int frequency) {
+                    entries.push_back({word, frequency});
+                });
+        });
+    }
+    pool.runAll(tasks);
+
+    // Concatenate in file order
+    size_t total = 0;
+    for (size_t c = 0; c < chunks; c++) {
+        total += parsed[c].size();
+        skipped += skippedPerChunk[c];
+    }
+
+    std::vector<std::pair<std::string_view, int>> entries;
+    entries.reserve(total);
+    for (const auto& chunk : parsed) {
+        entries.insert(entries.end(), chunk.begin(), chunk.end());
+    }
+    return entries;
+}
+
+int FileHandler::scanDelta(const char* data, size_t size, const DeltaCallback& onChange) {
+    int skipped = 0;
+
+    forEachLine(data, size, [&onChange, &skipped](const char* cursor, const char* lineEnd) {
+        if (cursor == lineEnd || *cursor == '#') return;
+
+        // Operation, then the rest of the line as a dictionary entry
+        const char* space = static_cast<const char*>(std::memchr(cursor, ' ', lineEnd - cursor));
+        std::string_view op(cursor, (space ? space : lineEnd) - cursor);
+        const char* rest = space ? space + 1 : lineEnd;
+
+        std::string_view word;
+        int frequency = 0;
+        bool valid = false;
+
+        if (op == "add") {
+            valid = parseDictionaryLine(rest, lineEnd, word, frequency) == LineKind::Entry;
+            if (valid) onChange(DeltaOp::Add, word, frequency);
+        } else if (op == "set") {
+            // The frequency is required here
+            valid = std::memchr(rest, ' ', lineEnd - rest) != nullptr &&
+                    parseDictionaryLine(rest, lineEnd, word, frequency) == LineKind::Entry;
+            if (valid) onChange(DeltaOp::SetFrequency, word, frequency);
+        } else if (op == "remove") {
+            valid = rest < lineEnd;
+            if (valid) onChange(DeltaOp::Remove, std::string_view(rest, lineEnd - rest), 0);
+        }
+
+        if (!valid) skipped++;
+    });
+
+    return skipped;
+}
 
 std::vector<std::pair<std::string, int>> FileHandler::readDictionary(const std::string& filename) {
     std::vector<std::pair<std::string, int>> words;
-    std::ifstream file(filename);
-    
-    if (!file.is_open()) {
+    MappedFile file;
+
+    if (!file.open(filename)) {
         return words;  // Return empty vector if file can't be opened
     }
-    
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.empty()) continue;
-        
-        // Check if line contains frequency (word frequency_count)
-        size_t spacePos = line.find(' ');
-        if (spacePos != std::string::npos) {
-            std::string word = line.substr(0, spacePos);
-            int frequency = std::stoi(line.substr(spacePos + 1));
-            words.push_back({word, frequency});
-        } else {
-            // No frequency specified, default to 1
-            words.push_back({line, 1});
-        }
+
+    int skipped = scanDictionary(file.data(), file.size(), [&words](std::string_view word, int frequency) {
+        words.push_back({std::string(word), frequency});
+    });
+    if (skipped > 0) {
+        Utils::logWarning("Skipped " + std::to_string(skipped) + " malformed line(s) in " + filename);
     }
-    
-    file.close();
+
     return words;
 }
 
 std::vector<std::string> FileHandler::readWordList(const std::string& filename) {
     std::vector<std::string> words;
-    std::ifstream file(filename);
-    
-    if (!file.is_open()) {
+    MappedFile file;
+
+    if (!file.open(filename)) {
         return words;
     }
-    
-    std::string line;
-    while (std::getline(file, line)) {
-        if (!line.empty()) {
-            words.push_back(line);
+
+    forEachLine(file.data(), file.size(), [&words](const char* begin, const char* end) {
+        if (end > begin) {
+            words.emplace_back(begin, end - begin);
         }
-    }
-    
-    file.close();
+    });
+
     return words;
 }
 
@@ -73,18 +317,7 @@ void FileHandler::writeAutocompleteOutput(
     bool cacheHit,
     const std::vector<std::string>& dsUsed) {
     
-    std::stringstream json;
-    json << "{\n";
-    json << "  \"type\": \"autocomplete\",\n";
-    json << "  \"query\": \"" << escapeJSON(query) << "\",\n";
-    json << "  \"suggestions\": " << vectorToJSON(suggestions) << ",\n";
-    json << "  \"count\": " << suggestions.size() << ",\n";
-    json << "  \"timeTaken\": " << timeTaken << ",\n";
-    json << "  \"cacheHit\": " << (cacheHit ? "true" : "false") << ",\n";
-    json << "  \"dataStructuresUsed\": " << vectorToJSON(dsUsed) << "\n";
-    json << "}";
-    
-    writeJSON(filename, json.str());
+    writeJSON(filename, autocompleteOutputToJSON(query, suggestions, timeTaken, cacheHit, dsUsed));
 }
 
 void FileHandler::writeSpellCheckOutput(
@@ -94,16 +327,67 @@ void FileHandler::writeSpellCheckOutput(
     const std::vector<std::string>& corrections,
     double timeTaken) {
     
-    std::stringstream json;
-    json << "{\n";
-    json << "  \"type\": \"spellcheck\",\n";
-    json << "  \"query\": \"" << escapeJSON(query) << "\",\n";
-    json << "  \"isCorrect\": " << (isCorrect ? "true" : "false") << ",\n";
-    json << "  \"corrections\": " << vectorToJSON(corrections) << ",\n";
-    json << "  \"timeTaken\": " << timeTaken << "\n";
-    json << "}";
+    writeJSON(filename, spellCheckOutputToJSON(query, isCorrect, corrections, timeTaken));
+}
+
+std::string FileHandler::autocompleteOutputToJSON(
+    const std::string& query,
+    const std::vector<std::string>& suggestions,
+    double timeTaken,
+    bool cacheHit,
+    const std::vector<std::string>& dsUsed) {
+    
+    std::string out;
+    JSONWriter json(out, JSONWriter::SPACED);
+    json.beginObject();
+    appendAutocompleteFields(json, query, suggestions, timeTaken, cacheHit, dsUsed);
+    json.endObject();
+    return out;
+}
+
+std::string FileHandler::spellCheckOutputToJSON(
+    const std::string& query,
+    bool isCorrect,
+    const std::vector<std::string>& corrections,
+    double timeTaken) {
+    
+    std::string out;
+    JSONWriter json(out, JSONWriter::SPACED);
+    json.beginObject();
+    appendSpellCheckFields(json, query, isCorrect, corrections, timeTaken);
+    json.endObject();
+    return out;
+}
+
+void FileHandler::appendAutocompleteFields(
+    JSONWriter& json,
+    const std::string& query,
+    const std::vector<std::string>& suggestions,
+    double timeTaken,
+    bool cacheHit,
+    const std::vector<std::string>& dsUsed) {
     
-    writeJSON(filename, json.str());
+    json.field("type", "autocomplete");
+    json.field("query", query);
+    json.key("suggestions").stringArray(suggestions);
+    json.field("count", suggestions.size());
+    json.field("timeTaken", timeTaken);
+    json.field("cacheHit", cacheHit);
+    json.key("dataStructuresUsed").stringArray(dsUsed);
+}
+
+void FileHandler::appendSpellCheckFields(
+    JSONWriter& json,
+    const std::string& query,
+    bool isCorrect,
+    const std::vector<std::string>& corrections,
+    double timeTaken) {
+    
+    json.field("type", "spellcheck");
+    json.field("query", query);
+    json.field("isCorrect", isCorrect);
+    json.key("corrections").stringArray(corrections);
+    json.field("timeTaken", timeTaken);
 }
 
 void FileHandler::writeJSON(const std::string& filename, const std::string& jsonContent) {
@@ -132,39 +416,15 @@ bool FileHandler::createDirectory(const std::string& path) {
 }
 
 std::string FileHandler::vectorToJSON(const std::vector<std::string>& vec) {
-    if (vec.empty()) {
-        return "[]";
-    }
-    
-    std::stringstream json;
-    json << "[";
-    
-    for (size_t i = 0; i < vec.size(); i++) {
-        json << "\"" << escapeJSON(vec[i]) << "\"";
-        if (i < vec.size() - 1) {
-            json << ", ";
-        }
-    }
-    
-    json << "]";
-    return json.str();
+    std::string out;
+    JSONWriter json(out, JSONWriter::SPACED);
+    json.stringArray(vec);
+    return out;
 }
 
 std::string FileHandler::escapeJSON(const std::string& str) {
     std::string result;
-    
-    for (char c : str) {
-        switch (c) {
-            case '"':  result += "\\\""; break;
-            case '\\': result += "\\\\"; break;
-            case '\b': result += "\\b";  break;
-            case '\f': result += "\\f";  break;
-            case '\n': result += "\\n";  break;
-            case '\r': result += "\\r";  break;
-            case '\t': result += "\\t";  break;
-            default:   result += c;      break;
-        }
-    }
-    
+    result.reserve(str.size());
+    JSONWriter::appendEscaped(result, str);
     return result;
 }
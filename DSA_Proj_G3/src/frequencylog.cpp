@@ -0,0 +1,477 @@
+#include "frequencylog.h"
+#include "filehandler.h"
+#include "utils.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <filesystem>
+#include <iterator>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+    const char* EPOCH_HEADER = "#epoch ";
+    const char* TIME_HEADER = "#t ";
+
+    // Scores are decayed with the Trie's default half-life
+    const double HALF_LIFE_SECONDS = DecayedScore::DEFAULT_HALF_LIFE_SECONDS;
+
+    int positiveEnv(const char* name, int fallback) {
+        const char* value = std::getenv(name);
+        if (value == nullptr) return fallback;
+        int parsed = std::atoi(value);
+        return parsed > 0 ? parsed : fallback;
+    }
+
+    // Push a stream's written data to the disk
+    bool syncFile(std::FILE* file) {
+        if (std::fflush(file) != 0) return false;
+#ifdef _WIN32
+        return _commit(_fileno(file)) == 0;
+#else
+        return fsync(fileno(file)) == 0;
+#endif
+    }
+
+    // Frequencies are ints everywhere else
+    int clampToInt(long long value) {
+        return static_cast<int>(std::max<long long>(INT_MIN, std::min<long long>(INT_MAX, value)));
+    }
+
+    // Receives one record with the time of its batch
+    using TimedCallback = std::function<void(std::string_view word, int delta, uint32_t time)>;
+
+    /**
+     * Read a log or snapshot file: "#epoch N" header, then batches of
+     * dictionary lines, each after a "#t <seconds>" line with its time
+     * @param validBytes: Set to the length up to the last complete line
+     * @return: Epoch from the header, -1 if the file is missing or has none
+     */
+    long long readEpochFile(const std::string& path, const TimedCallback& onEntry, long long& validBytes) {
+        validBytes = 0;
+        MappedFile file;
+        if (!file.open(path)) return -1;
+
+        const char* data = file.data();
+        size_t headerLength = std::strlen(EPOCH_HEADER);
+        if (file.size() < headerLength || std::memcmp(data, EPOCH_HEADER, headerLength) != 0) {
+            return -1;
+        }
+
+        const char* end = data + file.size();
+        const char* body = static_cast<const char*>(std::memchr(data, '\n', file.size()));
+        if (body == nullptr) return -1;  // Torn header
+        body++;
+
+        long long epoch = std::atoll(data + headerLength);
+
+        // A crash can leave half a line at the end: only whole lines count
+        const char* lastNewline = end;
+        while (lastNewline > body && lastNewline[-1] != '\n') lastNewline--;
+
+        auto isTimeLine = [lastNewline](const char* line) {
+            return lastNewline - line > 3 && std::memcmp(line, TIME_HEADER, 3) == 0;
+        };
+
+        uint32_t time = DecayedScore::nowSeconds();  // Lines before any "#t"
+        int skipped = 0;
+        const char* segment = body;
+
+        while (segment < lastNewline) {
+            const char* lineEnd = static_cast<const char*>(std::memchr(segment, '\n', lastNewline - segment));
+            if (isTimeLine(segment)) {
+                time = static_cast<uint32_t>(std::atoll(segment + 3));
+                segment = lineEnd + 1;
+                continue;
+            }
+
+            // Scan up to the next time line in one call
+            const char* segmentEnd = lineEnd + 1;
+            while (segmentEnd < lastNewline && !isTimeLine(segmentEnd)) {
+                segmentEnd = static_cast<const char*>(std::memchr(segmentEnd, '\n', lastNewline - segmentEnd)) + 1;
+            }
+
+            skipped += FileHandler::scanDictionary(segment, segmentEnd - segment,
+                [&onEntry, time](std::string_view word, int delta) {
+                    onEntry(word, delta, time);
+                });
+            segment = segmentEnd;
+        }
+
+        if (skipped > 0) {
+            Utils::logWarning("Skipped " + std::to_string(skipped) + " malformed line(s) in " + path);
+        }
+
+        validBytes = lastNewline - data;
+        return epoch;
+    }
+}
+
+FrequencyLog::Config::Config()
+    : logPath("data/frequency.log"),
+      snapshotPath("data/frequency.log.snapshot"),
+      flushIntervalMs(200),
+      maxBatchRecords(4096),
+      syncOnFlush(false),
+      compactThresholdBytes(1024 * 1024) {
+}
+
+FrequencyLog::Config FrequencyLog::Config::fromEnvironment() {
+    Config config;
+
+    const char* path = std::getenv("AUTOCOMPLETE_FREQUENCY_LOG");
+    if (path != nullptr && *path != '\0') {
+        if (std::string(path) == "off") {
+            config.logPath.clear();
+            config.snapshotPath.clear();
+        } else {
+            config.logPath = path;
+            config.snapshotPath = config.logPath + ".snapshot";
+        }
+    }
+
+    const char* sync = std::getenv("AUTOCOMPLETE_FREQUENCY_LOG_FSYNC");
+    if (sync != nullptr) config.syncOnFlush = std::string(sync) == "1";
+
+    config.flushIntervalMs = positiveEnv("AUTOCOMPLETE_FREQUENCY_LOG_FLUSH_MS", config.flushIntervalMs);
+
+    return config;
+}
+
+FrequencyLog::FrequencyLog(const Config& logConfig)
+    : config(logConfig), logFile(nullptr), epoch(1), logBytes(0), replayed(false),
+      resumeLog(false), recorded(0), stopping(false) {
+    stats.recorded = 0;
+    stats.flushed = 0;
+    stats.batches = 0;
+    stats.compactions = 0;
+    stats.logBytes = 0;
+    stats.learnedWords = 0;
+}
+
+FrequencyLog::~FrequencyLog() {
+    if (flusher.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(pendingMutex);
+            stopping = true;
+        }
+        pendingReady.notify_all();
+        flusher.join();  // The last round flushes what is left
+    } else {
+        flush();
+    }
+
+    if (logFile != nullptr) {
+        std::fclose(logFile);
+    }
+}
+
+int FrequencyLog::replay() {
+    std::lock_guard<std::mutex> fileLock(fileMutex);
+    std::lock_guard<std::mutex> lock(learnedMutex);
+    replayed = true;
+
+    int records = 0;
+    auto accumulate = [this, &records](std::string_view word, int delta, uint32_t time) {
+        learned[std::string(word)].add(delta, time, HALF_LIFE_SECONDS);
+        records++;
+    };
+
+    long long ignored = 0;
+    long long snapshotEpoch = readEpochFile(config.snapshotPath, accumulate, ignored);
+
+    // Only a log newer than the snapshot still holds deltas the snapshot
+    // does not include. An older one was compacted just before a crash.
+    std::unordered_map<std::string, DecayedScore> beforeLog = learned;
+    int snapshotRecords = records;
+    long long validBytes = 0;
+    long long logEpoch = readEpochFile(config.logPath, accumulate, validBytes);
+
+    if (logEpoch > snapshotEpoch) {
+        epoch = logEpoch;
+        logBytes = validBytes;
+        resumeLog = true;
+    } else {
+        learned.swap(beforeLog);
+        records = snapshotRecords;
+        epoch = std::max(snapshotEpoch, 0LL) + 1;
+        resumeLog = false;
+    }
+
+    // Drop words whose deltas cancelled out
+    for (auto it = learned.begin(); it != learned.end(); ) {
+        it = it->second.value == 0.0f ? learned.erase(it) : std::next(it);
+    }
+
+    if (records > 0) {
+        Utils::logInfo("Replayed " + Utils::formatNumber(records) + " learned frequency record(s) for " +
+                       Utils::formatNumber(static_cast<int>(learned.size())) + " word(s)");
+    }
+    return records;
+}
+
+bool FrequencyLog::start() {
+    if (!replayed) replay();
+
+    {
+        std::lock_guard<std::mutex> lock(fileMutex);
+
+        if (resumeLog) {
+            // Cut a torn last line before appending after it
+            std::error_code error;
+            std::filesystem::resize_file(config.logPath, static_cast<uintmax_t>(logBytes), error);
+            logFile = error ? nullptr : std::fopen(config.logPath.c_str(), "ab");
+
+            std::lock_guard<std::mutex> statsLock(statsMutex);
+            stats.logBytes = logBytes;
+        } else {
+            resetLog(epoch);
+        }
+
+        if (logFile == nullptr) {
+            Utils::logError("Cannot write frequency log: " + config.logPath +
+                            " (learned frequencies are kept in memory only)");
+            return false;
+        }
+    }
+
+    flusher = std::thread(&FrequencyLog::flushLoop, this);
+    return true;
+}
+
+void FrequencyLog::record(const std::string& word, int delta) {
+    if (word.empty() || delta == 0) return;
+
+    // One "word delta" per line: a space or control character would split it
+    for (char ch : word) {
+        if (static_cast<unsigned char>(ch) <= ' ') {
+            Utils::logError("Frequency log: word with whitespace not recorded");
+            return;
+        }
+    }
+
+    bool batchFull;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        pending.push_back({word, delta});
+        recorded++;
+        batchFull = pending.size() >= static_cast<size_t>(config.maxBatchRecords);
+    }
+
+    if (batchFull) {
+        pendingReady.notify_one();
+    }
+}
+
+bool FrequencyLog::flush() {
+    std::lock_guard<std::mutex> fileLock(fileMutex);
+
+    std::vector<std::pair<std::string, int>> batch;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        batch.swap(pending);
+    }
+
+    if (batch.empty()) return true;
+    return writeBatch(batch);
+}
+
+bool FrequencyLog::writeBatch(const std::vector<std::pair<std::string, int>>& batch) {
+    // Sum the batch per word: one line per word, however often it was picked
+    std::unordered_map<std::string, long long> sums;
+    for (const auto& entry : batch) {
+        sums[entry.first] += entry.second;
+    }
+
+    // The batch's time line, then one line per word
+    uint32_t now = DecayedScore::nowSeconds();
+    std::string buffer = std::string(TIME_HEADER) + std::to_string(now) + "\n";
+    size_t headerLength = buffer.size();
+    for (const auto& entry : sums) {
+        if (entry.second == 0) continue;
+        buffer += entry.first;
+        buffer += ' ';
+        buffer += std::to_string(clampToInt(entry.second));
+        buffer += '\n';
+    }
+
+    if (buffer.size() == headerLength) buffer.clear();  // Everything cancelled out
+
+    bool ok = true;
+    if (logFile != nullptr && !buffer.empty()) {
+        ok = std::fwrite(buffer.data(), 1, buffer.size(), logFile) == buffer.size();
+        ok = ok && (config.syncOnFlush ? syncFile(logFile) : std::fflush(logFile) == 0);
+        if (!ok) {
+            Utils::logError("Frequency log write failed: " + config.logPath);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(learnedMutex);
+        for (const auto& entry : sums) {
+            if (entry.second == 0) continue;
+            learned[entry.first].add(static_cast<double>(clampToInt(entry.second)), now, HALF_LIFE_SECONDS);
+        }
+    }
+
+    if (ok && logFile != nullptr) {
+        logBytes += buffer.size();
+    }
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats.flushed += batch.size();
+    stats.batches++;
+    stats.logBytes = logBytes;
+    return ok;
+}
+
+bool FrequencyLog::resetLog(long long newEpoch) {
+    if (logFile != nullptr) {
+        std::fclose(logFile);
+    }
+
+    logFile = std::fopen(config.logPath.c_str(), "wb");
+    if (logFile == nullptr) return false;
+
+    std::string header = std::string(EPOCH_HEADER) + std::to_string(newEpoch) + "\n";
+    bool ok = std::fwrite(header.data(), 1, header.size(), logFile) == header.size() && syncFile(logFile);
+
+    epoch = newEpoch;
+    logBytes = header.size();
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats.logBytes = logBytes;
+    return ok;
+}
+
+bool FrequencyLog::compactLocked() {
+    // Decay every score to now, in whole uses; words whose score rounds
+    // to zero are forgotten, which keeps the snapshot bounded
+    uint32_t now = DecayedScore::nowSeconds();
+    std::vector<std::pair<std::string, int>> totals;
+    {
+        std::lock_guard<std::mutex> lock(learnedMutex);
+        for (const auto& entry : learned) {
+            long long rounded = std::llround(entry.second.valueAt(now, HALF_LIFE_SECONDS));
+            if (rounded != 0) totals.push_back({entry.first, clampToInt(rounded)});
+        }
+    }
+    std::sort(totals.begin(), totals.end());
+
+    // The snapshot covers every log up to the current epoch
+    std::string temporary = config.snapshotPath + ".tmp";
+    std::FILE* snapshot = std::fopen(temporary.c_str(), "wb");
+    if (snapshot == nullptr) {
+        Utils::logError("Cannot write frequency snapshot: " + temporary);
+        return false;
+    }
+
+    std::string buffer = std::string(EPOCH_HEADER) + std::to_string(epoch) + "\n" +
+                         TIME_HEADER + std::to_string(now) + "\n";
+    for (const auto& entry : totals) {
+        buffer += entry.first;
+        buffer += ' ';
+        buffer += std::to_string(entry.second);
+        buffer += '\n';
+    }
+
+    // Always synced: the rename must never publish a partial snapshot
+    bool ok = std::fwrite(buffer.data(), 1, buffer.size(), snapshot) == buffer.size() && syncFile(snapshot);
+    std::fclose(snapshot);
+
+    std::error_code error;
+    if (ok) {
+        std::filesystem::rename(temporary, config.snapshotPath, error);
+    }
+    if (!ok || error) {
+        Utils::logError("Frequency snapshot failed: " + config.snapshotPath);
+        std::remove(temporary.c_str());
+        return false;
+    }
+
+    // Memory matches the snapshot from now on
+    {
+        std::lock_guard<std::mutex> lock(learnedMutex);
+        learned.clear();
+        for (const auto& entry : totals) {
+            learned[entry.first].add(entry.second, now, HALF_LIFE_SECONDS);
+        }
+    }
+
+    // From here a crash is safe: the old log's epoch is covered
+    long long compactedBytes = logBytes;
+    if (!resetLog(epoch + 1)) {
+        Utils::logError("Cannot restart frequency log: " + config.logPath);
+    }
+
+    Utils::logInfo("Frequency log compacted: " + Utils::formatNumber(static_cast<int>(compactedBytes)) +
+                   " log bytes into a snapshot of " + Utils::formatNumber(static_cast<int>(totals.size())) +
+                   " word(s)");
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats.compactions++;
+    return true;
+}
+
+bool FrequencyLog::compact() {
+    flush();
+
+    std::lock_guard<std::mutex> lock(fileMutex);
+    if (config.snapshotPath.empty()) return false;
+    return compactLocked();
+}
+
+void FrequencyLog::flushLoop() {
+    std::unique_lock<std::mutex> lock(pendingMutex);
+
+    while (true) {
+        pendingReady.wait_for(lock, std::chrono::milliseconds(config.flushIntervalMs), [this]() {
+            return stopping || pending.size() >= static_cast<size_t>(config.maxBatchRecords);
+        });
+        bool stop = stopping;
+        lock.unlock();
+
+        flush();
+        {
+            std::lock_guard<std::mutex> fileLock(fileMutex);
+            if (logFile != nullptr && !config.snapshotPath.empty() &&
+                logBytes >= config.compactThresholdBytes) {
+                compactLocked();
+            }
+        }
+
+        lock.lock();
+        if (stop) break;
+    }
+}
+
+void FrequencyLog::forEachLearned(const std::function<void(const std::string&, const DecayedScore&)>& visit) const {
+    std::lock_guard<std::mutex> lock(learnedMutex);
+    for (const auto& entry : learned) {
+        visit(entry.first, entry.second);
+    }
+}
+
+FrequencyLog::Stats FrequencyLog::getStats() const {
+    Stats current;
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        current = stats;
+    }
+    {
+        std::lock_guard<std::mutex> lock(learnedMutex);
+        current.learnedWords = static_cast<int>(learned.size());
+    }
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        current.recorded = recorded;
+    }
+    return current;
+}
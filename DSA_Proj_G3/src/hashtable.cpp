@@ -1,6 +1,7 @@
 #include "hashtable.h"
+#include "utils.h"
 
-HashTable::HashTable(int size) : tableSize(size), elementCount(0) {
+HashTable::HashTable(int size) : tableSize(size), elementCount(0), nodeBytes(0) {
     table.resize(tableSize, nullptr);
 }
 
@@ -37,6 +38,7 @@ void HashTable::resize() {
             insert(current->key, current->value);
             HashNode* temp = current;
             current = current->next;
+            nodeBytes -= sizeof(HashNode) + Utils::stringHeapBytes(temp->key);
             delete temp;
         }
     }
@@ -65,6 +67,7 @@ void HashTable::insert(const std::string& key, int value) {
     newNode->next = table[index];
     table[index] = newNode;
     elementCount++;
+    nodeBytes += sizeof(HashNode) + Utils::stringHeapBytes(newNode->key);
 }
 
 bool HashTable::search(const std::string& key, int& value) {
@@ -124,6 +127,7 @@ bool HashTable::remove(const std::string& key) {
             } else {
                 prev->next = current->next;
             }
+            nodeBytes -= sizeof(HashNode) + Utils::stringHeapBytes(current->key);
             delete current;
             elementCount--;
             return true;
@@ -144,6 +148,10 @@ double HashTable::getLoadFactor() const {
     return static_cast<double>(elementCount) / tableSize;
 }
 
+size_t HashTable::getMemoryBytes() const {
+    return sizeof(HashTable) + table.capacity() * sizeof(HashNode*) + nodeBytes;
+}
+
 void HashTable::clear() {
     for (int i = 0; i < tableSize; i++) {
         HashNode* current = table[i];
@@ -155,4 +163,5 @@ void HashTable::clear() {
         table[i] = nullptr;
     }
     elementCount = 0;
+    nodeBytes = 0;
 }
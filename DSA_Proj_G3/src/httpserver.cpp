@@ -1,19 +1,124 @@
 #include "httpserver.h"
 #include "utils.h"
-#include "apifetcher.h"
+#include "documentchecker.h"
+#include "metrics.h"
+#include "tracing.h"
+#include "jsonreader.h"
 #include <iostream>
 #include <sstream>
+#include <cstdlib>
+
+#ifdef _WIN32
 #include <winsock2.h>
 #include <ws2tcpip.h>
 
 #pragma comment(lib, "ws2_32.lib")
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <cerrno>
+
+// Map the Winsock names used below onto POSIX sockets
+typedef int SOCKET;
+#define INVALID_SOCKET (-1)
+#define SOCKET_ERROR (-1)
+#define closesocket close
+#define WSACleanup() ((void)0)
+static int WSAGetLastError() { return errno; }
+#endif
+
+#ifdef MSG_NOSIGNAL
+#define SEND_FLAGS MSG_NOSIGNAL
+#else
+#define SEND_FLAGS 0
+#endif
+
+// Largest request body accepted (documents for /check)
+static const size_t MAX_REQUEST_BYTES = 64 * 1024 * 1024;
+
+// Bytes of NDJSON buffered before a chunk is sent by /check
+static const size_t CHECK_CHUNK_BYTES = 16 * 1024;
+
+// Larger response buffers (trace dumps) are released instead of kept
+static const size_t MAX_RETAINED_BUFFER_BYTES = 1024 * 1024;
+
+static bool sendAll(SOCKET socket, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.length()) {
+        int n = send(socket, data.c_str() + sent, static_cast<int>(data.length() - sent), SEND_FLAGS);
+        if (n <= 0) return false;
+        sent += n;
+    }
+    return true;
+}
+
+static bool sendChunk(SOCKET socket, const std::string& data) {
+    if (data.empty()) return true;
+    std::ostringstream chunk;
+    chunk << std::hex << data.length() << "\r\n" << data << "\r\n";
+    return sendAll(socket, chunk.str());
+}
+
+/**
+ * Read one full request: headers, then Content-Length bytes of body
+ * @param tooLarge: Set if the headers or the declared body exceed
+ *                  MAX_REQUEST_BYTES; the body is then not read
+ */
+static std::string receiveRequest(SOCKET socket, bool& tooLarge) {
+    tooLarge = false;
+    std::string raw;
+    char buffer[16384];
+    size_t headerEnd = std::string::npos;
+    size_t expected = 0;
+
+    while (true) {
+        int bytesReceived = recv(socket, buffer, sizeof(buffer), 0);
+        if (bytesReceived <= 0) break;
+        raw.append(buffer, bytesReceived);
+
+        if (headerEnd == std::string::npos) {
+            headerEnd = raw.find("\r\n\r\n");
+            if (headerEnd == std::string::npos) {
+                if (raw.length() > MAX_REQUEST_BYTES) {
+                    tooLarge = true;
+                    break;
+                }
+                continue;
+            }
+
+            // Find Content-Length (case-insensitive header name)
+            std::string headers = Utils::toLower(raw.substr(0, headerEnd));
+            size_t pos = headers.find("content-length:");
+            size_t contentLength = 0;
+            if (pos != std::string::npos) {
+                contentLength = std::strtoul(headers.c_str() + pos + 15, nullptr, 10);
+            }
+            if (contentLength > MAX_REQUEST_BYTES) {
+                // Checking a cut-off document would report wrong results
+                tooLarge = true;
+                break;
+            }
+            expected = headerEnd + 4 + contentLength;
+        }
+
+        if (raw.length() >= expected) break;
+    }
 
-HTTPServer::HTTPServer(int serverPort, AutocompleteEngine* autoEngine, SpellChecker* spellCheck)
-    : port(serverPort), running(false), autocomplete(autoEngine), spellchecker(spellCheck) {
+    return raw;
+}
+
+HTTPServer::HTTPServer(int serverPort, DictionaryManager* dictionaries)
+    : port(serverPort), running(false), dictionary(dictionaries) {
+    upstream = new UpstreamClient(UpstreamClient::Config::fromEnvironment());
+    router = new QueryRouter(dictionary, upstream, QueryRouter::Config::fromEnvironment());
 }
 
 HTTPServer::~HTTPServer() {
     stop();
+    delete router;  // Stops the prefetcher before the client goes away
+    delete upstream;
 }
 
 HTTPServer::HTTPRequest HTTPServer::parseRequest(const std::string& rawRequest) {
@@ -41,213 +146,343 @@ HTTPServer::HTTPRequest HTTPServer::parseRequest(const std::string& rawRequest)
         }
     }
 
-    // Parse body (rest of the stream)
-    std::string body;
-    while (std::getline(stream, line)) {
-        body += line;
+    // Body is everything after the blank line, byte for byte
+    size_t bodyStart = rawRequest.find("\r\n\r\n");
+    if (bodyStart != std::string::npos) {
+        req.body = rawRequest.substr(bodyStart + 4);
     }
-    req.body = body;
 
     return req;
 }
 
-std::string HTTPServer::buildResponse(const HTTPResponse& response) {
-    std::ostringstream oss;
+void HTTPServer::buildResponse(const HTTPResponse& response, std::string& out) {
+    size_t headerBytes = 0;
+    for (const auto& header : response.headers) {
+        headerBytes += header.first.length() + header.second.length() + 4;
+    }
+    out.reserve(out.length() + 32 + response.statusText.length() + headerBytes + response.body.length());
 
     // Status line
-    oss << "HTTP/1.1 " << response.statusCode << " " << response.statusText << "\r\n";
+    out += "HTTP/1.1 ";
+    out += std::to_string(response.statusCode);
+    out += ' ';
+    out += response.statusText;
+    out += "\r\n";
 
     // Headers
     for (const auto& header : response.headers) {
-        oss << header.first << ": " << header.second << "\r\n";
+        out += header.first;
+        out += ": ";
+        out += header.second;
+        out += "\r\n";
     }
 
     // Blank line
-    oss << "\r\n";
+    out += "\r\n";
 
     // Body
-    oss << response.body;
-
-    return oss.str();
+    out += response.body;
 }
 
-std::string HTTPServer::extractJSONValue(const std::string& json, const std::string& key) {
-    std::string searchKey = "\"" + key + "\"";
-    size_t pos = json.find(searchKey);
-    
-    if (pos == std::string::npos) {
-        return "";
-    }
+bool HTTPServer::parseQueryBody(HTTPRequest& req) {
+    req.query.clear();
+    req.mode.clear();
 
-    // Find the colon after the key
-    size_t colonPos = json.find(':', pos);
-    if (colonPos == std::string::npos) {
-        return "";
-    }
+    JSONReader json(req.body);
+    if (!json.beginObject()) return false;
 
-    // Skip whitespace and quotes
-    size_t valueStart = colonPos + 1;
-    while (valueStart < json.length() && (json[valueStart] == ' ' || json[valueStart] == '"')) {
-        valueStart++;
-    }
-
-    // Find value end (quote or comma or })
-    size_t valueEnd = valueStart;
-    bool inQuotes = (json[colonPos + 1] == '"' || json[valueStart - 1] == '"');
-    
-    if (inQuotes) {
-        while (valueEnd < json.length() && json[valueEnd] != '"') {
-            valueEnd++;
-        }
-    } else {
-        while (valueEnd < json.length() && json[valueEnd] != ',' && json[valueEnd] != '}') {
-            valueEnd++;
-        }
-    }
-
-    return json.substr(valueStart, valueEnd - valueStart);
-}
-
-std::string HTTPServer::buildJSONArray(const std::vector<std::string>& items) {
-    std::ostringstream oss;
-    oss << "[";
-    
-    for (size_t i = 0; i < items.size(); i++) {
-        oss << "\"" << items[i] << "\"";
-        if (i < items.size() - 1) {
-            oss << ",";
+    std::string key;
+    while (json.nextMember(key)) {
+        if (key == "query" && json.peek() == JSONReader::STRING) {
+            json.readString(req.query);
+        } else if (key == "mode" && json.peek() == JSONReader::STRING) {
+            json.readString(req.mode);
+        } else {
+            json.skipValue();
         }
     }
-    
-    oss << "]";
-    return oss.str();
+    return json.finish();
 }
 
-std::string HTTPServer::buildJSONArray(const std::vector<std::pair<std::string, int>>& items) {
-    std::ostringstream oss;
-    oss << "[";
-    
-    for (size_t i = 0; i < items.size(); i++) {
-        oss << "{\"word\":\"" << items[i].first << "\",\"score\":" << items[i].second << "}";
-        if (i < items.size() - 1) {
-            oss << ",";
-        }
+void HTTPServer::writeJSONArray(JSONWriter& json, const std::vector<std::pair<std::string, int>>& items) {
+    json.beginArray();
+    for (const auto& item : items) {
+        json.beginObject().field("word", item.first).field("score", item.second).endObject();
     }
-    
-    oss << "]";
-    return oss.str();
+    json.endArray();
 }
 
-std::string HTTPServer::handleQuery(const std::string& requestBody) {
+void HTTPServer::handleQuery(HTTPRequest& req, std::string& out) {
+    out.clear();
     try {
         // Extract query and mode from JSON
-        std::string query = extractJSONValue(requestBody, "query");
-        std::string mode = extractJSONValue(requestBody, "mode");
+        bool wellFormed;
+        {
+            Tracing::Span span("parse");
+            wellFormed = parseQueryBody(req);
+        }
+        const std::string& query = req.query;
+        const std::string& mode = req.mode;
 
+        if (!wellFormed) {
+            out = "{\"error\":\"Malformed JSON body\",\"suggestions\":[]}";
+            return;
+        }
         if (query.empty()) {
-            return "{\"error\":\"Missing query parameter\",\"suggestions\":[]}";
+            out = "{\"error\":\"Missing query parameter\",\"suggestions\":[]}";
+            return;
         }
 
-        std::ostringstream response;
-        response << "{";
-        response << "\"query\":\"" << query << "\",";
-        response << "\"mode\":\"" << mode << "\",";
+        JSONWriter response(out);
+        response.beginObject();
+        response.field("query", query);
+        response.field("mode", mode);
 
         if (mode == "autocomplete") {
-            // Fetch live autocomplete suggestions from Datamuse API
-            Utils::logInfo("Fetching autocomplete from Datamuse API for: " + query);
-            
-            auto apiSuggestions = APIFetcher::fetchAutocompleteSuggestions(query);
-            
-            if (apiSuggestions.empty()) {
-                // Fallback to local Trie if API fails
-                Utils::logWarning("API failed, using local Trie");
-                auto localSuggestions = autocomplete->getSuggestions(query);
-                response << "\"suggestions\":" << buildJSONArray(localSuggestions) << ",";
-                response << "\"count\":" << localSuggestions.size() << ",";
-                response << "\"source\":\"local\"";
-            } else {
-                // Convert WordSuggestion to pairs for JSON builder
-                std::vector<std::pair<std::string, int>> scored;
-                for (size_t i = 0; i < apiSuggestions.size() && i < 10; i++) {
-                    scored.push_back(std::make_pair(apiSuggestions[i].word, apiSuggestions[i].score));
-                }
-                response << "\"suggestions\":" << buildJSONArray(scored) << ",";
-                response << "\"count\":" << scored.size() << ",";
-                response << "\"source\":\"datamuse-api\"";
-            }
+            QueryRouter::Answer answer = router->autocomplete(query);
+            Tracing::Span span("serialize");
+            writeJSONArray(response.key("suggestions"), answer.suggestions);
+            response.field("count", answer.suggestions.size());
+            response.field("source", answer.source);
             
         } else if (mode == "spellcheck") {
-            // Check if word exists using DictionaryAPI
-            Utils::logInfo("Checking spelling via DictionaryAPI for: " + query);
-            
-            auto definition = APIFetcher::fetchDefinition(query);
-            bool isCorrect = definition.found;
-            
-            response << "\"isCorrect\":" << (isCorrect ? "true" : "false") << ",";
+            QueryRouter::Answer answer = router->spellcheck(query);
+            Tracing::Span span("serialize");
+            response.field("isCorrect", answer.isCorrect);
+            writeJSONArray(response.key("suggestions"), answer.suggestions);
+            response.field("count", answer.suggestions.size());
+            response.field("source", answer.source);
             
-            if (!isCorrect) {
-                // Fetch spelling suggestions from Datamuse API
-                auto spellingCorrections = APIFetcher::fetchSpellingSuggestions(query);
-                
-                if (spellingCorrections.empty()) {
-                    // Fallback to local BK-Tree
-                    Utils::logWarning("API failed, using local BK-Tree");
-                    auto localCorrections = spellchecker->getCorrections(query, 5);
-                    std::vector<std::pair<std::string, int>> scored;
-                    for (size_t i = 0; i < localCorrections.size(); i++) {
-                        scored.push_back(std::make_pair(localCorrections[i], 10 - static_cast<int>(i)));
-                    }
-                    response << "\"suggestions\":" << buildJSONArray(scored) << ",";
-                    response << "\"count\":" << localCorrections.size() << ",";
-                    response << "\"source\":\"local\"";
-                } else {
-                    // Convert WordSuggestion to pairs for JSON builder
-                    std::vector<std::pair<std::string, int>> scored;
-                    for (size_t i = 0; i < spellingCorrections.size() && i < 5; i++) {
-                        scored.push_back(std::make_pair(spellingCorrections[i].word, spellingCorrections[i].score));
-                    }
-                    response << "\"suggestions\":" << buildJSONArray(scored) << ",";
-                    response << "\"count\":" << scored.size() << ",";
-                    response << "\"source\":\"datamuse-api\"";
-                }
-            } else {
-                response << "\"suggestions\":[],";
-                response << "\"count\":0,";
-                response << "\"source\":\"dictionaryapi\"";
-            }
+        } else if (mode == "select") {
+            // The user picked this suggestion: rank it higher from now on
+            // (persisted through the frequency log, if enabled)
+            std::shared_ptr<DictionaryIndex> index = dictionary->acquire();
+            bool learned = index && index->getSpellChecker()->updateFrequency(query);
+            response.field("learned", learned);
             
         } else {
-            response << "\"error\":\"Invalid mode (use 'autocomplete' or 'spellcheck')\",";
-            response << "\"suggestions\":[]";
+            response.field("error", "Invalid mode (use 'autocomplete', 'spellcheck' or 'select')");
+            response.key("suggestions").beginArray().endArray();
         }
 
-        response << "}";
-        return response.str();
+        response.endObject();
     } catch (const std::exception& e) {
         Utils::logError(std::string("Query error: ") + e.what());
-        return "{\"error\":\"Internal server error\",\"suggestions\":[]}";
+        out = "{\"error\":\"Internal server error\",\"suggestions\":[]}";
     }
 }
 
+void HTTPServer::handleDocumentCheck(const std::string& document,
+                                     const std::function<bool(const std::string&)>& sendChunk) {
+    // One snapshot for the whole document, however long it streams
+    std::shared_ptr<DictionaryIndex> index = dictionary->acquire();
+    DocumentChecker checker(index->getSpellChecker());
+    std::string pending;
+    bool clientGone = false;
+
+    DocumentChecker::Stats stats = checker.checkText(document,
+        [&](const DocumentChecker::Misspelling& misspelling) {
+            if (clientGone) return;
+            DocumentChecker::appendMisspellingJSON(pending, misspelling);
+            pending += '\n';
+            if (pending.length() >= CHECK_CHUNK_BYTES) {
+                clientGone = !sendChunk(pending);
+                pending.clear();
+            }
+        });
+
+    pending += "{\"summary\": " + DocumentChecker::statsToJSON(stats) + "}\n";
+    if (!clientGone) {
+        sendChunk(pending);
+    }
+
+    Utils::logInfo("Document check: " + std::to_string(stats.bytesProcessed) + " bytes, " +
+                   std::to_string(stats.misspellings) + " misspellings (" +
+                   Utils::formatDouble(stats.throughputMBps(), 2) + " MB/s)");
+}
+
+void HTTPServer::handleReload(bool fromLoopback, HTTPResponse& response) {
+    if (!fromLoopback) {
+        response.statusCode = 403;
+        response.statusText = "Forbidden";
+        response.body = "{\"error\":\"Reload is only accepted from localhost\"}";
+        return;
+    }
+
+    // The build runs on the manager's thread; this loop keeps serving
+    dictionary->requestReload();
+    DictionaryManager::Stats stats = dictionary->getStats();
+
+    response.statusCode = 202;
+    response.statusText = "Accepted";
+    response.body = "{\"status\":\"reloading\",\"generation\":" + std::to_string(stats.generation) + "}";
+}
+
+void HTTPServer::handleDelta(const std::string& body, bool fromLoopback, HTTPResponse& response) {
+    if (!fromLoopback) {
+        response.statusCode = 403;
+        response.statusText = "Forbidden";
+        response.body = "{\"error\":\"Deltas are only accepted from localhost\"}";
+        return;
+    }
+
+    std::shared_ptr<DictionaryIndex> index = dictionary->acquire();
+    SpellChecker::DeltaStats stats = index->applyDelta(body.data(), body.size());
+
+    response.body.clear();
+    JSONWriter json(response.body);
+    json.beginObject();
+    json.field("added", stats.added);
+    json.field("removed", stats.removed);
+    json.field("updated", stats.updated);
+    json.field("skipped", stats.skipped);
+    json.field("invalidated", stats.invalidated);
+    json.field("words", index->getWordCount());
+    json.key("applyMs").fixed(stats.elapsedMs, 3);
+    json.endObject();
+
+    response.statusCode = 200;
+    response.statusText = "OK";
+}
+
+void HTTPServer::handleTrace(const HTTPRequest& req, bool fromLoopback, HTTPResponse& response) {
+    if (!fromLoopback) {
+        response.statusCode = 403;
+        response.statusText = "Forbidden";
+        response.body = "{\"error\":\"Traces are only served to localhost\"}";
+        return;
+    }
+
+    response.statusCode = 200;
+    response.statusText = "OK";
+
+    if (req.method == "GET") {
+        response.body = Tracing::chromeTraceJSON();
+        return;
+    }
+
+    std::string command = Utils::trim(req.body);
+    if (command == "on" || command == "off") {
+        Tracing::setEnabled(command == "on");
+    } else if (command == "clear") {
+        Tracing::clear();
+    } else {
+        response.statusCode = 400;
+        response.statusText = "Bad Request";
+        response.body = "{\"error\":\"Body must be 'on', 'off' or 'clear'\"}";
+        return;
+    }
+    response.body = std::string("{\"tracing\":") + (Tracing::isEnabled() ? "true" : "false") +
+                    ",\"events\":" + std::to_string(Tracing::bufferedEvents()) + "}";
+}
+
+void HTTPServer::recordRequest(const HTTPRequest& req, int statusCode,
+                               std::chrono::steady_clock::time_point start) {
+    // Fixed label values only: arbitrary paths would grow the registry
+    static const char* const ENDPOINTS[] = {
+        "/query", "/check", "/health", "/metrics", "/admin/reload", "/admin/delta", "/admin/trace"
+    };
+    std::string endpoint = "other";
+    std::string path = req.path.compare(0, 5, "/api/") == 0 ? req.path.substr(4) : req.path;
+    for (const char* known : ENDPOINTS) {
+        if (path == known) endpoint = known;
+    }
+
+    std::string mode = "none";
+    if (endpoint == "/query") {
+        mode = req.mode;
+        if (mode != "autocomplete" && mode != "spellcheck" && mode != "select") {
+            mode = "invalid";
+        }
+    }
+
+    std::string endpointLabel = "endpoint=" + Metrics::labelValue(endpoint);
+    Metrics::histogram("autocomplete_request_duration_seconds",
+                       endpointLabel + ",mode=" + Metrics::labelValue(mode),
+                       "HTTP request latency by endpoint and query mode").recordSince(start);
+    Metrics::counter("autocomplete_requests_total",
+                     endpointLabel + ",status=\"" + std::to_string(statusCode) + "\"",
+                     "HTTP requests by endpoint and status").add();
+}
+
+std::string HTTPServer::handleMetrics() {
+    std::shared_ptr<DictionaryIndex> index = dictionary->acquire();
+    if (index) {
+        SpellChecker::MemoryStats memory = index->getSpellChecker()->getMemoryStats();
+        const std::pair<const char*, size_t> structures[] = {
+            {"trie", memory.trie}, {"bktree", memory.bkTree}, {"hashtable", memory.hashTable},
+            {"bloomfilter", memory.bloomFilter}, {"cache", memory.cache}
+        };
+        for (const auto& structure : structures) {
+            Metrics::gauge("autocomplete_memory_bytes", "structure=" + Metrics::labelValue(structure.first),
+                           "Bytes held by each data structure of the current index").set(structure.second);
+        }
+    }
+    Metrics::gauge("process_resident_memory_bytes", "",
+                   "Resident set size of the server process").set(Utils::getResidentMemoryBytes());
+
+    return Metrics::exposition();
+}
+
 std::string HTTPServer::handleHealth() {
-    std::ostringstream response;
-    response << "{";
-    response << "\"status\":\"healthy\",";
-    response << "\"service\":\"DSA Autocomplete API\",";
-    response << "\"version\":\"3.0\",";
-    response << "\"port\":" << port;
-    response << "}";
-    return response.str();
+    std::string out;
+    JSONWriter response(out);
+    response.beginObject();
+    response.field("status", "healthy");
+    response.field("service", "DSA Autocomplete API");
+    response.field("version", "3.0");
+    response.field("port", port);
+
+    std::shared_ptr<DictionaryIndex> index = dictionary->acquire();
+    DictionaryManager::Stats reloads = dictionary->getStats();
+    response.key("dictionary").beginObject();
+    response.field("words", index ? index->getWordCount() : 0);
+    response.field("generation", reloads.generation);
+    response.field("reloads", reloads.reloads);
+    response.field("failedReloads", reloads.failedReloads);
+    response.key("lastReloadMs").fixed(reloads.lastReloadMs, 1);
+    response.field("reloading", reloads.reloading);
+    response.endObject();
+
+    FrequencyLog* frequencyLog = dictionary->getFrequencyLog();
+    if (frequencyLog != nullptr) {
+        FrequencyLog::Stats learning = frequencyLog->getStats();
+        response.key("learning").beginObject();
+        response.field("recorded", learning.recorded);
+        response.field("flushed", learning.flushed);
+        response.field("batches", learning.batches);
+        response.field("compactions", learning.compactions);
+        response.field("logBytes", learning.logBytes);
+        response.field("learnedWords", learning.learnedWords);
+        response.endObject();
+    }
+
+    UpstreamClient::Stats stats = upstream->getStats();
+    response.field("routing", QueryRouter::modeName(router->getMode()));
+    response.key("upstream").beginObject();
+    response.field("datamuse", CircuitBreaker::stateName(upstream->getDatamuseState()));
+    response.field("dictionary", CircuitBreaker::stateName(upstream->getDictionaryState()));
+    response.field("requests", stats.requests);
+    response.field("cacheHits", stats.cacheHits);
+    response.field("failures", stats.failures);
+    response.field("timeouts", stats.timeouts);
+    response.field("shortCircuited", stats.shortCircuited);
+    response.field("prefetches", stats.prefetches);
+    response.field("connectionsReused", stats.connectionsReused);
+    response.endObject();
+    response.endObject();
+    return out;
 }
 
 void HTTPServer::start() {
+#ifdef _WIN32
     WSADATA wsaData;
     int result = WSAStartup(MAKEWORD(2, 2), &wsaData);
     if (result != 0) {
         Utils::logError("WSAStartup failed: " + std::to_string(result));
         return;
     }
+#endif
 
     // Create socket
     SOCKET listenSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
@@ -257,6 +492,12 @@ void HTTPServer::start() {
         return;
     }
 
+#ifndef _WIN32
+    // Allow quick restarts without waiting for TIME_WAIT
+    int reuse = 1;
+    setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+#endif
+
     // Bind socket
     sockaddr_in serverAddr;
     serverAddr.sin_family = AF_INET;
@@ -285,22 +526,27 @@ void HTTPServer::start() {
     // Main server loop
     while (running) {
         // Accept connection
-        SOCKET clientSocket = accept(listenSocket, NULL, NULL);
+        sockaddr_in clientAddr;
+        socklen_t clientAddrLength = sizeof(clientAddr);
+        SOCKET clientSocket = accept(listenSocket, (sockaddr*)&clientAddr, &clientAddrLength);
         if (clientSocket == INVALID_SOCKET) {
             Utils::logError("Accept failed: " + std::to_string(WSAGetLastError()));
             continue;
         }
 
-        // Receive request
-        char buffer[4096];
-        int bytesReceived = recv(clientSocket, buffer, sizeof(buffer) - 1, 0);
+        // Receive request (headers plus full body)
+        bool tooLarge = false;
+        std::string rawRequest = receiveRequest(clientSocket, tooLarge);
         
-        if (bytesReceived > 0) {
-            buffer[bytesReceived] = '\0';
-            std::string rawRequest(buffer);
-
+        if (!rawRequest.empty()) {
             // Parse request
-            HTTPRequest req = parseRequest(rawRequest);
+            std::chrono::steady_clock::time_point requestStart = std::chrono::steady_clock::now();
+            Tracing::Span requestSpan("request");
+            HTTPRequest req;
+            {
+                Tracing::Span span("parse");
+                req = parseRequest(rawRequest);
+            }
 
             // Build response
             HTTPResponse res;
@@ -308,18 +554,66 @@ void HTTPServer::start() {
             res.headers["Access-Control-Allow-Origin"] = "*";  // CORS
             res.headers["Access-Control-Allow-Methods"] = "GET, POST, OPTIONS";
             res.headers["Access-Control-Allow-Headers"] = "Content-Type";
-
+            res.headers["Connection"] = "close";
+
+            // Body over MAX_REQUEST_BYTES: refused, not read
+            if (tooLarge) {
+                res.statusCode = 413;
+                res.statusText = "Payload Too Large";
+                res.body = "{\"error\":\"Request body too large (limit " +
+                           std::to_string(MAX_REQUEST_BYTES / (1024 * 1024)) + " MB)\"}";
+            }
             // Handle OPTIONS preflight
-            if (req.method == "OPTIONS") {
+            else if (req.method == "OPTIONS") {
                 res.statusCode = 200;
                 res.statusText = "OK";
                 res.body = "";
             }
+            // Handle /check endpoint: streamed as a chunked NDJSON response
+            else if (req.path == "/check" || req.path == "/api/check") {
+                res.statusCode = 200;
+                res.statusText = "OK";
+                res.headers["Content-Type"] = "application/x-ndjson";
+                res.headers["Transfer-Encoding"] = "chunked";
+
+                responseBuffer.clear();
+                buildResponse(res, responseBuffer);
+                if (sendAll(clientSocket, responseBuffer)) {
+                    handleDocumentCheck(req.body, [clientSocket](const std::string& data) {
+                        return sendChunk(clientSocket, data);
+                    });
+                    sendAll(clientSocket, "0\r\n\r\n");
+                }
+
+                recordRequest(req, res.statusCode, requestStart);
+                closesocket(clientSocket);
+                continue;
+            }
             // Handle /query endpoint
             else if (req.path == "/query" || req.path == "/api/query") {
                 res.statusCode = 200;
                 res.statusText = "OK";
-                res.body = handleQuery(req.body);
+                res.body.swap(bodyBuffer);  // Reuse the last query's capacity
+                handleQuery(req, res.body);
+            }
+            // Handle /admin/reload endpoint
+            else if (req.path == "/admin/reload" && req.method == "POST") {
+                handleReload(ntohl(clientAddr.sin_addr.s_addr) == INADDR_LOOPBACK, res);
+            }
+            // Handle /admin/delta endpoint
+            else if (req.path == "/admin/delta" && req.method == "POST") {
+                handleDelta(req.body, ntohl(clientAddr.sin_addr.s_addr) == INADDR_LOOPBACK, res);
+            }
+            // Handle /admin/trace endpoint (Chrome trace JSON)
+            else if (req.path == "/admin/trace" && (req.method == "GET" || req.method == "POST")) {
+                handleTrace(req, ntohl(clientAddr.sin_addr.s_addr) == INADDR_LOOPBACK, res);
+            }
+            // Handle /metrics endpoint (Prometheus text format)
+            else if (req.path == "/metrics") {
+                res.statusCode = 200;
+                res.statusText = "OK";
+                res.headers["Content-Type"] = "text/plain; version=0.0.4";
+                res.body = handleMetrics();
             }
             // Handle /health endpoint
             else if (req.path == "/health" || req.path == "/api/health") {
@@ -335,8 +629,23 @@ void HTTPServer::start() {
             }
 
             // Send response
-            std::string responseStr = buildResponse(res);
-            send(clientSocket, responseStr.c_str(), responseStr.length(), 0);
+            res.headers["Content-Length"] = std::to_string(res.body.length());
+            {
+                Tracing::Span span("serialize");
+                responseBuffer.clear();
+                buildResponse(res, responseBuffer);
+            }
+            {
+                Tracing::Span span("send");
+                sendAll(clientSocket, responseBuffer);
+            }
+            if (req.path == "/query" || req.path == "/api/query") {
+                bodyBuffer.swap(res.body);
+            }
+            if (responseBuffer.capacity() > MAX_RETAINED_BUFFER_BYTES) {
+                std::string().swap(responseBuffer);
+            }
+            recordRequest(req, res.statusCode, requestStart);
         }
 
         // Close connection
@@ -0,0 +1,304 @@
+#include "jsonreader.h"
+#include <charconv>
+
+namespace {
+    int hexDigit(char ch) {
+        if (ch >= '0' && ch <= '9') return ch - '0';
+        if (ch >= 'a' && ch <= 'f') return ch - 'a' + 10;
+        if (ch >= 'A' && ch <= 'F') return ch - 'A' + 10;
+        return -1;
+    }
+
+    void appendUTF8(std::string& out, uint32_t code) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    bool isDigit(char ch) {
+        return ch >= '0' && ch <= '9';
+    }
+}
+
+JSONReader::Type JSONReader::peek() {
+    if (failed) return INVALID;
+    skipSpace();
+    if (pos >= text.size()) return INVALID;
+
+    char ch = text[pos];
+    switch (ch) {
+        case '"': return STRING;
+        case '{': return OBJECT;
+        case '[': return ARRAY;
+        case 't':
+        case 'f': return BOOLEAN;
+        case 'n': return NULL_VALUE;
+        default:  return (ch == '-' || isDigit(ch)) ? NUMBER : INVALID;
+    }
+}
+
+bool JSONReader::open(char bracket) {
+    if (failed) return false;
+    skipSpace();
+    if (pos >= text.size() || text[pos] != bracket || depth >= MAX_DEPTH) return fail();
+
+    pos++;
+    depth++;
+    hasElements &= ~(uint64_t(1) << (depth - 1));
+    return true;
+}
+
+bool JSONReader::beginObject() {
+    return open('{');
+}
+
+bool JSONReader::beginArray() {
+    return open('[');
+}
+
+bool JSONReader::next(char closing) {
+    if (failed) return false;
+    if (depth == 0) return fail();
+
+    skipSpace();
+    if (pos < text.size() && text[pos] == closing) {
+        pos++;
+        depth--;
+        return false;
+    }
+
+    uint64_t bit = uint64_t(1) << (depth - 1);
+    if (hasElements & bit) {
+        if (pos >= text.size() || text[pos] != ',') return fail();
+        pos++;
+    } else {
+        hasElements |= bit;
+    }
+    return true;
+}
+
+bool JSONReader::nextMember(std::string& key) {
+    return nextMemberKey(&key);
+}
+
+bool JSONReader::nextMemberKey(std::string* key) {
+    if (!next('}')) return false;
+
+    skipSpace();
+    if (pos >= text.size() || text[pos] != '"' || !scanString(key)) return fail();
+
+    skipSpace();
+    if (pos >= text.size() || text[pos] != ':') return fail();
+    pos++;
+    return true;
+}
+
+bool JSONReader::nextElement() {
+    return next(']');
+}
+
+bool JSONReader::scanString(std::string* out) {
+    if (out != nullptr) out->clear();
+    pos++;  // Opening quote
+
+    while (pos < text.size()) {
+        // Copy the run of plain characters in one append
+        size_t runStart = pos;
+        while (pos < text.size() && text[pos] != '"' && text[pos] != '\\' &&
+               static_cast<unsigned char>(text[pos]) >= 0x20) {
+            pos++;
+        }
+        if (out != nullptr) out->append(text.data() + runStart, pos - runStart);
+        if (pos >= text.size()) break;
+
+        char ch = text[pos];
+        if (ch == '"') {
+            pos++;
+            return true;
+        }
+        if (ch != '\\') return fail();  // Raw control character
+
+        if (++pos >= text.size()) break;
+        char escaped = text[pos++];
+        char decoded;
+        switch (escaped) {
+            case '"':  decoded = '"';  break;
+            case '\\': decoded = '\\'; break;
+            case '/':  decoded = '/';  break;
+            case 'b':  decoded = '\b'; break;
+            case 'f':  decoded = '\f'; break;
+            case 'n':  decoded = '\n'; break;
+            case 'r':  decoded = '\r'; break;
+            case 't':  decoded = '\t'; break;
+            case 'u': {
+                uint32_t code = 0;
+                for (int i = 0; i < 4; i++) {
+                    int digit = pos < text.size() ? hexDigit(text[pos++]) : -1;
+                    if (digit < 0) return fail();
+                    code = code * 16 + digit;
+                }
+
+                // UTF-16 surrogate pair -> one code point; a lone half becomes U+FFFD
+                if (code >= 0xD800 && code <= 0xDBFF && pos + 6 <= text.size() &&
+                    text[pos] == '\\' && text[pos + 1] == 'u') {
+                    uint32_t low = 0;
+                    bool valid = true;
+                    for (int i = 2; i < 6; i++) {
+                        int digit = hexDigit(text[pos + i]);
+                        valid = valid && digit >= 0;
+                        low = low * 16 + (digit < 0 ? 0 : digit);
+                    }
+                    if (valid && low >= 0xDC00 && low <= 0xDFFF) {
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        pos += 6;
+                    }
+                }
+                if (code >= 0xD800 && code <= 0xDFFF) code = 0xFFFD;
+
+                if (out != nullptr) appendUTF8(*out, code);
+                continue;
+            }
+            default:
+                return fail();
+        }
+        if (out != nullptr) *out += decoded;
+    }
+
+    return fail();  // Unterminated
+}
+
+std::string_view JSONReader::scanNumber() {
+    size_t start = pos;
+
+    if (pos < text.size() && text[pos] == '-') pos++;
+
+    // Integer part: 0, or digits without a leading zero
+    if (pos < text.size() && text[pos] == '0') {
+        pos++;
+    } else if (pos < text.size() && isDigit(text[pos])) {
+        while (pos < text.size() && isDigit(text[pos])) pos++;
+    } else {
+        fail();
+        return std::string_view();
+    }
+
+    if (pos < text.size() && text[pos] == '.') {
+        pos++;
+        if (pos >= text.size() || !isDigit(text[pos])) {
+            fail();
+            return std::string_view();
+        }
+        while (pos < text.size() && isDigit(text[pos])) pos++;
+    }
+
+    if (pos < text.size() && (text[pos] == 'e' || text[pos] == 'E')) {
+        pos++;
+        if (pos < text.size() && (text[pos] == '+' || text[pos] == '-')) pos++;
+        if (pos >= text.size() || !isDigit(text[pos])) {
+            fail();
+            return std::string_view();
+        }
+        while (pos < text.size() && isDigit(text[pos])) pos++;
+    }
+
+    return text.substr(start, pos - start);
+}
+
+bool JSONReader::scanLiteral(std::string_view literal) {
+    if (text.substr(pos, literal.size()) != literal) return fail();
+    pos += literal.size();
+    return true;
+}
+
+bool JSONReader::readString(std::string& out) {
+    if (peek() != STRING) return fail();
+    return scanString(&out);
+}
+
+bool JSONReader::readNumber(double& out) {
+    if (peek() != NUMBER) return fail();
+
+    std::string_view token = scanNumber();
+    if (token.empty()) return false;
+
+    std::from_chars_result result = std::from_chars(token.data(), token.data() + token.size(), out);
+    if (result.ec != std::errc() || result.ptr != token.data() + token.size()) return fail();
+    return true;
+}
+
+bool JSONReader::readInt(long long& out) {
+    if (peek() != NUMBER) return fail();
+
+    std::string_view token = scanNumber();
+    if (token.empty()) return false;
+
+    std::from_chars_result result = std::from_chars(token.data(), token.data() + token.size(), out);
+    if (result.ec != std::errc() || result.ptr != token.data() + token.size()) return fail();
+    return true;
+}
+
+bool JSONReader::readBool(bool& out) {
+    if (peek() != BOOLEAN) return fail();
+
+    out = text[pos] == 't';
+    return scanLiteral(out ? "true" : "false");
+}
+
+bool JSONReader::readNull() {
+    if (peek() != NULL_VALUE) return fail();
+    return scanLiteral("null");
+}
+
+bool JSONReader::skipValue() {
+    switch (peek()) {
+        case STRING:
+            return scanString(nullptr);
+        case NUMBER:
+            return !scanNumber().empty();
+        case BOOLEAN:
+            return scanLiteral(text[pos] == 't' ? "true" : "false");
+        case NULL_VALUE:
+            return scanLiteral("null");
+        case OBJECT:
+            beginObject();
+            while (nextMemberKey(nullptr)) {
+                if (!skipValue()) return false;
+            }
+            return ok();
+        case ARRAY:
+            beginArray();
+            while (nextElement()) {
+                if (!skipValue()) return false;
+            }
+            return ok();
+        default:
+            return fail();
+    }
+}
+
+std::string_view JSONReader::rawValue() {
+    if (failed) return std::string_view();
+    skipSpace();
+
+    size_t start = pos;
+    if (!skipValue()) return std::string_view();
+    return text.substr(start, pos - start);
+}
+
+bool JSONReader::finish() {
+    if (failed || depth != 0) return false;
+    skipSpace();
+    return pos == text.size();
+}
@@ -0,0 +1,58 @@
+#include "jsonwriter.h"
+#include <cmath>
+
+namespace {
+    // Escape for each byte below 0x20, and for '"' and '\\'; nullptr = copy as is
+    const char* escapeFor(unsigned char ch) {
+        static const char* const CONTROL[32] = {
+            "\\u0000", "\\u0001", "\\u0002", "\\u0003", "\\u0004", "\\u0005", "\\u0006", "\\u0007",
+            "\\b",     "\\t",     "\\n",     "\\u000b", "\\f",     "\\r",     "\\u000e", "\\u000f",
+            "\\u0010", "\\u0011", "\\u0012", "\\u0013", "\\u0014", "\\u0015", "\\u0016", "\\u0017",
+            "\\u0018", "\\u0019", "\\u001a", "\\u001b", "\\u001c", "\\u001d", "\\u001e", "\\u001f"
+        };
+        if (ch < 0x20) return CONTROL[ch];
+        if (ch == '"') return "\\\"";
+        if (ch == '\\') return "\\\\";
+        return nullptr;
+    }
+}
+
+void JSONWriter::appendEscaped(std::string& buffer, std::string_view text) {
+    // Copy runs of plain bytes in one append; most text has no escapes at all
+    size_t runStart = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+        const char* escape = escapeFor(static_cast<unsigned char>(text[i]));
+        if (escape == nullptr) continue;
+
+        buffer.append(text.data() + runStart, i - runStart);
+        buffer += escape;
+        runStart = i + 1;
+    }
+    buffer.append(text.data() + runStart, text.size() - runStart);
+}
+
+JSONWriter& JSONWriter::value(double number) {
+    if (!std::isfinite(number)) return null();
+
+    separate();
+    char digits[32];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), number,
+                                                std::chars_format::general, 6);
+    out.append(digits, result.ptr);
+    return *this;
+}
+
+JSONWriter& JSONWriter::fixed(double number, int decimals) {
+    if (!std::isfinite(number)) return null();
+
+    separate();
+    char digits[352];  // Largest double in fixed notation, plus decimals
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), number,
+                                                std::chars_format::fixed, decimals);
+    if (result.ec != std::errc()) {
+        // More decimals than the buffer holds: fall back to shortest form
+        result = std::to_chars(digits, digits + sizeof(digits), number);
+    }
+    out.append(digits, result.ptr);
+    return *this;
+}
@@ -1,7 +1,20 @@
 #include "lrucache.h"
+#include "utils.h"
 #include <algorithm>
+#include <chrono>
 
-LRUCache::LRUCache(int capacity) : capacity(capacity), size(0) {
+namespace {
+    long long steadyNowMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+LRUCache::LRUCache(int capacity) : LRUCache(capacity, 0) {
+}
+
+LRUCache::LRUCache(int capacity, int timeToLiveMs)
+    : capacity(capacity), size(0), timeToLiveMs(timeToLiveMs) {
     head = new CacheNode("", "");
     tail = new CacheNode("", "");
     head->next = tail;
@@ -37,12 +50,29 @@ CacheNode* LRUCache::removeTail() {
     return node;
 }
 
+void LRUCache::evict(CacheNode* node) {
+    removeNode(node);
+    cache.erase(node->key);
+    delete node;
+    size--;
+}
+
+bool LRUCache::isExpired(const CacheNode* node) const {
+    return node->expiresAt != 0 && steadyNowMs() >= node->expiresAt;
+}
+
 bool LRUCache::get(const std::string& key, std::string& value) {
-    if (cache.find(key) == cache.end()) {
+    auto it = cache.find(key);
+    if (it == cache.end()) {
         return false;  // Cache miss
     }
     
-    CacheNode* node = cache[key];
+    CacheNode* node = it->second;
+    if (isExpired(node)) {
+        evict(node);
+        return false;  // Stale entry counts as a miss
+    }
+    
     value = node->value;
     moveToHead(node);  // Mark as recently used
     
@@ -54,10 +84,12 @@ void LRUCache::put(const std::string& key, const std::string& value) {
         // Key exists, update value and move to head
         CacheNode* node = cache[key];
         node->value = value;
+        node->expiresAt = timeToLiveMs > 0 ? steadyNowMs() + timeToLiveMs : 0;
         moveToHead(node);
     } else {
         // New key
         CacheNode* newNode = new CacheNode(key, value);
+        newNode->expiresAt = timeToLiveMs > 0 ? steadyNowMs() + timeToLiveMs : 0;
         cache[key] = newNode;
         addToHead(newNode);
         size++;
@@ -72,8 +104,28 @@ void LRUCache::put(const std::string& key, const std::string& value) {
     }
 }
 
+bool LRUCache::remove(const std::string& key) {
+    auto it = cache.find(key);
+    if (it == cache.end()) {
+        return false;
+    }
+    
+    evict(it->second);
+    return true;
+}
+
 bool LRUCache::contains(const std::string& key) {
-    return cache.find(key) != cache.end();
+    auto it = cache.find(key);
+    if (it == cache.end()) {
+        return false;
+    }
+    
+    if (isExpired(it->second)) {
+        evict(it->second);
+        return false;
+    }
+    
+    return true;
 }
 
 double LRUCache::calculateHitRate(int hits, int totalRequests) {
@@ -95,6 +147,20 @@ void LRUCache::clear() {
     size = 0;
 }
 
+size_t LRUCache::getMemoryBytes() const {
+    const size_t INDEX_NODE_BYTES = sizeof(void*) + sizeof(std::pair<const std::string, CacheNode*>) + sizeof(size_t);
+
+    // Two sentinels, then one list node per entry
+    size_t bytes = sizeof(LRUCache) + 2 * sizeof(CacheNode) + cache.bucket_count() * sizeof(void*);
+    for (const CacheNode* node = head->next; node != tail; node = node->next) {
+        bytes += sizeof(CacheNode) + Utils::stringHeapBytes(node->key) + Utils::stringHeapBytes(node->value);
+    }
+    for (const auto& entry : cache) {
+        bytes += INDEX_NODE_BYTES + Utils::stringHeapBytes(entry.first);
+    }
+    return bytes;
+}
+
 std::vector<std::string> LRUCache::getKeys() const {
     std::vector<std::string> keys;
     
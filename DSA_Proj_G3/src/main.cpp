@@ -1,9 +1,36 @@
 #include <iostream>
 #include <string>
+#include <vector>
 #include <fstream>
+#include <csignal>
+#include <cstdlib>
 #include "spellchecker.h"
+#include "documentchecker.h"
 #include "utils.h"
 #include "filehandler.h"
+#include "querydaemon.h"
+#include "batchprocessor.h"
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n";
+    std::cout << "\n";
+    std::cout << "Without options, starts the interactive menu.\n";
+    std::cout << "\n";
+    std::cout << "Options:\n";
+    std::cout << "  --dict <file>        Dictionary file (default: data/dictionary.txt)\n";
+    std::cout << "  --delta <file>       Apply add/remove/set lines on top of the dictionary\n";
+    std::cout << "  --check-doc <file>   Spell-check a whole document ('-' for stdin);\n";
+    std::cout << "                       misspellings are written to stdout as JSON Lines\n";
+    std::cout << "  --daemon             Load once, then answer JSON requests, one per line,\n";
+    std::cout << "                       from stdin with one JSON response line each on stdout\n";
+    std::cout << "  --socket <path>      Same, for clients of a Unix domain socket\n";
+    std::cout << "  --batch <file>       Answer one query per line ('-' for stdin); results are\n";
+    std::cout << "                       written as JSON Lines, in input order\n";
+    std::cout << "  --mode <mode>        Batch mode: autocomplete (default) or spellcheck\n";
+    std::cout << "  --threads <n>        Batch worker threads (default: one per core)\n";
+    std::cout << "  --output <file>      Batch results file (default: stdout)\n";
+    std::cout << "  --help               Show this help message\n";
+}
 
 void printMenu() {
     Utils::printSeparator(60, '=');
@@ -122,14 +149,137 @@ void handleStatistics(SpellChecker& checker) {
     std::cout << "\n";
 }
 
-int main() {
-    Utils::printHeader("SMART AUTOCOMPLETE & SPELL-CHECKER");
+int runDocumentCheck(SpellChecker& checker, const std::string& documentPath) {
+    DocumentChecker documentChecker(&checker);
     
-    // Initialize spell checker
-    SpellChecker checker(100, 10000);
+    DocumentChecker::Stats stats = documentChecker.checkFile(documentPath,
+        [](const DocumentChecker::Misspelling& misspelling) {
+            std::cout << DocumentChecker::misspellingToJSON(misspelling) << "\n";
+        });
+    std::cout.flush();
+    
+    Utils::logInfo("Checked " + Utils::formatDouble(stats.bytesProcessed / (1024.0 * 1024.0), 2) +
+                   " MB in " + Utils::formatDouble(stats.elapsedMs, 2) + " ms (" +
+                   Utils::formatDouble(stats.throughputMBps(), 2) + " MB/s)");
+    Utils::logInfo("Tokens: " + std::to_string(stats.tokensChecked) +
+                   ", unique lookups: " + std::to_string(stats.uniqueLookups) +
+                   ", misspellings: " + std::to_string(stats.misspellings));
+    
+    return 0;
+}
+
+void stopDaemon(int) {
+    QueryDaemon::stop();
+}
+
+int runDaemon(SpellChecker& checker, const std::string& socketPath) {
+    QueryDaemon daemon(&checker);
+    
+    if (socketPath.empty()) {
+        size_t answered = daemon.serveStream(std::cin, std::cout);
+        Utils::logInfo("Input closed after " + std::to_string(answered) + " requests");
+        return 0;
+    }
+    
+    std::signal(SIGINT, stopDaemon);
+    std::signal(SIGTERM, stopDaemon);
+    return daemon.serveSocket(socketPath) ? 0 : 1;
+}
+
+int runBatch(SpellChecker& checker, const std::string& queryPath, BatchProcessor::Mode mode,
+             int threads, const std::string& outputPath) {
+    std::ofstream outputFile;
+    if (!outputPath.empty()) {
+        outputFile.open(outputPath);
+        if (!outputFile.is_open()) {
+            Utils::logError("Cannot open output file: " + outputPath);
+            return 1;
+        }
+    }
+    std::ostream& output = outputPath.empty() ? std::cout : outputFile;
+    
+    BatchProcessor processor(&checker, threads);
+    BatchProcessor::Stats stats = processor.processFile(queryPath, output, mode);
     
-    // Load dictionary
+    Utils::logInfo("Answered " + std::to_string(stats.queries) + " queries in " +
+                   Utils::formatDouble(stats.elapsedMs, 2) + " ms on " + std::to_string(stats.threads) +
+                   " threads (" + Utils::formatDouble(stats.queriesPerSecond(), 0) + " queries/s)");
+    
+    return output.good() ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
     std::string dictFile = "data/dictionary.txt";
+    std::string documentPath;
+    std::string socketPath;
+    bool daemon = false;
+    std::string batchPath;
+    std::string outputPath;
+    BatchProcessor::Mode batchMode = BatchProcessor::AUTOCOMPLETE;
+    int batchThreads = 0;
+    std::vector<std::string> deltaFiles;
+    
+    // Parse command-line options
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        
+        if (arg == "--dict" && i + 1 < argc) {
+            dictFile = argv[++i];
+        }
+        else if (arg == "--delta" && i + 1 < argc) {
+            deltaFiles.push_back(argv[++i]);
+        }
+        else if (arg == "--check-doc" && i + 1 < argc) {
+            documentPath = argv[++i];
+        }
+        else if (arg == "--daemon") {
+            daemon = true;
+        }
+        else if (arg == "--socket" && i + 1 < argc) {
+            daemon = true;
+            socketPath = argv[++i];
+        }
+        else if (arg == "--batch" && i + 1 < argc) {
+            batchPath = argv[++i];
+        }
+        else if (arg == "--mode" && i + 1 < argc) {
+            if (!BatchProcessor::parseMode(argv[++i], batchMode)) {
+                Utils::logError("Unknown mode: " + std::string(argv[i]) + " (use autocomplete or spellcheck)");
+                return 1;
+            }
+        }
+        else if (arg == "--threads" && i + 1 < argc) {
+            batchThreads = std::atoi(argv[++i]);
+            if (batchThreads < 0) {
+                Utils::logError("Invalid thread count: " + std::string(argv[i]));
+                return 1;
+            }
+        }
+        else if (arg == "--output" && i + 1 < argc) {
+            outputPath = argv[++i];
+        }
+        else if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        else {
+            Utils::logError("Unknown or incomplete option: " + arg);
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    
+    bool interactive = documentPath.empty() && !daemon && batchPath.empty();
+    
+    // Non-interactive modes keep stdout for results only
+    if (!interactive) {
+        Utils::setLogToStderr(true);
+    } else {
+        Utils::printHeader("SMART AUTOCOMPLETE & SPELL-CHECKER");
+    }
+    
+    // Initialize spell checker
+    SpellChecker checker(100, 10000);
     
     Utils::logInfo("Initializing system...");
     
@@ -185,6 +335,23 @@ int main() {
         return 1;
     }
     
+    // Deltas apply in command-line order
+    for (const std::string& deltaFile : deltaFiles) {
+        checker.applyDelta(deltaFile);
+    }
+    
+    if (!documentPath.empty()) {
+        return runDocumentCheck(checker, documentPath);
+    }
+    
+    if (daemon) {
+        return runDaemon(checker, socketPath);
+    }
+    
+    if (!batchPath.empty()) {
+        return runBatch(checker, batchPath, batchMode, batchThreads, outputPath);
+    }
+    
     Utils::logInfo("System ready! Type 'help' for commands or use menu.");
     std::cout << "\n";
     
@@ -0,0 +1,293 @@
+#include "metrics.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <iomanip>
+
+// ==================== COUNTER ====================
+
+namespace {
+    // Threads take shards round-robin on first use
+    std::atomic<int> nextShard(0);
+
+    int threadShard(int shards) {
+        thread_local int shard = nextShard.fetch_add(1, std::memory_order_relaxed);
+        return shard % shards;
+    }
+}
+
+Metrics::Counter::Counter() {
+    reset();
+}
+
+void Metrics::Counter::add(uint64_t amount) {
+    shards[threadShard(SHARDS)].value.fetch_add(amount, std::memory_order_relaxed);
+}
+
+uint64_t Metrics::Counter::value() const {
+    uint64_t total = 0;
+    for (const Shard& shard : shards) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void Metrics::Counter::reset() {
+    for (Shard& shard : shards) {
+        shard.value.store(0, std::memory_order_relaxed);
+    }
+}
+
+// ==================== HISTOGRAM ====================
+
+Metrics::Histogram::Histogram() {
+    reset();
+}
+
+int Metrics::Histogram::bucketIndex(uint64_t nanoseconds) {
+    // Below 2 * SUB_BUCKETS every value has its own bucket
+    if (nanoseconds < static_cast<uint64_t>(2 * SUB_BUCKETS)) {
+        return static_cast<int>(nanoseconds);
+    }
+
+    int magnitude = 63 - __builtin_clzll(nanoseconds);
+    if (magnitude > MAX_MAGNITUDE) {
+        return BUCKETS - 1;
+    }
+    int shift = magnitude - SUB_BUCKET_BITS;
+    return (shift + 1) * SUB_BUCKETS + static_cast<int>((nanoseconds >> shift) - SUB_BUCKETS);
+}
+
+uint64_t Metrics::Histogram::bucketLowerBound(int index) {
+    if (index < 2 * SUB_BUCKETS) {
+        return index;
+    }
+    int shift = index / SUB_BUCKETS - 1;
+    return static_cast<uint64_t>(SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+}
+
+uint64_t Metrics::Histogram::bucketUpperBound(int index) {
+    if (index < 2 * SUB_BUCKETS) {
+        return index + 1;
+    }
+    int shift = index / SUB_BUCKETS - 1;
+    return bucketLowerBound(index) + (uint64_t(1) << shift);
+}
+
+void Metrics::Histogram::record(uint64_t nanoseconds) {
+    buckets[bucketIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sumNs.fetch_add(nanoseconds, std::memory_order_relaxed);
+}
+
+void Metrics::Histogram::recordSince(std::chrono::steady_clock::time_point start) {
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+}
+
+uint64_t Metrics::Histogram::valueAtQuantile(double quantile) const {
+    uint64_t total = 0;
+    uint64_t snapshot[BUCKETS];
+    for (int i = 0; i < BUCKETS; i++) {
+        snapshot[i] = buckets[i].load(std::memory_order_relaxed);
+        total += snapshot[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    // Rank of the quantile, at least the first value
+    uint64_t rank = static_cast<uint64_t>(quantile * total + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > total) rank = total;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; i++) {
+        seen += snapshot[i];
+        if (seen >= rank) {
+            return bucketUpperBound(i);
+        }
+    }
+    return bucketUpperBound(BUCKETS - 1);
+}
+
+uint64_t Metrics::Histogram::countAtOrBelow(uint64_t nanoseconds) const {
+    uint64_t total = 0;
+    for (int i = 0; i < BUCKETS && bucketUpperBound(i) <= nanoseconds + 1; i++) {
+        total += buckets[i].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void Metrics::Histogram::reset() {
+    for (std::atomic<uint64_t>& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    sumNs.store(0, std::memory_order_relaxed);
+}
+
+// ==================== REGISTRY ====================
+
+namespace {
+    struct Family {
+        std::string help;
+        std::string type;  // counter, gauge or histogram
+        std::map<std::string, std::unique_ptr<Metrics::Counter>> counters;
+        std::map<std::string, std::unique_ptr<Metrics::Gauge>> gauges;
+        std::map<std::string, std::unique_ptr<Metrics::Histogram>> histograms;
+    };
+
+    // Leaked on purpose: metrics may be recorded during static destruction
+    std::mutex& registryMutex() {
+        static std::mutex* mutex = new std::mutex();
+        return *mutex;
+    }
+
+    std::map<std::string, Family>& registry() {
+        static std::map<std::string, Family>* families = new std::map<std::string, Family>();
+        return *families;
+    }
+
+    // Exposed "le" bounds, in seconds
+    const double BUCKET_BOUNDS[] = {
+        0.00001, 0.000025, 0.00005, 0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005,
+        0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10
+    };
+    const double QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+
+    std::string withLabel(const std::string& labels, const std::string& extra) {
+        if (labels.empty()) return "{" + extra + "}";
+        return "{" + labels + "," + extra + "}";
+    }
+
+    std::string braced(const std::string& labels) {
+        return labels.empty() ? "" : "{" + labels + "}";
+    }
+
+    std::string quantileFamily(const std::string& name) {
+        const std::string unit = "_seconds";
+        if (name.size() > unit.size() && name.compare(name.size() - unit.size(), unit.size(), unit) == 0) {
+            return name.substr(0, name.size() - unit.size()) + "_quantile" + unit;
+        }
+        return name + "_quantile";
+    }
+}
+
+Metrics::Counter& Metrics::counter(const std::string& name, const std::string& labels,
+                                   const std::string& help) {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    Family& family = registry()[name];
+    if (family.help.empty()) {
+        family.help = help;
+        family.type = "counter";
+    }
+    std::unique_ptr<Counter>& metric = family.counters[labels];
+    if (!metric) {
+        metric.reset(new Counter());
+    }
+    return *metric;
+}
+
+Metrics::Gauge& Metrics::gauge(const std::string& name, const std::string& labels,
+                               const std::string& help) {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    Family& family = registry()[name];
+    if (family.help.empty()) {
+        family.help = help;
+        family.type = "gauge";
+    }
+    std::unique_ptr<Gauge>& metric = family.gauges[labels];
+    if (!metric) {
+        metric.reset(new Gauge());
+    }
+    return *metric;
+}
+
+Metrics::Histogram& Metrics::histogram(const std::string& name, const std::string& labels,
+                                       const std::string& help) {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    Family& family = registry()[name];
+    if (family.help.empty()) {
+        family.help = help;
+        family.type = "histogram";
+    }
+    std::unique_ptr<Histogram>& metric = family.histograms[labels];
+    if (!metric) {
+        metric.reset(new Histogram());
+    }
+    return *metric;
+}
+
+Metrics::Histogram& Metrics::stage(const std::string& stageName) {
+    return histogram("autocomplete_stage_duration_seconds", "stage=" + labelValue(stageName),
+                     "Time spent in each engine stage (cache, trie, bktree, upstream)");
+}
+
+std::string Metrics::labelValue(const std::string& value) {
+    std::string quoted = "\"";
+    for (char ch : value) {
+        if (ch == '\\' || ch == '"') {
+            quoted += '\\';
+            quoted += ch;
+        } else if (ch == '\n') {
+            quoted += "\\n";
+        } else {
+            quoted += ch;
+        }
+    }
+    return quoted + "\"";
+}
+
+std::string Metrics::exposition() {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    std::ostringstream out;
+    out << std::setprecision(9);
+
+    for (const auto& entry : registry()) {
+        const std::string& name = entry.first;
+        const Family& family = entry.second;
+
+        out << "# HELP " << name << " " << family.help << "\n";
+        out << "# TYPE " << name << " " << family.type << "\n";
+
+        for (const auto& counter : family.counters) {
+            out << name << braced(counter.first) << " " << counter.second->value() << "\n";
+        }
+
+        for (const auto& gauge : family.gauges) {
+            out << name << braced(gauge.first) << " " << gauge.second->value() << "\n";
+        }
+
+        for (const auto& metric : family.histograms) {
+            const std::string& labels = metric.first;
+            const Histogram& histogram = *metric.second;
+            for (double bound : BUCKET_BOUNDS) {
+                std::ostringstream le;
+                le << "le=\"" << bound << "\"";
+                out << name << "_bucket" << withLabel(labels, le.str()) << " "
+                    << histogram.countAtOrBelow(static_cast<uint64_t>(bound * 1e9)) << "\n";
+            }
+            out << name << "_bucket" << withLabel(labels, "le=\"+Inf\"") << " " << histogram.getCount() << "\n";
+            out << name << "_sum" << braced(labels) << " " << histogram.getSumNs() / 1e9 << "\n";
+            out << name << "_count" << braced(labels) << " " << histogram.getCount() << "\n";
+        }
+
+        if (family.type == "histogram") {
+            std::string quantiles = quantileFamily(name);
+            out << "# HELP " << quantiles << " Quantiles of " << name << " (within 6.25%)\n";
+            out << "# TYPE " << quantiles << " gauge\n";
+            for (const auto& metric : family.histograms) {
+                for (double quantile : QUANTILES) {
+                    std::ostringstream label;
+                    label << "quantile=\"" << quantile << "\"";
+                    out << quantiles << withLabel(metric.first, label.str()) << " "
+                        << metric.second->valueAtQuantile(quantile) / 1e9 << "\n";
+                }
+            }
+        }
+    }
+
+    return out.str();
+}
@@ -0,0 +1,320 @@
+#include "querydaemon.h"
+#include "spellchecker.h"
+#include "filehandler.h"
+#include "jsonwriter.h"
+#include "jsonreader.h"
+#include "utils.h"
+#include <vector>
+#include <csignal>
+#include <cerrno>
+#include <cstring>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // Corrections per spell check, as in the interactive CLI
+    const int MAX_CORRECTIONS = 5;
+
+    volatile std::sig_atomic_t stopRequested = 0;
+
+    // A client whose unanswered partial line grows past this is dropped
+    const size_t MAX_PENDING_INPUT_BYTES = 1024 * 1024;
+
+    // Requests from a client are not read while this much of its output is unsent
+    const size_t MAX_QUEUED_OUTPUT_BYTES = 1024 * 1024;
+
+    struct Client {
+        std::string input;     // Received, not yet a complete line
+        std::string output;    // Answered, not yet sent
+        bool inputClosed;      // Peer shut down its side; close once output is sent
+
+        Client() : inputClosed(false) {}
+    };
+
+    /**
+     * Fields of a request object in one pass: strings decoded, other
+     * values (e.g. a numeric id) kept as written
+     */
+    bool parseRequest(const std::string& line, std::string& query, std::string& mode,
+                      bool& hasMode, std::string& id) {
+        JSONReader json(line);
+        if (!json.beginObject()) return false;
+
+        std::string key;
+        while (json.nextMember(key)) {
+            std::string* field = key == "query" ? &query
+                               : key == "mode"  ? &mode
+                               : key == "id"    ? &id : nullptr;
+            if (field == nullptr) {
+                json.skipValue();
+            } else if (json.peek() == JSONReader::STRING) {
+                json.readString(*field);
+            } else {
+                field->assign(json.rawValue());
+            }
+            hasMode = hasMode || key == "mode";
+        }
+        return json.finish();
+    }
+
+    // Open a response object with "id" first
+    void beginResponse(JSONWriter& json, const std::string& id) {
+        json.beginObject();
+        if (!id.empty()) {
+            json.field("id", id);
+        }
+    }
+
+    std::string errorResponse(const std::string& id, const std::string& message) {
+        std::string out;
+        JSONWriter json(out, JSONWriter::SPACED);
+        beginResponse(json, id);
+        json.field("error", message);
+        json.endObject();
+        return out;
+    }
+}
+
+QueryDaemon::QueryDaemon(SpellChecker* spellChecker, int maxSuggestions)
+    : checker(spellChecker), maxResults(maxSuggestions), requests(0) {
+}
+
+std::string QueryDaemon::handleRequest(const std::string& line) {
+    requests++;
+
+    std::string query;
+    std::string mode;
+    std::string id;
+    bool hasMode = false;
+    if (!parseRequest(line, query, mode, hasMode, id)) {
+        return errorResponse("", "Malformed JSON request");
+    }
+    if (!hasMode) {
+        mode = "autocomplete";
+    }
+
+    if (query.empty()) {
+        return errorResponse(id, "Missing query");
+    }
+
+    Utils::Timer timer;
+    timer.start();
+
+    std::string out;
+    JSONWriter json(out, JSONWriter::SPACED);
+
+    if (mode == "autocomplete") {
+        int hitsBefore, misses, hitsAfter;
+        double hitRate;
+        checker->getCacheStats(hitsBefore, misses, hitRate);
+        std::vector<std::string> suggestions = checker->autocomplete(query, maxResults);
+        checker->getCacheStats(hitsAfter, misses, hitRate);
+        timer.stop();
+
+        beginResponse(json, id);
+        FileHandler::appendAutocompleteFields(json, query, suggestions, timer.elapsedMilliseconds(),
+                                              hitsAfter > hitsBefore, {"Trie", "LRU Cache", "Priority Queue"});
+        json.endObject();
+        return out;
+    }
+
+    if (mode == "spellcheck") {
+        bool isCorrect = checker->checkSpelling(query);
+        std::vector<std::string> corrections;
+        if (!isCorrect) {
+            corrections = checker->getCorrections(query, 2, MAX_CORRECTIONS);
+        }
+        timer.stop();
+
+        beginResponse(json, id);
+        FileHandler::appendSpellCheckFields(json, query, isCorrect, corrections, timer.elapsedMilliseconds());
+        json.endObject();
+        return out;
+    }
+
+    if (mode == "select") {
+        bool learned = checker->updateFrequency(query);
+        beginResponse(json, id);
+        json.field("type", "select").field("query", query).field("learned", learned);
+        json.endObject();
+        return out;
+    }
+
+    return errorResponse(id, "Invalid mode (use 'autocomplete', 'spellcheck' or 'select')");
+}
+
+size_t QueryDaemon::serveStream(std::istream& in, std::ostream& out) {
+    size_t answered = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (Utils::trim(line).empty()) continue;
+        out << handleRequest(line) << "\n";
+        out.flush();
+        answered++;
+    }
+    return answered;
+}
+
+void QueryDaemon::stop() {
+    stopRequested = 1;
+}
+
+#ifdef _WIN32
+
+bool QueryDaemon::serveSocket(const std::string& path) {
+    Utils::logError("Unix domain sockets are not supported on this platform: " + path);
+    return false;
+}
+
+#else
+
+bool QueryDaemon::serveSocket(const std::string& path) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        Utils::logError("Invalid socket path: " + path);
+        return false;
+    }
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    // Only a socket left over from a previous run is replaced; any other
+    // file at the path (e.g. a mistyped dictionary path) is left alone
+    struct stat existing;
+    if (lstat(path.c_str(), &existing) == 0) {
+        if (!S_ISSOCK(existing.st_mode)) {
+            Utils::logError("Not a socket, refusing to replace: " + path);
+            return false;
+        }
+        unlink(path.c_str());
+    }
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        Utils::logError("Cannot create socket: " + std::string(std::strerror(errno)));
+        return false;
+    }
+
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        listen(listener, 16) < 0) {
+        Utils::logError("Cannot listen on " + path + ": " + std::strerror(errno));
+        close(listener);
+        return false;
+    }
+    Utils::logInfo("Query daemon listening on " + path);
+
+    // Answer every complete line, in order, into the client's output queue
+    auto answerLines = [this](Client& client) {
+        size_t start = 0;
+        size_t end;
+        while ((end = client.input.find('\n', start)) != std::string::npos) {
+            std::string line = client.input.substr(start, end - start);
+            if (!Utils::trim(line).empty()) {
+                client.output += handleRequest(line);
+                client.output += '\n';
+            }
+            start = end + 1;
+        }
+        client.input.erase(0, start);
+    };
+
+    // Slot 0 is the listener; clients[i] belongs to sockets[i]
+    std::vector<pollfd> sockets(1, pollfd{listener, POLLIN, 0});
+    std::vector<Client> clients(1);
+    char buffer[16384];
+
+    stopRequested = 0;
+    while (!stopRequested) {
+        int ready = poll(sockets.data(), sockets.size(), 500);
+        if (ready < 0 && errno != EINTR) {
+            Utils::logError("poll failed: " + std::string(std::strerror(errno)));
+            break;
+        }
+        if (ready <= 0) continue;
+
+        if (sockets[0].revents & POLLIN) {
+            int client = accept(listener, nullptr, nullptr);
+            if (client >= 0) {
+                // Non-blocking: a client that stops reading must not stall the others
+                fcntl(client, F_SETFL, fcntl(client, F_GETFL, 0) | O_NONBLOCK);
+                sockets.push_back(pollfd{client, POLLIN, 0});
+                clients.push_back(Client());
+            }
+        }
+
+        for (size_t i = 1; i < sockets.size(); i++) {
+            short events = sockets[i].revents;
+            if (events == 0) continue;
+
+            Client& client = clients[i];
+            bool open = (events & POLLNVAL) == 0;
+
+            if (open && (events & (POLLIN | POLLHUP | POLLERR)) && !client.inputClosed) {
+                ssize_t received = recv(sockets[i].fd, buffer, sizeof(buffer), 0);
+                if (received > 0) {
+                    client.input.append(buffer, received);
+                    answerLines(client);
+
+                    if (client.input.size() > MAX_PENDING_INPUT_BYTES) {
+                        Utils::logError("Query daemon client sent a line over " +
+                                        std::to_string(MAX_PENDING_INPUT_BYTES) + " bytes; dropped");
+                        open = false;
+                    }
+                } else if (received == 0) {
+                    client.inputClosed = true;  // Answers still owed are sent first
+                } else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                    open = false;
+                }
+            }
+
+            // Send what the socket takes now; the rest waits for POLLOUT
+            while (open && !client.output.empty()) {
+                ssize_t sent = send(sockets[i].fd, client.output.data(), client.output.size(), MSG_NOSIGNAL);
+                if (sent > 0) {
+                    client.output.erase(0, sent);
+                } else {
+                    open = sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR);
+                    break;
+                }
+            }
+
+            if (open && client.inputClosed && client.output.empty()) {
+                open = false;
+            }
+
+            if (!open) {
+                close(sockets[i].fd);
+                sockets.erase(sockets.begin() + i);
+                clients.erase(clients.begin() + i);
+                i--;
+                continue;
+            }
+
+            // Stop reading from a client that does not read its answers
+            sockets[i].events = 0;
+            if (!client.inputClosed && client.output.size() < MAX_QUEUED_OUTPUT_BYTES) {
+                sockets[i].events |= POLLIN;
+            }
+            if (!client.output.empty()) {
+                sockets[i].events |= POLLOUT;
+            }
+        }
+    }
+
+    for (size_t i = 1; i < sockets.size(); i++) {
+        close(sockets[i].fd);
+    }
+    close(listener);
+    unlink(path.c_str());
+    Utils::logInfo("Query daemon stopped after " + std::to_string(requests) + " requests");
+    return true;
+}
+
+#endif
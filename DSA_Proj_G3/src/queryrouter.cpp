@@ -0,0 +1,366 @@
+#include "queryrouter.h"
+#include "priorityqueue.h"
+#include "sort.h"
+#include "utils.h"
+#include "metrics.h"
+#include "tracing.h"
+#include <cstdlib>
+#include <cmath>
+
+namespace {
+    // Reciprocal rank fusion constant: damps the advantage of the top rank
+    const double RRF_K = 60.0;
+
+    // Fused scores are reported as integers: score = RRF * SCORE_SCALE
+    const double SCORE_SCALE = 10000.0;
+
+    // Prefixes tracked for prefetching before the least popular are dropped
+    const size_t MAX_TRACKED_PREFIXES = 10000;
+}
+
+// ==================== Configuration ====================
+
+QueryRouter::Config::Config()
+    : mode(Mode::LocalFirst), remoteBudgetMs(25), maxSuggestions(10), maxCorrections(5),
+      prefetchIntervalMs(30000), prefetchCount(32) {
+}
+
+QueryRouter::Config QueryRouter::Config::fromEnvironment() {
+    Config config;
+
+    const char* routing = std::getenv("AUTOCOMPLETE_ROUTING");
+    if (routing != nullptr && *routing != '\0') {
+        config.mode = parseMode(routing);
+    }
+
+    // 0 is valid: local answer plus whatever is already cached
+    const char* budget = std::getenv("AUTOCOMPLETE_REMOTE_BUDGET_MS");
+    if (budget != nullptr && *budget != '\0' && std::atoi(budget) >= 0) {
+        config.remoteBudgetMs = std::atoi(budget);
+    }
+
+    return config;
+}
+
+QueryRouter::Mode QueryRouter::parseMode(const std::string& name) {
+    if (Utils::toLower(name) == "remote-first") {
+        return Mode::RemoteFirst;
+    }
+    if (Utils::toLower(name) != "local-first") {
+        Utils::logWarning("Unknown routing mode '" + name + "', using local-first");
+    }
+    return Mode::LocalFirst;
+}
+
+const char* QueryRouter::modeName(Mode mode) {
+    return mode == Mode::RemoteFirst ? "remote-first" : "local-first";
+}
+
+// ==================== Lifecycle ====================
+
+QueryRouter::QueryRouter(DictionaryManager* dictionaries, UpstreamClient* client,
+                         const Config& routerConfig)
+    : dictionary(dictionaries), upstream(client), config(routerConfig), stopping(false) {
+    if (config.prefetchIntervalMs > 0 && config.prefetchCount > 0) {
+        prefetcher = std::thread(&QueryRouter::prefetchLoop, this);
+    }
+}
+
+QueryRouter::~QueryRouter() {
+    {
+        std::lock_guard<std::mutex> lock(prefetchMutex);
+        stopping = true;
+    }
+    prefetchWake.notify_all();
+
+    if (prefetcher.joinable()) {
+        prefetcher.join();
+    }
+}
+
+// ==================== Prefetching ====================
+
+void QueryRouter::recordQuery(const std::string& prefix) {
+    std::lock_guard<std::mutex> lock(popularityMutex);
+
+    // Unbounded key sets (typos, random input) must not grow forever
+    if (popularity.size() >= MAX_TRACKED_PREFIXES && popularity.find(prefix) == popularity.end()) {
+        for (auto it = popularity.begin(); it != popularity.end();) {
+            it = it->second <= 1 ? popularity.erase(it) : std::next(it);
+        }
+        if (popularity.size() >= MAX_TRACKED_PREFIXES) return;
+    }
+
+    popularity[prefix]++;
+}
+
+int QueryRouter::prefetchPopular() {
+    PriorityQueue ranking;
+    {
+        std::lock_guard<std::mutex> lock(popularityMutex);
+        std::vector<std::pair<std::string, int>> counts(popularity.begin(), popularity.end());
+        ranking.buildHeap(counts);
+
+        // Halve the counts so popularity follows recent traffic
+        for (auto it = popularity.begin(); it != popularity.end();) {
+            it->second /= 2;
+            it = it->second == 0 ? popularity.erase(it) : std::next(it);
+        }
+    }
+
+    int started = 0;
+    for (const auto& entry : ranking.extractTopK(config.prefetchCount)) {
+        if (upstream->prefetchAutocomplete(entry.first, config.maxSuggestions)) {
+            started++;
+        }
+    }
+    return started;
+}
+
+void QueryRouter::prefetchLoop() {
+    std::unique_lock<std::mutex> lock(prefetchMutex);
+
+    while (!stopping) {
+        prefetchWake.wait_for(lock, std::chrono::milliseconds(config.prefetchIntervalMs));
+        if (stopping) break;
+
+        lock.unlock();
+        prefetchPopular();
+        lock.lock();
+    }
+}
+
+// ==================== Merging ====================
+
+std::vector<std::pair<std::string, int>> QueryRouter::mergeRanked(
+    const std::vector<std::pair<std::string, int>>& local,
+    const std::vector<std::pair<std::string, int>>& remote,
+    int maxResults) {
+
+    Tracing::Span span("rank");
+    std::vector<std::string> words;                 // First-seen spelling
+    std::unordered_map<std::string, size_t> index;  // Lowercase word -> position
+    std::vector<double> fused;
+
+    const std::vector<std::pair<std::string, int>>* lists[] = {&local, &remote};
+    for (const auto* list : lists) {
+        for (size_t rank = 0; rank < list->size(); rank++) {
+            const std::string& word = (*list)[rank].first;
+            std::string key = Utils::toLower(word);
+
+            auto found = index.find(key);
+            if (found == index.end()) {
+                found = index.emplace(key, words.size()).first;
+                words.push_back(word);
+                fused.push_back(0.0);
+            }
+            fused[found->second] += 1.0 / (RRF_K + rank + 1);
+        }
+    }
+
+    std::vector<std::pair<std::string, int>> merged;
+    for (size_t i = 0; i < words.size(); i++) {
+        merged.push_back({words[i], static_cast<int>(std::lround(fused[i] * SCORE_SCALE))});
+    }
+
+    SortAlgorithms::sortByFrequency(merged);
+
+    if (merged.size() > static_cast<size_t>(maxResults)) {
+        merged.resize(maxResults);
+    }
+    return merged;
+}
+
+// ==================== Routing ====================
+
+std::vector<std::pair<std::string, int>> QueryRouter::localCorrections(DictionaryIndex& index,
+                                                                       const std::string& word) {
+    auto corrections = index.getSpellChecker()->getCorrections(word, 2, config.maxCorrections);
+    std::vector<std::pair<std::string, int>> scored;
+    for (size_t i = 0; i < corrections.size(); i++) {
+        scored.push_back(std::make_pair(corrections[i], 10 - static_cast<int>(i)));
+    }
+    return scored;
+}
+
+namespace {
+    Metrics::Histogram& upstreamStage = Metrics::stage("upstream");
+}
+
+/**
+ * Wait for an upstream answer; the wait is what a query pays for the
+ * remote APIs, so it is timed as the upstream stage
+ */
+template <typename Result>
+static Result awaitUpstream(std::future<Result>& pending, UpstreamClient::Deadline deadline) {
+    Metrics::ScopedTimer timer(upstreamStage);
+    Tracing::Span span("upstream");
+    return UpstreamClient::await(pending, deadline);
+}
+
+static std::vector<std::pair<std::string, int>> toPairs(
+    const std::vector<APIFetcher::WordSuggestion>& suggestions, int maxResults) {
+    std::vector<std::pair<std::string, int>> pairs;
+    for (size_t i = 0; i < suggestions.size() && i < static_cast<size_t>(maxResults); i++) {
+        pairs.push_back(std::make_pair(suggestions[i].word, suggestions[i].score));
+    }
+    return pairs;
+}
+
+QueryRouter::Answer QueryRouter::autocomplete(const std::string& prefix) {
+    // One key for popularity, the live fetch and the prefetcher, so "Hel"
+    // is served from the upstream entry prefetching "hel" warmed
+    std::string key = Utils::toLower(prefix);
+    recordQuery(key);
+
+    // Held until the answer is built, even if a reload publishes meanwhile
+    std::shared_ptr<DictionaryIndex> index = dictionary->acquire();
+    if (!index) {
+        Answer answer;
+        answer.source = "unavailable";
+        return answer;
+    }
+
+    return config.mode == Mode::LocalFirst ? autocompleteLocalFirst(*index, key)
+                                           : autocompleteRemoteFirst(*index, key);
+}
+
+QueryRouter::Answer QueryRouter::spellcheck(const std::string& word) {
+    std::shared_ptr<DictionaryIndex> index = dictionary->acquire();
+    if (!index) {
+        Answer answer;
+        answer.source = "unavailable";
+        return answer;
+    }
+
+    return config.mode == Mode::LocalFirst ? spellcheckLocalFirst(*index, word)
+                                           : spellcheckRemoteFirst(*index, word);
+}
+
+QueryRouter::Answer QueryRouter::autocompleteLocalFirst(DictionaryIndex& index, const std::string& prefix) {
+    auto budget = UpstreamClient::Clock::now() + std::chrono::milliseconds(config.remoteBudgetMs);
+
+    // The remote call keeps its full deadline so a late answer still fills the cache
+    auto pending = upstream->fetchAutocompleteAsync(prefix, config.maxSuggestions,
+                                                    upstream->defaultDeadline());
+
+    Answer answer;
+    answer.suggestions = index.getEngine()->getSuggestions(prefix);
+    answer.source = "local";
+
+    auto remote = awaitUpstream(pending, budget);
+    if (remote.ok && !remote.suggestions.empty()) {
+        auto remotePairs = toPairs(remote.suggestions, config.maxSuggestions);
+        if (answer.suggestions.empty()) {
+            answer.suggestions = remotePairs;
+            answer.source = "datamuse-api";
+        } else {
+            answer.suggestions = mergeRanked(answer.suggestions, remotePairs, config.maxSuggestions);
+            answer.source = "local+datamuse";
+        }
+    }
+
+    return answer;
+}
+
+QueryRouter::Answer QueryRouter::autocompleteRemoteFirst(DictionaryIndex& index, const std::string& prefix) {
+    auto deadline = upstream->defaultDeadline();
+    auto pending = upstream->fetchAutocompleteAsync(prefix, config.maxSuggestions, deadline);
+    auto remote = awaitUpstream(pending, deadline);
+
+    Answer answer;
+    if (!remote.ok || remote.suggestions.empty()) {
+        // Fallback to local Trie if API fails
+        if (!remote.ok) {
+            Utils::logWarning("API unavailable (" + remote.error + "), using local Trie");
+        }
+        answer.suggestions = index.getEngine()->getSuggestions(prefix);
+        answer.source = "local";
+    } else {
+        answer.suggestions = toPairs(remote.suggestions, config.maxSuggestions);
+        answer.source = "datamuse-api";
+    }
+
+    return answer;
+}
+
+QueryRouter::Answer QueryRouter::spellcheckLocalFirst(DictionaryIndex& index, const std::string& word) {
+    Answer answer;
+
+    // Words in the local dictionary need no confirmation
+    if (index.getSpellChecker()->checkSpelling(word)) {
+        answer.isCorrect = true;
+        answer.source = "local";
+        return answer;
+    }
+
+    auto budget = UpstreamClient::Clock::now() + std::chrono::milliseconds(config.remoteBudgetMs);
+    auto deadline = upstream->defaultDeadline();
+    auto pendingDefinition = upstream->fetchDefinitionAsync(word, deadline);
+    auto pendingCorrections = upstream->fetchSpellingAsync(word, 10, deadline);
+
+    // BK-Tree search overlaps with the remote calls
+    answer.suggestions = localCorrections(index, word);
+    answer.source = "local";
+
+    // The remote dictionary is larger: it may know the word
+    auto definition = awaitUpstream(pendingDefinition, budget);
+    if (definition.ok && definition.entry.found) {
+        answer.isCorrect = true;
+        answer.suggestions.clear();
+        answer.source = "dictionaryapi";
+        return answer;
+    }
+
+    auto remote = awaitUpstream(pendingCorrections, budget);
+    if (remote.ok && !remote.suggestions.empty()) {
+        auto remotePairs = toPairs(remote.suggestions, config.maxCorrections);
+        if (answer.suggestions.empty()) {
+            answer.suggestions = remotePairs;
+            answer.source = "datamuse-api";
+        } else {
+            answer.suggestions = mergeRanked(answer.suggestions, remotePairs, config.maxCorrections);
+            answer.source = "local+datamuse";
+        }
+    }
+
+    return answer;
+}
+
+QueryRouter::Answer QueryRouter::spellcheckRemoteFirst(DictionaryIndex& index, const std::string& word) {
+    // Definition and corrections are requested together so a
+    // misspelled word costs one round trip, not two
+    auto deadline = upstream->defaultDeadline();
+    auto pendingDefinition = upstream->fetchDefinitionAsync(word, deadline);
+    auto pendingCorrections = upstream->fetchSpellingAsync(word, 10, deadline);
+
+    Answer answer;
+    auto definition = awaitUpstream(pendingDefinition, deadline);
+
+    if (!definition.ok) {
+        // Dictionary API unavailable: answer from the local dictionary
+        Utils::logWarning("API unavailable (" + definition.error + "), using local dictionary");
+        answer.isCorrect = index.getSpellChecker()->checkSpelling(word);
+        if (!answer.isCorrect) {
+            answer.suggestions = localCorrections(index, word);
+        }
+        answer.source = "local";
+    } else if (!definition.entry.found) {
+        auto remote = awaitUpstream(pendingCorrections, deadline);
+
+        if (!remote.ok || remote.suggestions.empty()) {
+            // Fallback to local BK-Tree
+            Utils::logWarning("API failed, using local BK-Tree");
+            answer.suggestions = localCorrections(index, word);
+            answer.source = "local";
+        } else {
+            answer.suggestions = toPairs(remote.suggestions, config.maxCorrections);
+            answer.source = "datamuse-api";
+        }
+    } else {
+        answer.isCorrect = true;
+        answer.source = "dictionaryapi";
+    }
+
+    return answer;
+}
@@ -9,20 +9,27 @@
  * - HTTP server for frontend connectivity
  * 
  * Endpoints:
- * - POST /query - Get autocomplete/spellcheck suggestions
+ * - POST /query - Get autocomplete/spellcheck suggestions, or record a
+ *   selected suggestion (mode "select")
  * - GET /health - Server health check
+ * - GET /metrics - Request and engine-stage latency (Prometheus format)
+ * - POST /admin/reload - Reload the dictionary (localhost only; or SIGHUP)
+ * - POST /admin/delta - Apply add/remove/set lines to the live dictionary
+ * - GET /admin/trace - Buffered stage spans as Chrome trace JSON; POST
+ *   "on" / "off" / "clear" controls recording (localhost only)
  */
 
 #include <iostream>
 #include <csignal>
+#include <cstdlib>
 #include "httpserver.h"
-#include "autocomplete.h"
-#include "spellchecker.h"
-#include "filehandler.h"
+#include "dictionaryindex.h"
 #include "utils.h"
+#include "tracing.h"
 
-// Global server pointer for signal handling
+// Global pointers for signal handling
 HTTPServer* globalServer = nullptr;
+DictionaryManager* globalDictionaries = nullptr;
 
 void signalHandler(int signal) {
     if (signal == SIGINT) {
@@ -31,47 +38,60 @@ void signalHandler(int signal) {
             globalServer->stop();
         }
     }
+#ifdef SIGHUP
+    else if (signal == SIGHUP) {
+        // Only sets a flag; the reload runs on the manager's thread
+        if (globalDictionaries) {
+            globalDictionaries->requestReload();
+        }
+    }
+#endif
 }
 
 int main() {
     Utils::logInfo("=== DSA Project - Version 3.0: API Server ===");
     Utils::logInfo("Initializing data structures and APIs...\n");
 
-    // Initialize SpellChecker with all DSA components
-    SpellChecker* spellchecker = new SpellChecker();
-    
-    // Load dictionary
-    int wordsLoaded = spellchecker->loadDictionary("data/dictionary.txt");
-    if (wordsLoaded == 0) {
-        Utils::logError("Failed to load dictionary! Server cannot start.");
-        delete spellchecker;
-        return 1;
+    // Stage tracing (AUTOCOMPLETE_TRACE=on), also switchable at runtime
+    Tracing::configure(Tracing::Config::fromEnvironment());
+
+    // Frequencies learned from selections, replayed before the first load
+    FrequencyLog* frequencyLog = nullptr;
+    FrequencyLog::Config logConfig = FrequencyLog::Config::fromEnvironment();
+    if (!logConfig.logPath.empty()) {
+        frequencyLog = new FrequencyLog(logConfig);
+        frequencyLog->replay();
+        frequencyLog->start();
     }
 
-    // Initialize AutocompleteEngine with Trie and HashTable from SpellChecker
-    // Note: We're creating a new instance for API integration
-    Trie* trie = new Trie();
-    HashTable* frequencyMap = new HashTable(1000);
-    
-    // Load words into autocomplete engine
-    Utils::logInfo("Loading autocomplete data...");
-    auto words = FileHandler::readDictionary("data/dictionary.txt");
-    for (const auto& wordPair : words) {
-        trie->insertWord(wordPair.first, wordPair.second);
-        frequencyMap->insert(wordPair.first, wordPair.second);
+    // SpellChecker (all DSA components) and AutocompleteEngine share one
+    // index; the manager publishes it and swaps in a new one on reload
+    DictionaryManager* dictionaries = new DictionaryManager("data/dictionary.txt", frequencyLog);
+    if (!dictionaries->reload()) {
+        Utils::logError("Failed to load dictionary! Server cannot start.");
+        delete dictionaries;
+        delete frequencyLog;
+        return 1;
     }
+    globalDictionaries = dictionaries;
 
-    AutocompleteEngine* autocomplete = new AutocompleteEngine(trie, frequencyMap, 10);
-    
-    Utils::logInfo("Autocomplete engine ready: " + std::to_string(autocomplete->getWordCount()) + " words\n");
+    int wordsLoaded = dictionaries->acquire()->getWordCount();
+    Utils::logInfo("Autocomplete engine ready: " + std::to_string(wordsLoaded) + " words\n");
 
-    // Create HTTP server on port 8080
-    const int SERVER_PORT = 8080;
-    HTTPServer* server = new HTTPServer(SERVER_PORT, autocomplete, spellchecker);
+    // Create HTTP server on port 8080 (AUTOCOMPLETE_PORT overrides)
+    int SERVER_PORT = 8080;
+    const char* portSetting = std::getenv("AUTOCOMPLETE_PORT");
+    if (portSetting != nullptr && std::atoi(portSetting) > 0) {
+        SERVER_PORT = std::atoi(portSetting);
+    }
+    HTTPServer* server = new HTTPServer(SERVER_PORT, dictionaries);
     globalServer = server;
 
-    // Register signal handler for graceful shutdown
+    // Register signal handlers for graceful shutdown and reload
     std::signal(SIGINT, signalHandler);
+#ifdef SIGHUP
+    std::signal(SIGHUP, signalHandler);
+#endif
 
     // Display server info
     Utils::logInfo("Server Configuration:");
@@ -85,11 +105,11 @@ int main() {
     server->start();
 
     // Cleanup
+    globalServer = nullptr;
+    globalDictionaries = nullptr;
     delete server;
-    delete autocomplete;
-    delete trie;
-    delete frequencyMap;
-    delete spellchecker;
+    delete dictionaries;
+    delete frequencyLog;  // Flushes what is still queued
 
     Utils::logInfo("Server shutdown complete.");
     return 0;
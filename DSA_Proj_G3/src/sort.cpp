@@ -1,11 +1,330 @@
 #include "sort.h"
+#include "threadpool.h"
 #include <cctype>
+#include <functional>
+#include <cstdint>
+#include <utility>
+
+// ==================== INTROSORT CORE ====================
+// Shared by the introSort* functions; 'before(a, b)' is true when a must
+// come before b in the output
+
+namespace {
+
+    // Ranges at or below this size are finished with insertion sort
+    const int INSERTION_SORT_THRESHOLD = 16;
+
+    template<typename T, typename Before>
+    void insertionSort(std::vector<T>& arr, int low, int high, Before before) {
+        for (int i = low + 1; i <= high; i++) {
+            T value = std::move(arr[i]);
+            int j = i - 1;
+            while (j >= low && before(value, arr[j])) {
+                arr[j + 1] = std::move(arr[j]);
+                j--;
+            }
+            arr[j + 1] = std::move(value);
+        }
+    }
+
+    // Heap over arr[low .. low+count-1]; the root is the element that
+    // comes last in the output
+    template<typename T, typename Before>
+    void siftDown(std::vector<T>& arr, int low, int root, int count, Before before) {
+        while (2 * root + 1 < count) {
+            int child = 2 * root + 1;
+            if (child + 1 < count && before(arr[low + child], arr[low + child + 1])) {
+                child++;
+            }
+            if (!before(arr[low + root], arr[low + child])) {
+                return;
+            }
+            std::swap(arr[low + root], arr[low + child]);
+            root = child;
+        }
+    }
+
+    template<typename T, typename Before>
+    void heapSort(std::vector<T>& arr, int low, int high, Before before) {
+        int count = high - low + 1;
+        for (int i = count / 2 - 1; i >= 0; i--) {
+            siftDown(arr, low, i, count, before);
+        }
+        for (int end = count - 1; end > 0; end--) {
+            std::swap(arr[low], arr[low + end]);
+            siftDown(arr, low, 0, end, before);
+        }
+    }
+
+    // Hoare partition around the median of first, middle and last.
+    // Equal keys stop both scans, so all-equal input splits in half
+    // instead of degrading like Lomuto.
+    // @return: p such that arr[low..p] <= arr[p+1..high], low <= p < high
+    template<typename T, typename Before>
+    int partitionMedianOfThree(std::vector<T>& arr, int low, int high, Before before) {
+        int mid = low + (high - low) / 2;
+        if (before(arr[mid], arr[low])) std::swap(arr[mid], arr[low]);
+        if (before(arr[high], arr[low])) std::swap(arr[high], arr[low]);
+        if (before(arr[high], arr[mid])) std::swap(arr[high], arr[mid]);
+        
+        T pivot = arr[mid];
+        int i = low - 1;
+        int j = high + 1;
+        
+        while (true) {
+            do { i++; } while (before(arr[i], pivot));
+            do { j--; } while (before(pivot, arr[j]));
+            if (i >= j) return j;
+            std::swap(arr[i], arr[j]);
+        }
+    }
+
+    template<typename T, typename Before>
+    void introSortLoop(std::vector<T>& arr, int low, int high, int depthLimit, Before before) {
+        while (high - low + 1 > INSERTION_SORT_THRESHOLD) {
+            if (depthLimit == 0) {
+                // Too many unbalanced splits: finish this range in O(n log n)
+                heapSort(arr, low, high, before);
+                return;
+            }
+            depthLimit--;
+            
+            int p = partitionMedianOfThree(arr, low, high, before);
+            
+            // Recurse into the smaller side, loop on the larger one:
+            // stack depth stays O(log n)
+            if (p - low < high - p) {
+                introSortLoop(arr, low, p, depthLimit, before);
+                low = p + 1;
+            } else {
+                introSortLoop(arr, p + 1, high, depthLimit, before);
+                high = p;
+            }
+        }
+        insertionSort(arr, low, high, before);
+    }
+
+    template<typename T, typename Before>
+    void introSort(std::vector<T>& arr, int low, int high, Before before) {
+        if (low >= high) return;
+        
+        // Depth limit: 2 * floor(log2(n))
+        int depthLimit = 0;
+        for (int n = high - low + 1; n > 1; n >>= 1) {
+            depthLimit += 2;
+        }
+        introSortLoop(arr, low, high, depthLimit, before);
+    }
+
+    // ==================== PARALLEL SORT CORE ====================
+
+    // Below this size the parallel sorts just introsort on the caller
+    const size_t PARALLEL_THRESHOLD = 1 << 14;
+
+    // Sample elements drawn per sample-sort bucket
+    const size_t OVERSAMPLING = 16;
+
+    // Stable merge of src[lo..mid) and src[mid..hi) into dst[lo..hi)
+    template<typename T, typename Before>
+    void mergeRuns(std::vector<T>& src, std::vector<T>& dst, size_t lo, size_t mid, size_t hi,
+                   Before before) {
+        size_t i = lo, j = mid, k = lo;
+        while (i < mid && j < hi) {
+            if (before(src[j], src[i])) {
+                dst[k++] = std::move(src[j++]);
+            } else {
+                dst[k++] = std::move(src[i++]);
+            }
+        }
+        while (i < mid) dst[k++] = std::move(src[i++]);
+        while (j < hi) dst[k++] = std::move(src[j++]);
+    }
+
+    template<typename T, typename Before>
+    void parallelMergeSort(std::vector<T>& arr, ThreadPool& pool, Before before) {
+        size_t n = arr.size();
+        size_t runs = static_cast<size_t>(pool.getConcurrency());
+        if (n < PARALLEL_THRESHOLD || runs < 2) {
+            introSort(arr, 0, static_cast<int>(n) - 1, before);
+            return;
+        }
+        
+        // Run boundaries: run r is [bounds[r], bounds[r + 1])
+        std::vector<size_t> bounds;
+        for (size_t r = 0; r <= runs; r++) {
+            bounds.push_back(n * r / runs);
+        }
+        
+        std::vector<std::function<void()>> tasks;
+        for (size_t r = 0; r < runs; r++) {
+            size_t lo = bounds[r], hi = bounds[r + 1];
+            tasks.push_back([&arr, lo, hi, before]() {
+                introSort(arr, static_cast<int>(lo), static_cast<int>(hi) - 1, before);
+            });
+        }
+        pool.runAll(tasks);
+        
+        // Pairwise merge rounds, ping-ponging between arr and buffer
+        std::vector<T> buffer(n);
+        std::vector<T>* src = &arr;
+        std::vector<T>* dst = &buffer;
+        
+        while (bounds.size() > 2) {
+            std::vector<size_t> merged;
+            for (size_t r = 0; r + 1 < bounds.size(); r += 2) {
+                size_t lo = bounds[r];
+                size_t mid = bounds[r + 1];
+                size_t hi = r + 2 < bounds.size() ? bounds[r + 2] : mid;
+                merged.push_back(lo);
+                tasks.push_back([src, dst, lo, mid, hi, before]() {
+                    mergeRuns(*src, *dst, lo, mid, hi, before);
+                });
+            }
+            merged.push_back(n);
+            pool.runAll(tasks);
+            
+            bounds.swap(merged);
+            std::swap(src, dst);
+        }
+        
+        if (src != &arr) {
+            arr.swap(buffer);
+        }
+    }
+
+    template<typename T, typename Before>
+    void sampleSort(std::vector<T>& arr, ThreadPool& pool, Before before) {
+        size_t n = arr.size();
+        size_t chunks = static_cast<size_t>(pool.getConcurrency());
+        if (n < PARALLEL_THRESHOLD || chunks < 2) {
+            introSort(arr, 0, static_cast<int>(n) - 1, before);
+            return;
+        }
+        
+        // More buckets than threads so an unlucky split does not leave
+        // one thread with most of the work
+        size_t buckets = chunks * 4;
+        
+        // Evenly spaced sample (deterministic); every OVERSAMPLING-th
+        // sorted sample becomes a splitter
+        std::vector<T> sample;
+        size_t sampleSize = buckets * OVERSAMPLING;
+        for (size_t i = 0; i < sampleSize; i++) {
+            sample.push_back(arr[i * n / sampleSize]);
+        }
+        introSort(sample, 0, static_cast<int>(sampleSize) - 1, before);
+        
+        std::vector<T> splitters;
+        for (size_t b = 1; b < buckets; b++) {
+            splitters.push_back(sample[b * OVERSAMPLING]);
+        }
+        
+        // Pass 1: classify each element, count per (chunk, bucket)
+        std::vector<uint32_t> bucketOf(n);
+        std::vector<std::vector<size_t>> counts(chunks, std::vector<size_t>(buckets, 0));
+        std::vector<std::function<void()>> tasks;
+        
+        for (size_t c = 0; c < chunks; c++) {
+            size_t lo = n * c / chunks, hi = n * (c + 1) / chunks;
+            tasks.push_back([&, c, lo, hi]() {
+                for (size_t i = lo; i < hi; i++) {
+                    // First splitter the element sorts before
+                    size_t left = 0, right = splitters.size();
+                    while (left < right) {
+                        size_t mid = (left + right) / 2;
+                        if (before(arr[i], splitters[mid])) {
+                            right = mid;
+                        } else {
+                            left = mid + 1;
+                        }
+                    }
+                    bucketOf[i] = static_cast<uint32_t>(left);
+                    counts[c][left]++;
+                }
+            });
+        }
+        pool.runAll(tasks);
+        
+        // Offsets: bucket-major, chunk order inside each bucket
+        std::vector<size_t> bucketStart(buckets + 1, 0);
+        std::vector<std::vector<size_t>> offsets(chunks, std::vector<size_t>(buckets, 0));
+        size_t position = 0;
+        for (size_t b = 0; b < buckets; b++) {
+            bucketStart[b] = position;
+            for (size_t c = 0; c < chunks; c++) {
+                offsets[c][b] = position;
+                position += counts[c][b];
+            }
+        }
+        bucketStart[buckets] = n;
+        
+        // Pass 2: scatter into buckets
+        std::vector<T> output(n);
+        for (size_t c = 0; c < chunks; c++) {
+            size_t lo = n * c / chunks, hi = n * (c + 1) / chunks;
+            tasks.push_back([&, c, lo, hi]() {
+                std::vector<size_t>& next = offsets[c];
+                for (size_t i = lo; i < hi; i++) {
+                    output[next[bucketOf[i]]++] = std::move(arr[i]);
+                }
+            });
+        }
+        pool.runAll(tasks);
+        
+        // Pass 3: sort buckets independently
+        for (size_t b = 0; b < buckets; b++) {
+            int lo = static_cast<int>(bucketStart[b]);
+            int hi = static_cast<int>(bucketStart[b + 1]) - 1;
+            if (hi > lo) {
+                tasks.push_back([&output, lo, hi, before]() {
+                    introSort(output, lo, hi, before);
+                });
+            }
+        }
+        pool.runAll(tasks);
+        
+        arr.swap(output);
+    }
+
+    bool lexicographicBefore(const std::string& a, const std::string& b) {
+        return SortAlgorithms::compareStrings(a, b) < 0;
+    }
+
+    template<typename Word>
+    bool wordBefore(const std::pair<Word, int>& a, const std::pair<Word, int>& b) {
+        return SortAlgorithms::compareStrings(a.first, b.first) < 0;
+    }
+
+    template<typename Word>
+    int removeDuplicates(std::vector<std::pair<Word, int>>& arr) {
+        if (arr.empty()) return 0;
+        
+        size_t kept = 0;
+        for (size_t i = 1; i < arr.size(); i++) {
+            if (SortAlgorithms::compareStrings(arr[kept].first, arr[i].first) == 0) {
+                if (arr[i].second > arr[kept].second) {
+                    arr[kept].second = arr[i].second;
+                }
+            } else {
+                kept++;
+                if (kept != i) {
+                    arr[kept] = std::move(arr[i]);
+                }
+            }
+        }
+        
+        int removed = static_cast<int>(arr.size() - (kept + 1));
+        arr.resize(kept + 1);
+        return removed;
+    }
+
+} // namespace
 
 namespace SortAlgorithms {
 
     // ==================== UTILITY FUNCTIONS ====================
     
-    int compareStrings(const std::string& a, const std::string& b) {
+    int compareStrings(std::string_view a, std::string_view b) {
         size_t minLen = a.length() < b.length() ? a.length() : b.length();
         
         for (size_t i = 0; i < minLen; i++) {
@@ -47,9 +366,15 @@ namespace SortAlgorithms {
         }
     }
     
+    void introSortLexicographic(std::vector<std::string>& arr, int low, int high) {
+        introSort(arr, low, high, [](const std::string& a, const std::string& b) {
+            return compareStrings(a, b) < 0;
+        });
+    }
+    
     void sortLexicographic(std::vector<std::string>& arr) {
         if (arr.size() <= 1) return;
-        quickSortLexicographic(arr, 0, arr.size() - 1);
+        introSortLexicographic(arr, 0, arr.size() - 1);
     }
 
     // ==================== FREQUENCY-BASED QUICKSORT ====================
@@ -84,9 +409,97 @@ namespace SortAlgorithms {
         }
     }
     
+    void introSortByFrequency(std::vector<std::pair<std::string, int>>& arr, int low, int high) {
+        introSort(arr, low, high, [](const std::pair<std::string, int>& a,
+                                     const std::pair<std::string, int>& b) {
+            // DESCENDING frequency, then lexicographic
+            if (a.second != b.second) return a.second > b.second;
+            return compareStrings(a.first, b.first) < 0;
+        });
+    }
+    
     void sortByFrequency(std::vector<std::pair<std::string, int>>& arr) {
         if (arr.size() <= 1) return;
-        quickSortByFrequency(arr, 0, arr.size() - 1);
+        introSortByFrequency(arr, 0, arr.size() - 1);
+    }
+
+    // ==================== RADIX SORT BY FREQUENCY ====================
+    
+    void radixSortByFrequency(std::vector<std::pair<std::string, int>>& arr) {
+        size_t n = arr.size();
+        if (n <= 1) return;
+        
+        // Map frequencies to unsigned keys whose ASCENDING order is the
+        // DESCENDING frequency order (flip the sign bit, then invert)
+        std::vector<uint32_t> keys(n);
+        for (size_t i = 0; i < n; i++) {
+            keys[i] = ~(static_cast<uint32_t>(arr[i].second) ^ 0x80000000u);
+        }
+        
+        std::vector<std::pair<std::string, int>> buffer(n);
+        std::vector<uint32_t> keyBuffer(n);
+        
+        for (int shift = 0; shift < 32; shift += 8) {
+            size_t count[257] = {0};
+            for (size_t i = 0; i < n; i++) {
+                count[((keys[i] >> shift) & 0xFF) + 1]++;
+            }
+            
+            // Every key has the same digit here: nothing to reorder
+            bool singleBucket = false;
+            for (int d = 1; d <= 256; d++) {
+                if (count[d] == n) {
+                    singleBucket = true;
+                    break;
+                }
+            }
+            if (singleBucket) continue;
+            
+            // Bucket start offsets
+            for (int d = 0; d < 256; d++) {
+                count[d + 1] += count[d];
+            }
+            
+            // Stable scatter (moves, no string copies)
+            for (size_t i = 0; i < n; i++) {
+                size_t pos = count[(keys[i] >> shift) & 0xFF]++;
+                buffer[pos] = std::move(arr[i]);
+                keyBuffer[pos] = keys[i];
+            }
+            
+            arr.swap(buffer);
+            keys.swap(keyBuffer);
+        }
+    }
+
+    // ==================== PARALLEL SORTING ====================
+    
+    void parallelMergeSortLexicographic(std::vector<std::string>& arr, ThreadPool& pool) {
+        if (arr.size() <= 1) return;
+        parallelMergeSort(arr, pool, lexicographicBefore);
+    }
+    
+    void sampleSortLexicographic(std::vector<std::string>& arr, ThreadPool& pool) {
+        if (arr.size() <= 1) return;
+        sampleSort(arr, pool, lexicographicBefore);
+    }
+    
+    void sampleSortByWord(std::vector<std::pair<std::string, int>>& arr, ThreadPool& pool) {
+        if (arr.size() <= 1) return;
+        sampleSort(arr, pool, wordBefore<std::string>);
+    }
+    
+    void sampleSortByWord(std::vector<std::pair<std::string_view, int>>& arr, ThreadPool& pool) {
+        if (arr.size() <= 1) return;
+        sampleSort(arr, pool, wordBefore<std::string_view>);
+    }
+    
+    int removeDuplicateWords(std::vector<std::pair<std::string, int>>& arr) {
+        return removeDuplicates(arr);
+    }
+    
+    int removeDuplicateWords(std::vector<std::pair<std::string_view, int>>& arr) {
+        return removeDuplicates(arr);
     }
 
     // ==================== CORRECTION RANKING QUICKSORT ====================
@@ -131,9 +544,18 @@ namespace SortAlgorithms {
         }
     }
     
+    void introSortByRank(std::vector<CorrectionCandidate>& arr, int low, int high) {
+        introSort(arr, low, high, [](const CorrectionCandidate& a, const CorrectionCandidate& b) {
+            // Distance ascending, frequency descending, then lexicographic
+            if (a.distance != b.distance) return a.distance < b.distance;
+            if (a.frequency != b.frequency) return a.frequency > b.frequency;
+            return compareStrings(a.word, b.word) < 0;
+        });
+    }
+    
     void sortByRank(std::vector<CorrectionCandidate>& arr) {
         if (arr.size() <= 1) return;
-        quickSortByRank(arr, 0, arr.size() - 1);
+        introSortByRank(arr, 0, arr.size() - 1);
     }
 
     // ==================== MERGE SORT (Alternative Implementation) ====================
@@ -2,11 +2,81 @@
 #include "filehandler.h"
 #include "utils.h"
 #include "sort.h"
+#include "threadpool.h"
+#include "tracing.h"
 #include <algorithm>
 #include <sstream>
+#include <cstdlib>
+#include <functional>
+
+namespace {
+    const std::string AUTO_PREFIX = "auto:";
+    const std::string SPELL_PREFIX = "spell:";
+
+    // Cached suggestions: "auto:<maxResults>:<prefix>", for the same reason
+    // corrections carry their limits
+    std::string autocompleteKey(const std::string& prefix, int maxResults) {
+        return AUTO_PREFIX + std::to_string(maxResults) + ":" + prefix;
+    }
+
+    // Inverse of autocompleteKey (key starts with AUTO_PREFIX)
+    bool parseAutocompleteKey(const std::string& key, std::string& prefix) {
+        size_t colon = key.find(':', AUTO_PREFIX.length());
+        if (colon == std::string::npos) return false;
+
+        prefix = key.substr(colon + 1);
+        return true;
+    }
+
+    // Cached corrections: "spell:<maxDistance>,<maxResults>:<word>", so a
+    // lookup with other limits (e.g. DocumentChecker::setCorrectionLimits)
+    // never returns a result computed for different ones
+    std::string correctionKey(const std::string& word, int maxDistance, int maxResults) {
+        return SPELL_PREFIX + std::to_string(maxDistance) + "," + std::to_string(maxResults) + ":" + word;
+    }
+
+    // Inverse of correctionKey (key starts with SPELL_PREFIX)
+    bool parseCorrectionKey(const std::string& key, int& maxDistance, std::string& word) {
+        size_t colon = key.find(':', SPELL_PREFIX.length());
+        if (colon == std::string::npos) return false;
+
+        maxDistance = std::atoi(key.c_str() + SPELL_PREFIX.length());
+        word = key.substr(colon + 1);
+        return true;
+    }
+
+    // Word as the Trie indexes it: lowercase, unindexed characters dropped
+    std::string trieKey(const std::string& word) {
+        std::string key;
+        key.reserve(word.length());
+        for (char ch : word) {
+            int index = TrieNode::charToIndex(ch);
+            if (index >= 0) key += TrieNode::indexToChar(index);
+        }
+        return key;
+    }
+
+    // Process-wide stage latencies and cache counters for /metrics
+    Metrics::Histogram& cacheStage = Metrics::stage("cache");
+    Metrics::Histogram& trieStage = Metrics::stage("trie");
+    Metrics::Histogram& bkTreeStage = Metrics::stage("bktree");
+    Metrics::Counter& cacheHitsTotal = Metrics::counter("autocomplete_cache_lookups_total",
+        "result=\"hit\"", "LRU cache lookups by result");
+    Metrics::Counter& cacheMissesTotal = Metrics::counter("autocomplete_cache_lookups_total",
+        "result=\"miss\"", "LRU cache lookups by result");
+
+    // Cache lookup timed as the cache stage, counted as hit or miss
+    bool cachedLookup(LRUCache& cache, const std::string& key, std::string& value) {
+        Metrics::ScopedTimer timer(cacheStage);
+        Tracing::Span span("cache");
+        bool hit = cache.get(key, value);
+        (hit ? cacheHitsTotal : cacheMissesTotal).add();
+        return hit;
+    }
+}
 
 SpellChecker::SpellChecker(int cacheSize, int bloomSize) 
-    : cacheHits(0), cacheMisses(0), totalQueries(0) {
+    : frequencyLog(nullptr) {
     
     trie = new Trie();
     bloomFilter = new BloomFilter(bloomSize, 4);
@@ -26,46 +96,112 @@ SpellChecker::~SpellChecker() {
 int SpellChecker::loadDictionary(const std::string& filename) {
     Utils::logInfo("Loading dictionary from: " + filename);
     
-    auto words = FileHandler::readDictionary(filename);
+    ThreadPool& pool = ThreadPool::shared();
+    Utils::Timer stage;
+    
+    // Stage 1: map the file and scan it in chunks on all cores. Entries
+    // are views into the mapping (no per-line strings), so the mapping
+    // stays open until every structure is built
+    stage.start();
+    MappedFile file;
+    if (!file.open(filename)) {
+        Utils::logError("Cannot open dictionary: " + filename);
+        return 0;
+    }
+    
+    int skipped = 0;
+    auto words = FileHandler::scanDictionaryParallel(file, pool, skipped);
+    double parseMs = stage.elapsedMilliseconds();
     
+    if (skipped > 0) {
+        Utils::logWarning("Skipped " + Utils::formatNumber(skipped) + " malformed dictionary line(s)");
+    }
     if (words.empty()) {
         Utils::logError(std::string("Failed to load dictionary or dictionary is empty"));
         return 0;
     }
     
-    // Populate all data structures
-    for (const auto& wordPair : words) {
-        const std::string& word = wordPair.first;
-        int frequency = wordPair.second;
-        trie->insertWord(word, frequency);
-        bloomFilter->addWord(word);
-        frequencyTable->insert(word, frequency);
-        bkTree->insert(word);
+    // Stage 2: sort by word and merge duplicate entries: the builders
+    // below see each word once, in order
+    stage.start();
+    SortAlgorithms::sampleSortByWord(words, pool);
+    int duplicates = SortAlgorithms::removeDuplicateWords(words);
+    if (duplicates > 0) {
+        Utils::logInfo("Merged " + Utils::formatNumber(duplicates) + " duplicate dictionary entries");
     }
+    double sortMs = stage.elapsedMilliseconds();
+    
+    // Stage 3: the structures are independent, so each is built by its
+    // own task; the BK-Tree (one edit distance per level) dominates
+    double trieMs = 0, bloomMs = 0, hashMs = 0, bkTreeMs = 0;
+    std::vector<std::function<void()>> builders;
+    
+    builders.push_back([&]() {
+        Utils::Timer timer;
+        timer.start();
+        trie->buildSorted(words);  // Sorted input: one pass, nodes in DFS order
+        trieMs = timer.elapsedMilliseconds();
+    });
+    builders.push_back([&]() {
+        Utils::Timer timer;
+        timer.start();
+        for (const auto& wordPair : words) {
+            bloomFilter->addWord(std::string(wordPair.first));
+        }
+        bloomMs = timer.elapsedMilliseconds();
+    });
+    builders.push_back([&]() {
+        Utils::Timer timer;
+        timer.start();
+        for (const auto& wordPair : words) {
+            frequencyTable->insert(std::string(wordPair.first), wordPair.second);
+        }
+        hashMs = timer.elapsedMilliseconds();
+    });
+    builders.push_back([&]() {
+        Utils::Timer timer;
+        timer.start();
+        for (const auto& wordPair : words) {
+            bkTree->insert(std::string(wordPair.first));
+        }
+        bkTreeMs = timer.elapsedMilliseconds();
+    });
+    
+    stage.start();
+    pool.runAll(builders);
+    double buildMs = stage.elapsedMilliseconds();
     
     Utils::logInfo("Dictionary loaded: " + Utils::formatNumber(words.size()) + " words");
+    Utils::logInfo("Load stages (ms): parse " + Utils::formatDouble(parseMs, 1) +
+                   ", sort " + Utils::formatDouble(sortMs, 1) +
+                   ", build " + Utils::formatDouble(buildMs, 1) +
+                   " [trie " + Utils::formatDouble(trieMs, 1) +
+                   ", bloom " + Utils::formatDouble(bloomMs, 1) +
+                   ", hash " + Utils::formatDouble(hashMs, 1) +
+                   ", bk-tree " + Utils::formatDouble(bkTreeMs, 1) + "] on " +
+                   std::to_string(pool.getConcurrency()) + " threads");
     Utils::logInfo("Bloom Filter FPR: " + Utils::formatDouble(bloomFilter->getFalsePositiveRate() * 100, 4) + "%");
     
     return words.size();
 }
 
 std::vector<std::string> SpellChecker::autocomplete(const std::string& prefix, int maxResults) {
-    totalQueries++;
+    totalQueries.add();
     
     // Check cache first
-    std::string cacheKey = "auto:" + prefix;
+    std::string cacheKey = autocompleteKey(prefix, maxResults);
     std::string cachedResult;
     
-    if (cache->get(cacheKey, cachedResult)) {
-        cacheHits++;
+    if (cachedLookup(*cache, cacheKey, cachedResult)) {
+        cacheHits.add();
         // Parse cached result
         return Utils::split(cachedResult, '|');
     }
     
-    cacheMisses++;
+    cacheMisses.add();
     
     // Use Trie to get suggestions
-    std::vector<std::string> suggestions = trie->suggestWords(prefix, maxResults);
+    std::vector<std::string> suggestions = autocompleteUncached(prefix, maxResults);
     
     // Cache the result
     std::string resultStr = Utils::join(suggestions, std::string("|"));
@@ -75,33 +211,99 @@ std::vector<std::string> SpellChecker::autocomplete(const std::string& prefix, i
 }
 
 bool SpellChecker::checkSpelling(const std::string& word) {
+    Metrics::ScopedTimer timer(trieStage);
+    
     // Quick check with Bloom Filter
-    if (!bloomFilter->containsWord(word)) {
-        return false;  // Definitely not in dictionary
+    {
+        Tracing::Span span("bloom");
+        if (!bloomFilter->containsWord(word)) {
+            return false;  // Definitely not in dictionary
+        }
     }
     
     // Confirm with Trie (Bloom filter might have false positives)
+    Tracing::Span span("trie");
     return trie->searchWord(word);
 }
 
+void SpellChecker::checkSpellingBatch(const std::vector<std::string>& words,
+                                      std::vector<bool>& results) {
+    results.assign(words.size(), false);
+    
+    // Pass 1: Bloom Filter rejects most misspellings without touching the Trie
+    std::vector<size_t> candidates;
+    candidates.reserve(words.size());
+    for (size_t i = 0; i < words.size(); i++) {
+        if (bloomFilter->containsWord(words[i])) {
+            candidates.push_back(i);
+        }
+    }
+    
+    // Pass 2: Confirm the survivors with the Trie
+    for (size_t i : candidates) {
+        results[i] = trie->searchWord(words[i]);
+    }
+}
+
+void SpellChecker::checkSpellingBatchNormalized(const std::vector<std::string_view>& words,
+                                                std::vector<bool>& results) {
+    results.assign(words.size(), false);
+    
+    std::vector<size_t> candidates;
+    candidates.reserve(words.size());
+    for (size_t i = 0; i < words.size(); i++) {
+        if (bloomFilter->containsNormalized(words[i])) {
+            candidates.push_back(i);
+        }
+    }
+    
+    for (size_t i : candidates) {
+        results[i] = trie->searchWordNormalized(words[i]);
+    }
+}
+
 std::vector<std::string> SpellChecker::getCorrections(
     const std::string& word, int maxDistance, int maxResults) {
     
-    totalQueries++;
+    totalQueries.add();
     
     // Check cache first
-    std::string cacheKey = "spell:" + word;
+    std::string cacheKey = correctionKey(word, maxDistance, maxResults);
     std::string cachedResult;
     
-    if (cache->get(cacheKey, cachedResult)) {
-        cacheHits++;
+    if (cachedLookup(*cache, cacheKey, cachedResult)) {
+        cacheHits.add();
         return Utils::split(cachedResult, '|');
     }
     
-    cacheMisses++;
+    cacheMisses.add();
     
     // Use BK-Tree to find corrections
-    auto candidates = bkTree->searchByDistance(word, maxDistance);
+    std::vector<std::string> corrections = getCorrectionsUncached(word, maxDistance, maxResults);
+    
+    // Cache the result
+    std::string resultStr = Utils::join(corrections, "|");
+    cache->put(cacheKey, resultStr);
+    
+    return corrections;
+}
+
+std::vector<std::string> SpellChecker::autocompleteUncached(const std::string& prefix,
+                                                            int maxResults) const {
+    Metrics::ScopedTimer timer(trieStage);
+    Tracing::Span span("trie");
+    return trie->suggestWords(prefix, maxResults);
+}
+
+std::vector<std::string> SpellChecker::getCorrectionsUncached(
+    const std::string& word, int maxDistance, int maxResults) const {
+    
+    std::vector<std::pair<std::string, int>> candidates;
+    {
+        Metrics::ScopedTimer timer(bkTreeStage);
+        Tracing::Span span("bktree");
+        candidates = bkTree->searchByDistance(word, maxDistance);
+    }
     
     // Extract just the words (sorted by distance already)
     std::vector<std::string> corrections;
@@ -109,16 +311,157 @@ std::vector<std::string> SpellChecker::getCorrections(
         corrections.push_back(candidates[i].first);
     }
     
-    // Cache the result
-    std::string resultStr = Utils::join(corrections, "|");
-    cache->put(cacheKey, resultStr);
-    
     return corrections;
 }
 
-void SpellChecker::updateFrequency(const std::string& word) {
-    trie->updateFrequency(word, 1);
-    frequencyTable->increment(word, 1);
+void SpellChecker::addWord(const std::string& word, int frequency) {
+    if (word.empty()) return;
+
+    if (trie->searchWord(word)) {
+        trie->updateFrequency(word, frequency);
+        frequencyTable->increment(word, frequency);
+    } else {
+        trie->insertWord(word, frequency);
+        bloomFilter->addWord(word);
+        frequencyTable->insert(word, frequency);
+        bkTree->insert(word);
+    }
+
+    invalidateCachedResults(word, true);
+}
+
+bool SpellChecker::removeWord(const std::string& word) {
+    if (!trie->removeWord(word)) return false;
+
+    frequencyTable->remove(word);
+    bkTree->remove(word);
+    // Bloom Filter bits are shared with other words and stay set
+
+    invalidateCachedResults(word, true);
+    return true;
+}
+
+bool SpellChecker::setWordFrequency(const std::string& word, int frequency) {
+    if (!trie->setFrequency(word, frequency)) return false;
+
+    frequencyTable->insert(word, frequency);
+
+    // Corrections are ranked by distance only: just the prefixes change
+    invalidateCachedResults(word, false);
+    return true;
+}
+
+SpellChecker::DeltaStats SpellChecker::applyDelta(const std::string& filename) {
+    MappedFile file;
+    if (!file.open(filename)) {
+        Utils::logError("Cannot open delta file: " + filename);
+        DeltaStats stats = {0, 0, 0, 0, 0, 0.0};
+        return stats;
+    }
+
+    return applyDelta(file.data(), file.size());
+}
+
+SpellChecker::DeltaStats SpellChecker::applyDelta(const char* data, size_t size) {
+    DeltaStats stats = {0, 0, 0, 0, 0, 0.0};
+    int cachedBefore = cache->getSize();
+
+    Utils::Timer timer;
+    timer.start();
+
+    int malformed = FileHandler::scanDelta(data, size,
+        [this, &stats](FileHandler::DeltaOp op, std::string_view view, int frequency) {
+            std::string word(view);
+
+            if (op == FileHandler::DeltaOp::Remove) {
+                if (removeWord(word)) stats.removed++;
+                else stats.skipped++;
+            } else if (setWordFrequency(word, frequency)) {
+                stats.updated++;
+            } else if (op == FileHandler::DeltaOp::Add) {
+                addWord(word, frequency);
+                stats.added++;
+            } else {
+                stats.skipped++;  // "set" on a word that is not in the dictionary
+            }
+        });
+
+    stats.skipped += malformed;
+    stats.elapsedMs = timer.elapsedMilliseconds();
+    stats.invalidated = cachedBefore - cache->getSize();
+
+    Utils::logInfo("Delta applied in " + Utils::formatDouble(stats.elapsedMs, 2) + " ms: " +
+                   std::to_string(stats.added) + " added, " +
+                   std::to_string(stats.removed) + " removed, " +
+                   std::to_string(stats.updated) + " updated, " +
+                   std::to_string(stats.skipped) + " skipped, " +
+                   std::to_string(stats.invalidated) + " cached result(s) dropped");
+    return stats;
+}
+
+int SpellChecker::invalidateCachedResults(const std::string& word, bool membershipChanged) {
+    std::string changed = trieKey(word);
+    int dropped = 0;
+
+    // The cache is small and bounded, so one pass over its keys is cheaper
+    // than enumerating every key the change could have produced
+    for (const std::string& key : cache->getKeys()) {
+        bool stale = false;
+
+        if (key.compare(0, AUTO_PREFIX.length(), AUTO_PREFIX) == 0) {
+            std::string prefix;
+            stale = !parseAutocompleteKey(key, prefix);
+            if (!stale) {
+                prefix = trieKey(prefix);
+                stale = changed.compare(0, prefix.length(), prefix) == 0;
+            }
+        } else if (membershipChanged && key.compare(0, SPELL_PREFIX.length(), SPELL_PREFIX) == 0) {
+            // Corrections farther from the changed word than the
+            // lookup's own limit cannot contain it
+            int maxDistance = 0;
+            std::string cachedWord;
+            stale = !parseCorrectionKey(key, maxDistance, cachedWord) ||
+                    EditDistance::calculate(cachedWord, word) <= maxDistance;
+        }
+
+        if (stale && cache->remove(key)) {
+            dropped++;
+        }
+    }
+
+    return dropped;
+}
+
+bool SpellChecker::updateFrequency(const std::string& word) {
+    // Log the key the Trie resolves ("Hello", "hello" and "hel\nlo" are
+    // one word), so a replay restores what was learned live
+    std::string key = trieKey(word);
+
+    // Recent usage decays; the dictionary frequency stays as loaded
+    if (!trie->recordUse(key)) return false;
+
+    // The word may now outrank its neighbours under every cached prefix
+    invalidateCachedResults(key, false);
+
+    // Queued only; the log's flusher does the I/O
+    if (frequencyLog != nullptr) {
+        frequencyLog->record(key, 1);
+    }
+    return true;
+}
+
+int SpellChecker::applyLearnedFrequencies(const FrequencyLog& log) {
+    int adjusted = 0;
+
+    log.forEachLearned([this, &adjusted](const std::string& word, const DecayedScore& score) {
+        // Words that left the dictionary are skipped
+        if (trie->mergeRecentScore(word, score)) {
+            adjusted++;
+        }
+    });
+
+    cache->clear();
+    return adjusted;
 }
 
 std::vector<std::string> SpellChecker::rankByFrequency(
@@ -143,11 +486,12 @@ std::vector<std::string> SpellChecker::rankByFrequency(
 }
 
 void SpellChecker::getCacheStats(int& hits, int& misses, double& hitRate) {
-    hits = cacheHits;
-    misses = cacheMisses;
+    uint64_t queries = totalQueries.value();
+    hits = static_cast<int>(cacheHits.value());
+    misses = static_cast<int>(cacheMisses.value());
     
-    if (totalQueries > 0) {
-        hitRate = (static_cast<double>(cacheHits) / totalQueries) * 100.0;
+    if (queries > 0) {
+        hitRate = (static_cast<double>(hits) / queries) * 100.0;
     } else {
         hitRate = 0.0;
     }
@@ -163,14 +507,24 @@ int SpellChecker::getDictionarySize() {
 
 void SpellChecker::clearCache() {
     cache->clear();
-    cacheHits = 0;
-    cacheMisses = 0;
+    cacheHits.reset();
+    cacheMisses.reset();
 }
 
 void SpellChecker::resetStats() {
-    cacheHits = 0;
-    cacheMisses = 0;
-    totalQueries = 0;
+    cacheHits.reset();
+    cacheMisses.reset();
+    totalQueries.reset();
+}
+
+SpellChecker::MemoryStats SpellChecker::getMemoryStats() const {
+    MemoryStats stats;
+    stats.trie = trie->getMemoryBytes();
+    stats.bkTree = bkTree->getMemoryBytes();
+    stats.hashTable = frequencyTable->getMemoryBytes();
+    stats.bloomFilter = bloomFilter->getMemoryBytes();
+    stats.cache = cache->getMemoryBytes();
+    return stats;
 }
 
 std::string SpellChecker::getStatistics() {
@@ -178,18 +532,30 @@ std::string SpellChecker::getStatistics() {
     
     ss << "=== SpellChecker Statistics ===\n";
     ss << "Dictionary Size: " << Utils::formatNumber(getDictionarySize()) << " words\n";
-    ss << "Total Queries: " << Utils::formatNumber(totalQueries) << "\n";
-    ss << "Cache Hits: " << cacheHits << "\n";
-    ss << "Cache Misses: " << cacheMisses << "\n";
-    
-    if (totalQueries > 0) {
-        double hitRate = (static_cast<double>(cacheHits) / totalQueries) * 100.0;
+    uint64_t queries = totalQueries.value();
+    uint64_t hits = cacheHits.value();
+    ss << "Total Queries: " << Utils::formatNumber(static_cast<int>(queries)) << "\n";
+    ss << "Cache Hits: " << hits << "\n";
+    ss << "Cache Misses: " << cacheMisses.value() << "\n";
+    
+    if (queries > 0) {
+        double hitRate = (static_cast<double>(hits) / queries) * 100.0;
         ss << "Cache Hit Rate: " << Utils::formatDouble(hitRate, 2) << "%\n";
     }
     
     ss << "Bloom Filter FPR: " << Utils::formatDouble(getBloomFilterFPR() * 100, 4) << "%\n";
     ss << "BK-Tree Size: " << bkTree->size() << " nodes\n";
     
+    MemoryStats memory = getMemoryStats();
+    ss << "Memory:\n";
+    ss << "  Trie: " << Utils::formatBytes(memory.trie) << "\n";
+    ss << "  BK-Tree: " << Utils::formatBytes(memory.bkTree) << "\n";
+    ss << "  Hash Table: " << Utils::formatBytes(memory.hashTable) << "\n";
+    ss << "  Bloom Filter: " << Utils::formatBytes(memory.bloomFilter) << "\n";
+    ss << "  LRU Cache: " << Utils::formatBytes(memory.cache) << "\n";
+    ss << "  Structures Total: " << Utils::formatBytes(memory.total()) << "\n";
+    ss << "  Process RSS: " << Utils::formatBytes(Utils::getResidentMemoryBytes()) << "\n";
+    
     return ss.str();
 }
 
@@ -215,7 +581,7 @@ void SpellChecker::processQuery(
         timer.stop();
         double timeTaken = timer.elapsedMilliseconds();
         
-        bool cacheHit = (cacheHits > 0);
+        bool cacheHit = (cacheHits.value() > 0);
         std::vector<std::string> dsUsed = {"Trie", "LRU Cache", "Priority Queue"};
         
         FileHandler::writeAutocompleteOutput(outputFile, query, suggestions, 
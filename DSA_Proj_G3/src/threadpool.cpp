@@ -0,0 +1,110 @@
+#include "threadpool.h"
+#include <atomic>
+#include <memory>
+
+ThreadPool::ThreadPool(int threads) : stopping(false) {
+    if (threads <= 0) {
+        // The caller helps during runAll(), so one thread fewer is enough
+        threads = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+    }
+
+    for (int i = 0; i < threads; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueReady.notify_all();
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueReady.wait(lock, [this]() { return stopping || !queue.empty(); });
+
+            if (queue.empty()) {
+                return;  // Stopping and drained
+            }
+
+            task = std::move(queue.front());
+            queue.pop_front();
+        }
+        task();
+    }
+}
+
+bool ThreadPool::runPendingTask() {
+    std::function<void()> task;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (queue.empty()) {
+            return false;
+        }
+        task = std::move(queue.front());
+        queue.pop_front();
+    }
+    task();
+    return true;
+}
+
+void ThreadPool::runAll(std::vector<std::function<void()>>& tasks) {
+    if (tasks.empty()) return;
+
+    // A single task, or no workers: nothing to gain from queueing
+    if (tasks.size() == 1 || workers.empty()) {
+        for (auto& task : tasks) {
+            task();
+        }
+        tasks.clear();
+        return;
+    }
+
+    // The last task still signals after 'remaining' reaches 0, so the
+    // batch is shared rather than living on this stack frame
+    struct Batch {
+        std::atomic<size_t> remaining;
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+    auto batch = std::make_shared<Batch>();
+    batch->remaining = tasks.size();
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        for (auto& task : tasks) {
+            std::function<void()> work = std::move(task);
+            queue.push_back([batch, work]() {
+                work();
+                if (--batch->remaining == 0) {
+                    std::lock_guard<std::mutex> doneLock(batch->mutex);
+                    batch->done.notify_all();
+                }
+            });
+        }
+    }
+    queueReady.notify_all();
+    tasks.clear();
+
+    // Help with queued work (ours or anyone's) instead of blocking
+    while (batch->remaining > 0) {
+        if (!runPendingTask()) {
+            std::unique_lock<std::mutex> lock(batch->mutex);
+            batch->done.wait(lock, [&batch]() { return batch->remaining == 0; });
+        }
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
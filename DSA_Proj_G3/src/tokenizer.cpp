@@ -0,0 +1,283 @@
+#include "tokenizer.h"
+#include <cstdint>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TOKENIZER_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+    const size_t BLOCK_SIZE = 64;
+
+    // Classify one block: lowercase it into out and return bitmasks of
+    // word characters and letters (bit i = byte i)
+    typedef void (*ClassifyFn)(const char* in, char* out, uint64_t& word, uint64_t& letter);
+    typedef void (*LowerFn)(const char* in, size_t length, char* out);
+
+    // ==================== SCALAR ====================
+
+    void classifyScalar(const char* in, char* out, size_t length,
+                        uint64_t& word, uint64_t& letter) {
+        word = 0;
+        letter = 0;
+
+        for (size_t i = 0; i < length; i++) {
+            unsigned char c = static_cast<unsigned char>(in[i]);
+            unsigned char lower = (c >= 'A' && c <= 'Z') ? (c | 0x20) : c;
+            out[i] = static_cast<char>(lower);
+
+            bool isLetter = lower >= 'a' && lower <= 'z';
+            bool isWord = isLetter || (c >= '0' && c <= '9') || c == '_';
+
+            if (isWord) word |= 1ULL << i;
+            if (isLetter) letter |= 1ULL << i;
+        }
+    }
+
+    void classifyBlockScalar(const char* in, char* out, uint64_t& word, uint64_t& letter) {
+        classifyScalar(in, out, BLOCK_SIZE, word, letter);
+    }
+
+    void lowerScalar(const char* in, size_t length, char* out) {
+        for (size_t i = 0; i < length; i++) {
+            unsigned char c = static_cast<unsigned char>(in[i]);
+            out[i] = static_cast<char>((c >= 'A' && c <= 'Z') ? (c | 0x20) : c);
+        }
+    }
+
+#ifdef TOKENIZER_X86
+
+    // ==================== SSE2 ====================
+
+    // Bytes in [lo, hi]: shift the range to start at -128, then one signed compare
+    inline __m128i inRange128(__m128i x, char lo, char hi) {
+        __m128i shifted = _mm_add_epi8(x, _mm_set1_epi8(static_cast<char>(128 - lo)));
+        return _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(-128 + (hi - lo + 1))));
+    }
+
+    inline __m128i lower128(__m128i x) {
+        __m128i upper = inRange128(x, 'A', 'Z');
+        return _mm_or_si128(x, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+    }
+
+    void classifyBlockSSE2(const char* in, char* out, uint64_t& word, uint64_t& letter) {
+        word = 0;
+        letter = 0;
+
+        for (int part = 0; part < 4; part++) {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + part * 16));
+            __m128i lower = lower128(x);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + part * 16), lower);
+
+            __m128i letters = inRange128(lower, 'a', 'z');
+            __m128i words = _mm_or_si128(letters,
+                            _mm_or_si128(inRange128(x, '0', '9'),
+                                         _mm_cmpeq_epi8(x, _mm_set1_epi8('_'))));
+
+            word |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(words))) << (part * 16);
+            letter |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(letters))) << (part * 16);
+        }
+    }
+
+    void lowerSSE2(const char* in, size_t length, char* out) {
+        size_t i = 0;
+        for (; i + 16 <= length; i += 16) {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), lower128(x));
+        }
+        lowerScalar(in + i, length - i, out + i);
+    }
+
+    // ==================== AVX2 ====================
+
+    __attribute__((target("avx2")))
+    inline __m256i inRange256(__m256i x, char lo, char hi) {
+        __m256i shifted = _mm256_add_epi8(x, _mm256_set1_epi8(static_cast<char>(128 - lo)));
+        return _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(-128 + (hi - lo + 1))), shifted);
+    }
+
+    __attribute__((target("avx2")))
+    inline __m256i lower256(__m256i x) {
+        __m256i upper = inRange256(x, 'A', 'Z');
+        return _mm256_or_si256(x, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+    }
+
+    __attribute__((target("avx2")))
+    void classifyBlockAVX2(const char* in, char* out, uint64_t& word, uint64_t& letter) {
+        word = 0;
+        letter = 0;
+
+        for (int part = 0; part < 2; part++) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + part * 32));
+            __m256i lower = lower256(x);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + part * 32), lower);
+
+            __m256i letters = inRange256(lower, 'a', 'z');
+            __m256i words = _mm256_or_si256(letters,
+                            _mm256_or_si256(inRange256(x, '0', '9'),
+                                            _mm256_cmpeq_epi8(x, _mm256_set1_epi8('_'))));
+
+            word |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(words))) << (part * 32);
+            letter |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(letters))) << (part * 32);
+        }
+    }
+
+    __attribute__((target("avx2")))
+    void lowerAVX2(const char* in, size_t length, char* out) {
+        size_t i = 0;
+        for (; i + 32 <= length; i += 32) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), lower256(x));
+        }
+        lowerSSE2(in + i, length - i, out + i);
+    }
+
+#endif // TOKENIZER_X86
+
+    // ==================== DISPATCH ====================
+
+    struct Implementation {
+        ClassifyFn classify;
+        LowerFn lower;
+        const char* name;
+    };
+
+    Implementation selectImplementation() {
+#ifdef TOKENIZER_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return {classifyBlockAVX2, lowerAVX2, "avx2"};
+        }
+        return {classifyBlockSSE2, lowerSSE2, "sse2"};
+#else
+        return {classifyBlockScalar, lowerScalar, "scalar"};
+#endif
+    }
+
+    Implementation& implementation() {
+        static Implementation selected = selectImplementation();
+        return selected;
+    }
+
+    // Bits [from, to) set; from < 64, to <= 64
+    inline uint64_t bitRange(size_t from, size_t to) {
+        uint64_t high = (to >= 64) ? ~0ULL : ((1ULL << to) - 1);
+        return high & ~((1ULL << from) - 1);
+    }
+
+    inline size_t lowestBit(uint64_t mask) {
+        return static_cast<size_t>(__builtin_ctzll(mask));
+    }
+
+    /**
+     * Run-extraction state carried from one block to the next
+     */
+    struct RunState {
+        bool inRun;
+        size_t start;
+        bool hasNonLetter;
+    };
+
+    void emitRun(const std::string& normalized, RunState& state, size_t end,
+                 std::vector<Tokenizer::Token>& tokens) {
+        Tokenizer::Token token;
+        token.text = std::string_view(normalized.data() + state.start, end - state.start);
+        token.offset = state.start;
+        token.lettersOnly = !state.hasNonLetter;
+        tokens.push_back(token);
+        state.inRun = false;
+    }
+
+    /**
+     * Walk the word/letter bitmasks of one block and emit finished runs
+     */
+    void scanBlock(size_t base, size_t valid, uint64_t word, uint64_t letter,
+                   const std::string& normalized, RunState& state,
+                   std::vector<Tokenizer::Token>& tokens) {
+        uint64_t nonLetter = word & ~letter;
+        size_t pos = 0;
+
+        while (pos < valid) {
+            if (state.inRun) {
+                uint64_t breaks = ~word & bitRange(pos, valid);
+                if (breaks == 0) {
+                    // Run continues into the next block
+                    if (nonLetter & bitRange(pos, valid)) state.hasNonLetter = true;
+                    return;
+                }
+
+                size_t end = lowestBit(breaks);
+                if (nonLetter & bitRange(pos, end)) state.hasNonLetter = true;
+                emitRun(normalized, state, base + end, tokens);
+                pos = end;
+            } else {
+                uint64_t starts = word & bitRange(pos, valid);
+                if (starts == 0) return;
+
+                pos = lowestBit(starts);
+                state.inRun = true;
+                state.start = base + pos;
+                state.hasNonLetter = false;
+            }
+        }
+    }
+}
+
+void Tokenizer::tokenize(const char* data, size_t length,
+                         std::string& normalized, std::vector<Token>& tokens) {
+    normalized.resize(length);
+    tokens.clear();
+
+    if (length == 0) return;
+
+    char* out = &normalized[0];
+    ClassifyFn classify = implementation().classify;
+    RunState state = {false, 0, false};
+    size_t i = 0;
+
+    // Full blocks through the SIMD path
+    for (; i + BLOCK_SIZE <= length; i += BLOCK_SIZE) {
+        uint64_t word, letter;
+        classify(data + i, out + i, word, letter);
+        scanBlock(i, BLOCK_SIZE, word, letter, normalized, state, tokens);
+    }
+
+    // Tail through the scalar path
+    if (i < length) {
+        uint64_t word, letter;
+        classifyScalar(data + i, out + i, length - i, word, letter);
+        scanBlock(i, length - i, word, letter, normalized, state, tokens);
+    }
+
+    if (state.inRun) {
+        emitRun(normalized, state, length, tokens);
+    }
+}
+
+void Tokenizer::toLowerASCII(const char* input, size_t length, char* output) {
+    implementation().lower(input, length, output);
+}
+
+const char* Tokenizer::implementationName() {
+    return implementation().name;
+}
+
+bool Tokenizer::setImplementation(const std::string& name) {
+    if (name == "scalar") {
+        implementation() = {classifyBlockScalar, lowerScalar, "scalar"};
+        return true;
+    }
+#ifdef TOKENIZER_X86
+    if (name == "sse2") {
+        implementation() = {classifyBlockSSE2, lowerSSE2, "sse2"};
+        return true;
+    }
+    __builtin_cpu_init();
+    if (name == "avx2" && __builtin_cpu_supports("avx2")) {
+        implementation() = {classifyBlockAVX2, lowerAVX2, "avx2"};
+        return true;
+    }
+#endif
+    return false;
+}
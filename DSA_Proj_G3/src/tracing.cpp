@@ -0,0 +1,170 @@
+#include "tracing.h"
+#include "utils.h"
+#include <vector>
+#include <mutex>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+    // One slot per event; fields are atomics so a dump may read a ring
+    // while its thread keeps writing
+    struct Event {
+        std::atomic<const char*> name;
+        std::atomic<uint64_t> startNs;
+        std::atomic<uint64_t> durationNs;
+    };
+
+    // Written by one thread only; read by dumps
+    struct Ring {
+        int threadId;
+        size_t capacity;
+        Event* events;
+        std::atomic<uint64_t> written;  // Total events ever recorded
+    };
+
+    const std::chrono::steady_clock::time_point traceEpoch = std::chrono::steady_clock::now();
+
+    std::atomic<size_t> ringEvents(Tracing::Config().ringEvents);
+
+    // Leaked on purpose: threads may record during static destruction
+    std::mutex& ringsMutex() {
+        static std::mutex* mutex = new std::mutex();
+        return *mutex;
+    }
+
+    std::vector<Ring*>& rings() {
+        static std::vector<Ring*>* all = new std::vector<Ring*>();
+        return *all;
+    }
+
+    // The calling thread's ring, registered on its first event; rings
+    // outlive their threads so a dump still shows them
+    Ring* threadRing() {
+        thread_local Ring* ring = nullptr;
+        if (ring == nullptr) {
+            Ring* created = new Ring();
+            created->capacity = ringEvents.load(std::memory_order_relaxed);
+            created->events = new Event[created->capacity];
+            created->written.store(0, std::memory_order_relaxed);
+
+            std::lock_guard<std::mutex> lock(ringsMutex());
+            created->threadId = static_cast<int>(rings().size()) + 1;
+            rings().push_back(created);
+            ring = created;
+        }
+        return ring;
+    }
+}
+
+std::atomic<bool> Tracing::enabled(false);
+
+Tracing::Config::Config()
+    : enabled(false),
+      ringEvents(16384) {
+}
+
+Tracing::Config Tracing::Config::fromEnvironment() {
+    Config config;
+
+    const char* trace = std::getenv("AUTOCOMPLETE_TRACE");
+    if (trace != nullptr) {
+        std::string value = Utils::toLower(trace);
+        config.enabled = value == "on" || value == "1";
+    }
+
+    const char* events = std::getenv("AUTOCOMPLETE_TRACE_EVENTS");
+    if (events != nullptr && std::atoi(events) > 0) {
+        config.ringEvents = std::atoi(events);
+    }
+
+    return config;
+}
+
+void Tracing::configure(const Config& config) {
+    ringEvents.store(config.ringEvents, std::memory_order_relaxed);
+    setEnabled(config.enabled);
+}
+
+void Tracing::setEnabled(bool on) {
+    enabled.store(on, std::memory_order_relaxed);
+}
+
+uint64_t Tracing::now() {
+    auto elapsed = std::chrono::steady_clock::now() - traceEpoch;
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+void Tracing::record(const char* name, uint64_t startNs, uint64_t durationNs) {
+    Ring* ring = threadRing();
+    uint64_t sequence = ring->written.load(std::memory_order_relaxed);
+    Event& event = ring->events[sequence % ring->capacity];
+    event.name.store(name, std::memory_order_relaxed);
+    event.startNs.store(startNs, std::memory_order_relaxed);
+    event.durationNs.store(durationNs, std::memory_order_relaxed);
+    ring->written.store(sequence + 1, std::memory_order_release);
+}
+
+std::string Tracing::chromeTraceJSON() {
+    std::lock_guard<std::mutex> lock(ringsMutex());
+    std::ostringstream json;
+    json << "{\"traceEvents\":[";
+
+    bool first = true;
+    char number[32];
+    for (Ring* ring : rings()) {
+        json << (first ? "" : ",") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+             << ring->threadId << ",\"args\":{\"name\":\"thread " << ring->threadId << "\"}}";
+        first = false;
+
+        // Oldest surviving event first
+        uint64_t written = ring->written.load(std::memory_order_acquire);
+        uint64_t begin = written > ring->capacity ? written - ring->capacity : 0;
+        for (uint64_t sequence = begin; sequence < written; sequence++) {
+            const Event& event = ring->events[sequence % ring->capacity];
+            const char* name = event.name.load(std::memory_order_relaxed);
+            if (name == nullptr) continue;
+
+            json << ",{\"name\":\"" << name << "\",\"cat\":\"query\",\"ph\":\"X\"";
+            std::snprintf(number, sizeof(number), "%.3f", event.startNs.load(std::memory_order_relaxed) / 1000.0);
+            json << ",\"ts\":" << number;
+            std::snprintf(number, sizeof(number), "%.3f", event.durationNs.load(std::memory_order_relaxed) / 1000.0);
+            json << ",\"dur\":" << number;
+            json << ",\"pid\":1,\"tid\":" << ring->threadId << "}";
+        }
+    }
+
+    json << "],\"displayTimeUnit\":\"ns\"}";
+    return json.str();
+}
+
+bool Tracing::writeChromeTrace(const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        Utils::logError("Cannot write trace: " + filename);
+        return false;
+    }
+    file << chromeTraceJSON() << "\n";
+    return file.good();
+}
+
+void Tracing::clear() {
+    std::lock_guard<std::mutex> lock(ringsMutex());
+    for (Ring* ring : rings()) {
+        for (size_t i = 0; i < ring->capacity; i++) {
+            ring->events[i].name.store(nullptr, std::memory_order_relaxed);
+        }
+        ring->written.store(0, std::memory_order_release);
+    }
+}
+
+size_t Tracing::bufferedEvents() {
+    std::lock_guard<std::mutex> lock(ringsMutex());
+    size_t total = 0;
+    for (Ring* ring : rings()) {
+        uint64_t written = ring->written.load(std::memory_order_acquire);
+        total += written > ring->capacity ? ring->capacity : written;
+    }
+    return total;
+}
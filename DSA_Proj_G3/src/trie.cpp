@@ -1,9 +1,11 @@
 #include "trie.h"
 #include <algorithm>
+#include <climits>
+#include <cmath>
 
 // ==================== TrieNode Implementation ====================
 
-TrieNode::TrieNode() : isEndOfWord(false), frequency(0) {
+TrieNode::TrieNode() : isEndOfWord(false), inArena(false), frequency(0) {
     for (int i = 0; i < ALPHABET_SIZE; i++) {
         children[i] = nullptr;
     }
@@ -13,14 +15,50 @@ TrieNode::~TrieNode() {
     // Destructor handled by Trie destructor to avoid double deletion
 }
 
+int TrieNode::charToIndex(char ch) {
+    if (ch >= '0' && ch <= '9') {
+        return ch - '0';
+    }
+    
+    int lower = tolower(static_cast<unsigned char>(ch));
+    if (lower >= 'a' && lower <= 'z') {
+        return 10 + (lower - 'a');
+    }
+    
+    return -1;
+}
+
+char TrieNode::indexToChar(int index) {
+    return index < 10 ? char('0' + index) : char('a' + index - 10);
+}
+
 // ==================== Trie Implementation ====================
 
-Trie::Trie() {
+// Nodes per bulk-build block (about 300 KB): large enough to keep subtrees
+// contiguous, small enough that the unused tail of the last block is cheap
+static const size_t ARENA_BLOCK_NODES = 1024;
+
+// Default ranking blend: a fresh use is worth this many frequency points
+static const double DEFAULT_RECENCY_WEIGHT = 10.0;
+
+Trie::Trie()
+    : looseNodes(1),
+      recencyHalfLife(DecayedScore::DEFAULT_HALF_LIFE_SECONDS),
+      recencyWeight(DEFAULT_RECENCY_WEIGHT),
+      clock(DecayedScore::nowSeconds) {
     root = new TrieNode();
 }
 
+Trie::Trie(const std::vector<std::pair<std::string, int>>& sortedWords) : Trie() {
+    buildSorted(sortedWords);
+}
+
 Trie::~Trie() {
     destroyTrie(root);
+    
+    for (TrieNode* block : arenas) {
+        delete[] block;
+    }
 }
 
 void Trie::destroyTrie(TrieNode* node) {
@@ -31,7 +69,11 @@ void Trie::destroyTrie(TrieNode* node) {
             destroyTrie(node->children[i]);
         }
     }
-    delete node;
+    
+    // Bulk-built nodes are freed with their block
+    if (!node->inArena) {
+        delete node;
+    }
 }
 
 void Trie::insertWord(const std::string& word, int frequency) {
@@ -40,17 +82,18 @@ void Trie::insertWord(const std::string& word, int frequency) {
     TrieNode* current = root;
     
     for (char ch : word) {
-        // Convert to lowercase and get index (a=0, b=1, ..., z=25)
-        int index = tolower(ch) - 'a';
+        // Convert to child index (0-9 digits, 10-35 letters a-z)
+        int index = TrieNode::charToIndex(ch);
         
-        // Skip if character is not a-z
-        if (index < 0 || index >= TrieNode::ALPHABET_SIZE) {
+        // Skip characters the Trie does not index
+        if (index < 0) {
             continue;
         }
         
         // Create new node if path doesn't exist
         if (current->children[index] == nullptr) {
             current->children[index] = new TrieNode();
+            looseNodes++;
         }
         
         current = current->children[index];
@@ -61,15 +104,78 @@ void Trie::insertWord(const std::string& word, int frequency) {
     current->frequency = frequency;
 }
 
+void Trie::buildSorted(const std::vector<std::pair<std::string, int>>& sortedWords) {
+    buildSortedImpl(sortedWords);
+}
+
+void Trie::buildSorted(const std::vector<std::pair<std::string_view, int>>& sortedWords) {
+    buildSortedImpl(sortedWords);
+}
+
+template<typename Word>
+void Trie::buildSortedImpl(const std::vector<std::pair<Word, int>>& sortedWords) {
+    // Child-index path of the previous word and the nodes along it;
+    // path[0] is the root
+    std::vector<int> previousKey;
+    std::vector<int> key;
+    std::vector<TrieNode*> path(1, root);
+    
+    // Current node block: nodes are handed out in creation order, which
+    // for sorted input is DFS (preorder) order
+    TrieNode* block = nullptr;
+    size_t blockLeft = 0;
+    
+    for (const auto& entry : sortedWords) {
+        if (entry.first.empty()) continue;
+        
+        key.clear();
+        for (char ch : entry.first) {
+            int index = TrieNode::charToIndex(ch);
+            if (index >= 0) key.push_back(index);
+        }
+        
+        // Resume from the prefix shared with the previous word
+        size_t shared = 0;
+        while (shared < key.size() && shared < previousKey.size() && key[shared] == previousKey[shared]) {
+            shared++;
+        }
+        path.resize(shared + 1);
+        
+        TrieNode* current = path.back();
+        for (size_t depth = shared; depth < key.size(); depth++) {
+            TrieNode*& child = current->children[key[depth]];
+            
+            // Existing nodes (unsorted input, or a non-empty Trie) are reused
+            if (child == nullptr) {
+                if (blockLeft == 0) {
+                    block = new TrieNode[ARENA_BLOCK_NODES];
+                    arenas.push_back(block);
+                    blockLeft = ARENA_BLOCK_NODES;
+                }
+                child = block++;
+                child->inArena = true;
+                blockLeft--;
+            }
+            
+            current = child;
+            path.push_back(current);
+        }
+        
+        current->isEndOfWord = true;
+        current->frequency = entry.second;
+        previousKey.swap(key);
+    }
+}
+
 bool Trie::searchWord(const std::string& word) {
     if (word.empty()) return false;
     
     TrieNode* current = root;
     
     for (char ch : word) {
-        int index = tolower(ch) - 'a';
+        int index = TrieNode::charToIndex(ch);
         
-        if (index < 0 || index >= TrieNode::ALPHABET_SIZE) {
+        if (index < 0) {
             return false;
         }
         
@@ -83,6 +189,31 @@ bool Trie::searchWord(const std::string& word) {
     return current->isEndOfWord;
 }
 
+bool Trie::searchWordNormalized(std::string_view word) const {
+    if (word.empty()) return false;
+    
+    const TrieNode* current = root;
+    
+    for (char ch : word) {
+        // Input is already lowercase: no case folding needed
+        int index;
+        if (ch >= 'a' && ch <= 'z') {
+            index = 10 + (ch - 'a');
+        } else if (ch >= '0' && ch <= '9') {
+            index = ch - '0';
+        } else {
+            return false;
+        }
+        
+        current = current->children[index];
+        if (current == nullptr) {
+            return false;
+        }
+    }
+    
+    return current->isEndOfWord;
+}
+
 std::vector<std::pair<std::string, int>> Trie::searchPrefix(const std::string& prefix) {
     std::vector<std::pair<std::string, int>> results;
     
@@ -92,9 +223,9 @@ std::vector<std::pair<std::string, int>> Trie::searchPrefix(const std::string& p
     
     // Navigate to the end of the prefix
     for (char ch : prefix) {
-        int index = tolower(ch) - 'a';
+        int index = TrieNode::charToIndex(ch);
         
-        if (index < 0 || index >= TrieNode::ALPHABET_SIZE) {
+        if (index < 0) {
             return results;
         }
         
@@ -124,24 +255,81 @@ void Trie::collectWords(TrieNode* node, std::string currentWord,
     // Recursively collect words from all children
     for (int i = 0; i < TrieNode::ALPHABET_SIZE; i++) {
         if (node->children[i] != nullptr) {
-            collectWords(node->children[i], currentWord + char('a' + i), results);
+            collectWords(node->children[i], currentWord + TrieNode::indexToChar(i), results);
         }
     }
 }
 
-std::vector<std::string> Trie::suggestWords(const std::string& prefix, int maxResults) {
-    std::vector<std::pair<std::string, int>> matches = searchPrefix(prefix);
+// Ranking order: higher frequency first, then alphabetical
+static bool ranksHigher(const std::pair<std::string, int>& a, const std::pair<std::string, int>& b) {
+    if (a.second != b.second) return a.second > b.second;
+    return a.first < b.first;
+}
+
+int Trie::rankingScore(const TrieNode* node, uint32_t now) const {
+    if (node->recent.value == 0.0f) return node->frequency;
+    
+    double score = node->frequency + recencyWeight * node->recent.valueAt(now, recencyHalfLife);
+    return static_cast<int>(std::min<double>(std::llround(score), INT_MAX));
+}
+
+void Trie::collectTopK(const TrieNode* node, std::string& currentWord, size_t k, uint32_t now,
+                       std::vector<std::pair<std::string, int>>& heap) const {
+    if (node->isEndOfWord) {
+        int score = rankingScore(node, now);
+        if (heap.size() < k) {
+            heap.push_back({currentWord, score});
+            std::push_heap(heap.begin(), heap.end(), ranksHigher);
+        } else if (score > heap.front().second) {
+            // Words arrive in alphabetical order, so an equal score
+            // never beats the word already kept
+            std::pop_heap(heap.begin(), heap.end(), ranksHigher);
+            heap.back() = {currentWord, score};
+            std::push_heap(heap.begin(), heap.end(), ranksHigher);
+        }
+    }
     
-    // Sort by frequency (descending)
-    std::sort(matches.begin(), matches.end(), 
-              [](const auto& a, const auto& b) { return a.second > b.second; });
+    for (int i = 0; i < TrieNode::ALPHABET_SIZE; i++) {
+        if (node->children[i] != nullptr) {
+            currentWord.push_back(TrieNode::indexToChar(i));
+            collectTopK(node->children[i], currentWord, k, now, heap);
+            currentWord.pop_back();
+        }
+    }
+}
+
+std::vector<std::pair<std::string, int>> Trie::topKByFrequency(const std::string& prefix, int k) const {
+    std::vector<std::pair<std::string, int>> heap;
+    
+    if (prefix.empty() || k <= 0) return heap;
+    
+    const TrieNode* current = root;
+    std::string word;
     
-    // Extract top maxResults words
+    for (char ch : prefix) {
+        int index = TrieNode::charToIndex(ch);
+        
+        if (index < 0 || current->children[index] == nullptr) {
+            return heap;
+        }
+        
+        current = current->children[index];
+        word.push_back(TrieNode::indexToChar(index));
+    }
+    
+    heap.reserve(k);
+    collectTopK(current, word, static_cast<size_t>(k), clock(), heap);
+    
+    // O(k log k): heap order -> best first
+    std::sort_heap(heap.begin(), heap.end(), ranksHigher);
+    return heap;
+}
+
+std::vector<std::string> Trie::suggestWords(const std::string& prefix, int maxResults) {
     std::vector<std::string> suggestions;
-    int count = std::min(maxResults, static_cast<int>(matches.size()));
     
-    for (int i = 0; i < count; i++) {
-        suggestions.push_back(matches[i].first);
+    for (const auto& match : topKByFrequency(prefix, maxResults)) {
+        suggestions.push_back(match.first);
     }
     
     return suggestions;
@@ -153,9 +341,9 @@ void Trie::updateFrequency(const std::string& word, int increment) {
     TrieNode* current = root;
     
     for (char ch : word) {
-        int index = tolower(ch) - 'a';
+        int index = TrieNode::charToIndex(ch);
         
-        if (index < 0 || index >= TrieNode::ALPHABET_SIZE) {
+        if (index < 0) {
             return;
         }
         
@@ -171,6 +359,124 @@ void Trie::updateFrequency(const std::string& word, int increment) {
     }
 }
 
+TrieNode* Trie::findWordNode(const std::string& word) const {
+    if (word.empty()) return nullptr;
+    
+    TrieNode* current = root;
+    
+    for (char ch : word) {
+        int index = TrieNode::charToIndex(ch);
+        
+        // Skip characters the Trie does not index (as insertWord does)
+        if (index < 0) {
+            continue;
+        }
+        
+        if (current->children[index] == nullptr) {
+            return nullptr;
+        }
+        
+        current = current->children[index];
+    }
+    
+    return current->isEndOfWord && current != root ? current : nullptr;
+}
+
+bool Trie::setFrequency(const std::string& word, int frequency) {
+    TrieNode* node = findWordNode(word);
+    if (node == nullptr) return false;
+    
+    node->frequency = frequency;
+    return true;
+}
+
+bool Trie::recordUse(const std::string& word, double amount) {
+    TrieNode* node = findWordNode(word);
+    if (node == nullptr) return false;
+    
+    node->recent.add(amount, clock(), recencyHalfLife);
+    return true;
+}
+
+bool Trie::mergeRecentScore(const std::string& word, const DecayedScore& score) {
+    TrieNode* node = findWordNode(word);
+    if (node == nullptr) return false;
+    
+    node->recent.merge(score, recencyHalfLife);
+    return true;
+}
+
+double Trie::getRecentScore(const std::string& word) const {
+    const TrieNode* node = findWordNode(word);
+    return node == nullptr ? 0.0 : node->recent.valueAt(clock(), recencyHalfLife);
+}
+
+void Trie::setRecency(double halfLifeSeconds, double weight) {
+    recencyHalfLife = halfLifeSeconds;
+    recencyWeight = weight;
+}
+
+bool Trie::removeWord(const std::string& word) {
+    if (word.empty()) return false;
+    
+    // Path from the root, for pruning on the way back up
+    std::vector<std::pair<TrieNode*, int>> path;
+    path.reserve(word.length());
+    
+    TrieNode* current = root;
+    
+    for (char ch : word) {
+        int index = TrieNode::charToIndex(ch);
+        
+        if (index < 0) {
+            continue;
+        }
+        
+        if (current->children[index] == nullptr) {
+            return false;
+        }
+        
+        path.push_back({current, index});
+        current = current->children[index];
+    }
+    
+    if (!current->isEndOfWord || current == root) {
+        return false;
+    }
+    
+    current->isEndOfWord = false;
+    current->frequency = 0;
+    current->recent = DecayedScore();
+    
+    // Unlink nodes that no longer lead to any word, deepest first
+    for (size_t i = path.size(); i-- > 0; ) {
+        TrieNode* parent = path[i].first;
+        TrieNode* child = parent->children[path[i].second];
+        
+        if (child->isEndOfWord) break;
+        
+        bool hasChildren = false;
+        for (int c = 0; c < TrieNode::ALPHABET_SIZE && !hasChildren; c++) {
+            hasChildren = child->children[c] != nullptr;
+        }
+        if (hasChildren) break;
+        
+        parent->children[path[i].second] = nullptr;
+        if (!child->inArena) {
+            delete child;
+            looseNodes--;
+        }
+    }
+    
+    return true;
+}
+
+size_t Trie::getMemoryBytes() const {
+    return sizeof(Trie) + arenas.capacity() * sizeof(TrieNode*) +
+           arenas.size() * ARENA_BLOCK_NODES * sizeof(TrieNode) +
+           looseNodes * sizeof(TrieNode);
+}
+
 int Trie::getWordCount() {
     std::vector<std::pair<std::string, int>> allWords;
     collectWords(root, "", allWords);
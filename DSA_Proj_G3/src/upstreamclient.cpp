@@ -0,0 +1,902 @@
+#include "upstreamclient.h"
+#include "utils.h"
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <wininet.h>
+
+#pragma comment(lib, "wininet.lib")
+#else
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+#ifdef MSG_NOSIGNAL
+#define SEND_FLAGS MSG_NOSIGNAL
+#else
+#define SEND_FLAGS 0
+#endif
+
+namespace {
+
+    // Largest response body accepted from an upstream
+    const size_t MAX_RESPONSE_BYTES = 4 * 1024 * 1024;
+
+    // Largest response header block accepted
+    const size_t MAX_HEADER_BYTES = 64 * 1024;
+
+    /**
+     * Milliseconds left before the deadline (rounded up, 0 if passed)
+     */
+    int remainingMs(UpstreamClient::Deadline deadline) {
+        auto left = deadline - UpstreamClient::Clock::now();
+        if (left <= UpstreamClient::Clock::duration::zero()) return 0;
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(left).count();
+        return static_cast<int>(ms) + 1;
+    }
+
+    int positiveEnv(const char* name, int fallback) {
+        const char* value = std::getenv(name);
+        if (value == nullptr) return fallback;
+        int parsed = std::atoi(value);
+        return parsed > 0 ? parsed : fallback;
+    }
+
+#ifndef _WIN32
+
+    struct ParsedUrl {
+        std::string scheme;
+        std::string host;
+        int port;
+        std::string target;  // Path and query
+    };
+
+    bool parseUrl(const std::string& url, ParsedUrl& parsed) {
+        size_t schemeEnd = url.find("://");
+        if (schemeEnd == std::string::npos) return false;
+
+        parsed.scheme = Utils::toLower(url.substr(0, schemeEnd));
+        size_t hostStart = schemeEnd + 3;
+        size_t pathStart = url.find('/', hostStart);
+
+        std::string authority = url.substr(hostStart, pathStart == std::string::npos
+                                                          ? std::string::npos
+                                                          : pathStart - hostStart);
+        parsed.target = pathStart == std::string::npos ? "/" : url.substr(pathStart);
+        parsed.port = parsed.scheme == "https" ? 443 : 80;
+
+        size_t colon = authority.rfind(':');
+        if (colon != std::string::npos) {
+            parsed.port = std::atoi(authority.c_str() + colon + 1);
+            authority.resize(colon);
+        }
+        parsed.host = authority;
+
+        return !parsed.host.empty() && parsed.port > 0;
+    }
+
+    /**
+     * Wait for poll events on a socket until the deadline
+     * @return: true if the socket is ready, false on timeout or error
+     */
+    bool waitSocket(int socket, short events, UpstreamClient::Deadline deadline) {
+        while (true) {
+            int timeout = remainingMs(deadline);
+            if (timeout <= 0) return false;
+
+            pollfd entry;
+            entry.fd = socket;
+            entry.events = events;
+            entry.revents = 0;
+
+            int ready = poll(&entry, 1, timeout);
+            if (ready > 0) return true;
+            if (ready == 0 || errno != EINTR) return false;
+        }
+    }
+
+    enum class ReadStatus { Data, Closed, Error, Timeout };
+
+    /**
+     * Append whatever the socket has to the buffer
+     */
+    ReadStatus readSome(int socket, std::string& buffer, UpstreamClient::Deadline deadline) {
+        char chunk[16384];
+        while (true) {
+            if (!waitSocket(socket, POLLIN, deadline)) {
+                return remainingMs(deadline) <= 0 ? ReadStatus::Timeout : ReadStatus::Error;
+            }
+
+            ssize_t n = recv(socket, chunk, sizeof(chunk), 0);
+            if (n > 0) {
+                buffer.append(chunk, static_cast<size_t>(n));
+                return ReadStatus::Data;
+            }
+            if (n == 0) return ReadStatus::Closed;
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                return ReadStatus::Error;
+            }
+        }
+    }
+
+    bool sendAll(int socket, const std::string& data, UpstreamClient::Deadline deadline) {
+        size_t sent = 0;
+        while (sent < data.length()) {
+            ssize_t n = send(socket, data.c_str() + sent, data.length() - sent, SEND_FLAGS);
+            if (n > 0) {
+                sent += static_cast<size_t>(n);
+                continue;
+            }
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+                if (!waitSocket(socket, POLLOUT, deadline)) return false;
+                continue;
+            }
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Value of a header in a lowercased header block ("" if absent)
+     */
+    std::string headerValue(const std::string& head, const std::string& name) {
+        size_t pos = head.find("\r\n" + name + ":");
+        if (pos == std::string::npos) return "";
+
+        size_t valueStart = pos + name.length() + 3;
+        size_t valueEnd = head.find("\r\n", valueStart);
+        return Utils::trim(head.substr(valueStart, valueEnd == std::string::npos
+                                                       ? std::string::npos
+                                                       : valueEnd - valueStart));
+    }
+
+    /**
+     * Reads one HTTP/1.1 response from a socket before a deadline
+     */
+    class ResponseReader {
+    private:
+        int socket;
+        UpstreamClient::Deadline deadline;
+        std::string buffer;
+
+    public:
+        bool timedOut;
+        std::string error;
+
+        ResponseReader(int socket, UpstreamClient::Deadline deadline)
+            : socket(socket), deadline(deadline), timedOut(false) {}
+
+        bool receivedAny() const { return !buffer.empty(); }
+
+        /**
+         * Read until the buffer holds at least size bytes
+         */
+        bool fill(size_t size) {
+            while (buffer.size() < size) {
+                if (!more()) return false;
+            }
+            return true;
+        }
+
+        /**
+         * Read until a CRLF appears at or after pos
+         */
+        bool fillLine(size_t pos, size_t& lineEnd) {
+            while ((lineEnd = buffer.find("\r\n", pos)) == std::string::npos) {
+                if (buffer.size() > MAX_HEADER_BYTES + pos) {
+                    error = "Malformed response";
+                    return false;
+                }
+                if (!more()) return false;
+            }
+            return true;
+        }
+
+        bool more() {
+            switch (readSome(socket, buffer, deadline)) {
+                case ReadStatus::Data:
+                    return true;
+                case ReadStatus::Closed:
+                    error = "Connection closed by upstream";
+                    return false;
+                case ReadStatus::Timeout:
+                    timedOut = true;
+                    error = "Deadline exceeded";
+                    return false;
+                default:
+                    error = std::string("Receive failed: ") + std::strerror(errno);
+                    return false;
+            }
+        }
+
+        /**
+         * Read status, headers and body
+         * @param keepAlive: Set if the connection can carry another request
+         */
+        bool read(int& status, std::string& body, bool& keepAlive) {
+            size_t headerEnd;
+            while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+                if (buffer.size() > MAX_HEADER_BYTES) {
+                    error = "Response headers too large";
+                    return false;
+                }
+                if (!more()) return false;
+            }
+
+            std::string head = Utils::toLower(buffer.substr(0, headerEnd + 2));
+            size_t space = head.find(' ');
+            status = space == std::string::npos ? 0 : std::atoi(head.c_str() + space + 1);
+            if (status < 100) {
+                error = "Malformed status line";
+                return false;
+            }
+
+            std::string connection = headerValue(head, "connection");
+            keepAlive = head.compare(0, 8, "http/1.0") != 0;
+            if (connection.find("close") != std::string::npos) keepAlive = false;
+            if (connection.find("keep-alive") != std::string::npos) keepAlive = true;
+
+            std::string contentLength = headerValue(head, "content-length");
+            bool chunked = headerValue(head, "transfer-encoding").find("chunked") != std::string::npos;
+            buffer.erase(0, headerEnd + 4);
+            body.clear();
+
+            if (status == 204 || status == 304) {
+                return true;
+            }
+
+            if (chunked) {
+                return readChunked(body);
+            }
+
+            if (!contentLength.empty()) {
+                size_t length = std::strtoul(contentLength.c_str(), nullptr, 10);
+                if (length > MAX_RESPONSE_BYTES) {
+                    error = "Response too large";
+                    return false;
+                }
+                if (!fill(length)) return false;
+                body.assign(buffer, 0, length);
+                return true;
+            }
+
+            // No framing: the body ends when the upstream closes the connection
+            keepAlive = false;
+            while (true) {
+                ReadStatus result = readSome(socket, buffer, deadline);
+                if (result == ReadStatus::Closed) break;
+                if (result != ReadStatus::Data) {
+                    timedOut = result == ReadStatus::Timeout;
+                    error = timedOut ? "Deadline exceeded" : "Receive failed";
+                    return false;
+                }
+                if (buffer.size() > MAX_RESPONSE_BYTES) {
+                    error = "Response too large";
+                    return false;
+                }
+            }
+            body.swap(buffer);
+            return true;
+        }
+
+        bool readChunked(std::string& body) {
+            size_t pos = 0;
+            while (true) {
+                size_t lineEnd;
+                if (!fillLine(pos, lineEnd)) return false;
+
+                size_t size = std::strtoul(buffer.c_str() + pos, nullptr, 16);
+                pos = lineEnd + 2;
+
+                if (size == 0) {
+                    // Skip trailers up to the terminating blank line
+                    while (true) {
+                        if (!fillLine(pos, lineEnd)) return false;
+                        bool blank = lineEnd == pos;
+                        pos = lineEnd + 2;
+                        if (blank) return true;
+                    }
+                }
+
+                if (body.size() + size > MAX_RESPONSE_BYTES) {
+                    error = "Response too large";
+                    return false;
+                }
+                if (!fill(pos + size + 2)) return false;
+                body.append(buffer, pos, size);
+                pos += size + 2;
+            }
+        }
+    };
+
+#endif // !_WIN32
+}
+
+// ==================== CircuitBreaker Implementation ====================
+
+CircuitBreaker::CircuitBreaker(int failureThreshold, int openMs)
+    : failureThreshold(failureThreshold > 0 ? failureThreshold : 1),
+      openMs(openMs), consecutiveFailures(0), trialInFlight(false),
+      state(State::Closed) {
+}
+
+bool CircuitBreaker::allowRequest() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (state == State::Closed) {
+        return true;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    bool cooledDown = now - openedAt >= std::chrono::milliseconds(openMs);
+
+    if (state == State::Open) {
+        if (!cooledDown) return false;
+        state = State::HalfOpen;
+    } else if (trialInFlight && !cooledDown) {
+        return false;  // Half-open: a trial request is already out
+    }
+
+    // Let one trial request through
+    trialInFlight = true;
+    openedAt = now;
+    return true;
+}
+
+void CircuitBreaker::recordSuccess() {
+    std::lock_guard<std::mutex> lock(mutex);
+    consecutiveFailures = 0;
+    trialInFlight = false;
+    state = State::Closed;
+}
+
+bool CircuitBreaker::recordFailure() {
+    std::lock_guard<std::mutex> lock(mutex);
+    consecutiveFailures++;
+    trialInFlight = false;
+
+    if (state == State::HalfOpen ||
+        (state == State::Closed && consecutiveFailures >= failureThreshold)) {
+        bool opened = state == State::Closed;
+        state = State::Open;
+        openedAt = std::chrono::steady_clock::now();
+        return opened;
+    }
+
+    return false;
+}
+
+CircuitBreaker::State CircuitBreaker::getState() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return state;
+}
+
+const char* CircuitBreaker::stateName(State state) {
+    switch (state) {
+        case State::Closed:   return "closed";
+        case State::Open:     return "open";
+        case State::HalfOpen: return "half-open";
+    }
+    return "unknown";
+}
+
+// ==================== UpstreamClient Implementation ====================
+
+UpstreamClient::Config::Config()
+    : datamuseBaseUrl("https://api.datamuse.com"),
+      dictionaryBaseUrl("https://api.dictionaryapi.dev/api/v2/entries/en"),
+      timeoutMs(800), workerThreads(4), maxQueuedRequests(64), maxIdlePerHost(4),
+      cacheCapacity(1000), cacheTtlMs(5 * 60 * 1000),
+      failureThreshold(3), breakerOpenMs(10000) {
+}
+
+UpstreamClient::Config UpstreamClient::Config::fromEnvironment() {
+    Config config;
+
+    const char* datamuse = std::getenv("AUTOCOMPLETE_DATAMUSE_URL");
+    if (datamuse != nullptr && *datamuse != '\0') config.datamuseBaseUrl = datamuse;
+
+    const char* dictionary = std::getenv("AUTOCOMPLETE_DICTIONARY_URL");
+    if (dictionary != nullptr && *dictionary != '\0') config.dictionaryBaseUrl = dictionary;
+
+    config.timeoutMs = positiveEnv("AUTOCOMPLETE_UPSTREAM_TIMEOUT_MS", config.timeoutMs);
+    config.cacheTtlMs = positiveEnv("AUTOCOMPLETE_UPSTREAM_CACHE_TTL_MS", config.cacheTtlMs);
+
+    return config;
+}
+
+UpstreamClient::UpstreamClient(const Config& clientConfig)
+    : config(clientConfig), stopping(false),
+      cache(clientConfig.cacheCapacity, clientConfig.cacheTtlMs),
+      datamuseBreaker(clientConfig.failureThreshold, clientConfig.breakerOpenMs),
+      dictionaryBreaker(clientConfig.failureThreshold, clientConfig.breakerOpenMs),
+      requests(0), cacheHits(0), networkRequests(0), connectionsOpened(0),
+      connectionsReused(0), failures(0), timeouts(0), shortCircuited(0), prefetches(0) {
+
+    // Strip trailing slashes so endpoint paths can be appended
+    while (!config.datamuseBaseUrl.empty() && config.datamuseBaseUrl.back() == '/') {
+        config.datamuseBaseUrl.pop_back();
+    }
+    while (!config.dictionaryBaseUrl.empty() && config.dictionaryBaseUrl.back() == '/') {
+        config.dictionaryBaseUrl.pop_back();
+    }
+
+#ifdef _WIN32
+    // One session for all requests: WinINet pools connections per session
+    HINTERNET handle = InternetOpenA("SmartAutocomplete/1.0", INTERNET_OPEN_TYPE_PRECONFIG,
+                                     NULL, NULL, 0);
+    if (handle) {
+        DWORD timeout = static_cast<DWORD>(config.timeoutMs);
+        InternetSetOptionA(handle, INTERNET_OPTION_CONNECT_TIMEOUT, &timeout, sizeof(timeout));
+        InternetSetOptionA(handle, INTERNET_OPTION_SEND_TIMEOUT, &timeout, sizeof(timeout));
+        InternetSetOptionA(handle, INTERNET_OPTION_RECEIVE_TIMEOUT, &timeout, sizeof(timeout));
+    } else {
+        Utils::logError("Failed to initialize WinINet");
+    }
+    session = handle;
+#endif
+
+    int threads = config.workerThreads > 0 ? config.workerThreads : 1;
+    for (int i = 0; i < threads; i++) {
+        workers.emplace_back(&UpstreamClient::workerLoop, this);
+    }
+}
+
+UpstreamClient::~UpstreamClient() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueReady.notify_all();
+
+    // Queued calls still run: each is bounded by its deadline
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+#ifdef _WIN32
+    if (session) {
+        InternetCloseHandle(static_cast<HINTERNET>(session));
+    }
+#else
+    for (auto& host : idleConnections) {
+        for (int socket : host.second) {
+            close(socket);
+        }
+    }
+#endif
+}
+
+void UpstreamClient::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueReady.wait(lock, [this]() { return stopping || !queue.empty(); });
+
+            if (queue.empty()) {
+                return;  // Stopping and drained
+            }
+
+            task = std::move(queue.front());
+            queue.pop_front();
+        }
+        task();
+    }
+}
+
+bool UpstreamClient::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (stopping || static_cast<int>(queue.size()) >= config.maxQueuedRequests) {
+            return false;
+        }
+        queue.push_back(std::move(task));
+    }
+    queueReady.notify_one();
+    return true;
+}
+
+UpstreamClient::Deadline UpstreamClient::defaultDeadline() const {
+    return Clock::now() + std::chrono::milliseconds(config.timeoutMs);
+}
+
+#ifdef _WIN32
+
+UpstreamClient::HttpResult UpstreamClient::httpGet(const std::string& url, Deadline deadline) {
+    HttpResult result;
+
+    if (!session) {
+        result.error = "WinINet not initialized";
+        return result;
+    }
+
+    networkRequests++;
+
+    HINTERNET request = InternetOpenUrlA(
+        static_cast<HINTERNET>(session),
+        url.c_str(),
+        "Accept: application/json\r\n",
+        static_cast<DWORD>(-1),
+        INTERNET_FLAG_RELOAD | INTERNET_FLAG_NO_CACHE_WRITE | INTERNET_FLAG_KEEP_CONNECTION,
+        0
+    );
+
+    if (!request) {
+        result.timedOut = GetLastError() == ERROR_INTERNET_TIMEOUT;
+        result.error = result.timedOut ? "Deadline exceeded" : "Failed to connect to URL";
+        return result;
+    }
+
+    DWORD status = 0;
+    DWORD statusLength = sizeof(status);
+    HttpQueryInfoA(request, HTTP_QUERY_STATUS_CODE | HTTP_QUERY_FLAG_NUMBER,
+                   &status, &statusLength, NULL);
+    result.status = static_cast<int>(status);
+
+    // Read response, checking the deadline between reads
+    char buffer[4096];
+    DWORD bytesRead = 0;
+    while (InternetReadFile(request, buffer, sizeof(buffer), &bytesRead) && bytesRead > 0) {
+        result.body.append(buffer, bytesRead);
+        if (remainingMs(deadline) <= 0 || result.body.size() > MAX_RESPONSE_BYTES) {
+            result.timedOut = remainingMs(deadline) <= 0;
+            result.error = result.timedOut ? "Deadline exceeded" : "Response too large";
+            InternetCloseHandle(request);
+            return result;
+        }
+    }
+
+    InternetCloseHandle(request);
+    result.ok = true;
+    return result;
+}
+
+#else
+
+int UpstreamClient::acquireConnection(const std::string& host, int port, Deadline deadline,
+                                      bool& reused, std::string& error) {
+    std::string key = host + ":" + std::to_string(port);
+    reused = false;
+
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        std::vector<int>& idle = idleConnections[key];
+
+        while (!idle.empty()) {
+            int socket = idle.back();
+            idle.pop_back();
+
+            // An idle socket that is readable was closed by the upstream
+            pollfd entry;
+            entry.fd = socket;
+            entry.events = POLLIN;
+            entry.revents = 0;
+            if (poll(&entry, 1, 0) == 0) {
+                reused = true;
+                connectionsReused++;
+                return socket;
+            }
+            close(socket);
+        }
+    }
+
+    addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo* addresses = nullptr;
+    int status = getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addresses);
+    if (status != 0) {
+        error = "Cannot resolve " + host + ": " + gai_strerror(status);
+        return -1;
+    }
+
+    int connected = -1;
+    for (addrinfo* address = addresses; address != nullptr && connected < 0; address = address->ai_next) {
+        int socket = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (socket < 0) continue;
+
+        fcntl(socket, F_SETFL, fcntl(socket, F_GETFL, 0) | O_NONBLOCK);
+
+        int result = connect(socket, address->ai_addr, address->ai_addrlen);
+        if (result != 0 && errno == EINPROGRESS) {
+            if (waitSocket(socket, POLLOUT, deadline)) {
+                int socketError = 0;
+                socklen_t length = sizeof(socketError);
+                getsockopt(socket, SOL_SOCKET, SO_ERROR, &socketError, &length);
+                result = socketError == 0 ? 0 : -1;
+                errno = socketError;
+            } else {
+                errno = ETIMEDOUT;
+            }
+        }
+
+        if (result == 0) {
+            connected = socket;
+        } else {
+            error = "Cannot connect to " + host + ":" + std::to_string(port) + ": " + std::strerror(errno);
+            close(socket);
+        }
+    }
+    freeaddrinfo(addresses);
+
+    if (connected >= 0) {
+        int noDelay = 1;
+        setsockopt(connected, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        connectionsOpened++;
+    }
+
+    return connected;
+}
+
+void UpstreamClient::releaseConnection(const std::string& host, int port, int socket) {
+    std::string key = host + ":" + std::to_string(port);
+    std::lock_guard<std::mutex> lock(poolMutex);
+
+    std::vector<int>& idle = idleConnections[key];
+    if (static_cast<int>(idle.size()) < config.maxIdlePerHost) {
+        idle.push_back(socket);
+    } else {
+        close(socket);
+    }
+}
+
+UpstreamClient::HttpResult UpstreamClient::httpGet(const std::string& url, Deadline deadline) {
+    HttpResult result;
+
+    ParsedUrl parsed;
+    if (!parseUrl(url, parsed)) {
+        result.error = "Invalid URL: " + url;
+        return result;
+    }
+    if (parsed.scheme != "http") {
+        result.error = "Unsupported scheme '" + parsed.scheme + "' (no TLS support on this platform)";
+        return result;
+    }
+
+    std::string hostHeader = parsed.host;
+    if (parsed.port != 80) hostHeader += ":" + std::to_string(parsed.port);
+
+    std::string request = "GET " + parsed.target + " HTTP/1.1\r\n"
+                          "Host: " + hostHeader + "\r\n"
+                          "User-Agent: SmartAutocomplete/1.0\r\n"
+                          "Accept: application/json\r\n"
+                          "Connection: keep-alive\r\n"
+                          "\r\n";
+
+    // A pooled connection may have been closed by the upstream in the
+    // meantime: retry once on a fresh connection if nothing came back
+    for (int attempt = 0; attempt < 2; attempt++) {
+        result = HttpResult();
+
+        bool reused = false;
+        int socket = acquireConnection(parsed.host, parsed.port, deadline, reused, result.error);
+        if (socket < 0) {
+            result.timedOut = remainingMs(deadline) <= 0;
+            return result;
+        }
+
+        networkRequests++;
+
+        ResponseReader reader(socket, deadline);
+        bool keepAlive = false;
+
+        if (!sendAll(socket, request, deadline)) {
+            result.timedOut = remainingMs(deadline) <= 0;
+            result.error = result.timedOut ? "Deadline exceeded" : "Send failed";
+        } else if (reader.read(result.status, result.body, keepAlive)) {
+            result.ok = true;
+            if (keepAlive) {
+                releaseConnection(parsed.host, parsed.port, socket);
+            } else {
+                close(socket);
+            }
+            return result;
+        } else {
+            result.timedOut = reader.timedOut;
+            result.error = reader.error;
+        }
+
+        close(socket);
+
+        if (!reused || result.timedOut || reader.receivedAny()) {
+            break;
+        }
+    }
+
+    return result;
+}
+
+#endif // _WIN32
+
+void UpstreamClient::fetch(const std::string& url, CircuitBreaker& breaker, bool notFoundIsEmpty,
+                           Deadline deadline, const std::function<void(const HttpResult&)>& done) {
+    requests++;
+
+    HttpResult cached;
+    bool hit;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        hit = cache.get(url, cached.body);
+    }
+
+    if (hit) {
+        cacheHits++;
+        cached.ok = true;
+        cached.cached = true;
+        cached.status = 200;
+        done(cached);
+        return;
+    }
+
+    // Open circuit: answer right away so the caller falls back to local data
+    if (!breaker.allowRequest()) {
+        shortCircuited++;
+        HttpResult rejected;
+        rejected.error = "Circuit open";
+        done(rejected);
+        return;
+    }
+
+    bool queued = submit([this, url, &breaker, notFoundIsEmpty, deadline, done]() {
+        HttpResult response;
+        if (Clock::now() >= deadline) {
+            response.timedOut = true;
+            response.error = "Deadline exceeded before the request started";
+        } else {
+            response = httpGet(url, deadline);
+        }
+
+        bool success = response.ok &&
+                       ((response.status >= 200 && response.status < 300) ||
+                        (notFoundIsEmpty && response.status == 404));
+
+        if (success) {
+            if (response.status == 404) response.body.clear();
+            breaker.recordSuccess();
+            std::lock_guard<std::mutex> lock(cacheMutex);
+            cache.put(url, response.body);
+        } else {
+            if (response.ok) {
+                response.ok = false;
+                response.error = "HTTP " + std::to_string(response.status);
+            }
+
+            failures++;
+            if (response.timedOut) timeouts++;
+
+            if (breaker.recordFailure()) {
+                Utils::logWarning("Upstream circuit opened (" + response.error + "), using local data");
+            }
+        }
+
+        done(response);
+    });
+
+    if (!queued) {
+        shortCircuited++;
+        HttpResult rejected;
+        rejected.error = "Upstream queue full";
+        done(rejected);
+    }
+}
+
+std::future<UpstreamClient::SuggestionResult> UpstreamClient::fetchSuggestions(const std::string& url,
+                                                                              Deadline deadline) {
+    auto promise = std::make_shared<std::promise<SuggestionResult>>();
+    std::future<SuggestionResult> future = promise->get_future();
+
+    fetch(url, datamuseBreaker, false, deadline, [promise](const HttpResult& response) {
+        SuggestionResult result;
+        result.ok = response.ok;
+        result.cached = response.cached;
+        result.error = response.error;
+        if (response.ok) {
+            result.suggestions = APIFetcher::parseSuggestions(response.body);
+        }
+        promise->set_value(result);
+    });
+
+    return future;
+}
+
+std::string UpstreamClient::autocompleteUrl(const std::string& prefix, int maxResults) const {
+    return config.datamuseBaseUrl + "/sug?s=" + APIFetcher::urlEncode(prefix) +
+           "&max=" + std::to_string(maxResults);
+}
+
+std::string UpstreamClient::spellingUrl(const std::string& word, int maxResults) const {
+    return config.datamuseBaseUrl + "/words?sp=" + APIFetcher::urlEncode(word) +
+           "&max=" + std::to_string(maxResults);
+}
+
+std::future<UpstreamClient::SuggestionResult> UpstreamClient::fetchAutocompleteAsync(
+    const std::string& prefix, int maxResults, Deadline deadline) {
+    if (prefix.empty()) {
+        std::promise<SuggestionResult> empty;
+        SuggestionResult result;
+        result.ok = true;
+        empty.set_value(result);
+        return empty.get_future();
+    }
+
+    return fetchSuggestions(autocompleteUrl(prefix, maxResults), deadline);
+}
+
+std::future<UpstreamClient::SuggestionResult> UpstreamClient::fetchSpellingAsync(
+    const std::string& word, int maxResults, Deadline deadline) {
+    if (word.empty()) {
+        std::promise<SuggestionResult> empty;
+        SuggestionResult result;
+        result.ok = true;
+        empty.set_value(result);
+        return empty.get_future();
+    }
+
+    return fetchSuggestions(spellingUrl(word, maxResults), deadline);
+}
+
+std::future<UpstreamClient::DefinitionResult> UpstreamClient::fetchDefinitionAsync(
+    const std::string& word, Deadline deadline) {
+    auto promise = std::make_shared<std::promise<DefinitionResult>>();
+    std::future<DefinitionResult> future = promise->get_future();
+
+    std::string url = config.dictionaryBaseUrl + "/" + APIFetcher::urlEncode(word);
+
+    // DictionaryAPI answers 404 for unknown words: a valid "not found"
+    fetch(url, dictionaryBreaker, true, deadline, [promise, word](const HttpResult& response) {
+        DefinitionResult result;
+        result.ok = response.ok;
+        result.cached = response.cached;
+        result.error = response.error;
+        result.entry = APIFetcher::parseDefinition(word, response.ok ? response.body : "");
+        promise->set_value(result);
+    });
+
+    return future;
+}
+
+bool UpstreamClient::prefetchAutocomplete(const std::string& prefix, int maxResults) {
+    if (prefix.empty()) return false;
+
+    std::string url = autocompleteUrl(prefix, maxResults);
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        if (cache.contains(url)) return false;
+    }
+
+    // The result lands in the cache; nobody waits on the future
+    prefetches++;
+    fetchSuggestions(url, defaultDeadline());
+    return true;
+}
+
+UpstreamClient::Stats UpstreamClient::getStats() const {
+    Stats stats;
+    stats.requests = requests.load();
+    stats.cacheHits = cacheHits.load();
+    stats.networkRequests = networkRequests.load();
+    stats.connectionsOpened = connectionsOpened.load();
+    stats.connectionsReused = connectionsReused.load();
+    stats.failures = failures.load();
+    stats.timeouts = timeouts.load();
+    stats.shortCircuited = shortCircuited.load();
+    stats.prefetches = prefetches.load();
+    return stats;
+}
+
+void UpstreamClient::clearCache() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    cache.clear();
+}
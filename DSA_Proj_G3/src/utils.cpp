@@ -1,4 +1,5 @@
 #include "utils.h"
+#include "tokenizer.h"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
@@ -8,32 +9,38 @@
 #include <cctype>
 #include <cstdlib>
 #include <algorithm>
+#include <cstdio>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
 
 // ==================== Timer Implementation ====================
 
+// steady_clock: monotonic, unlike the system clock that
+// high_resolution_clock may alias
+
 Utils::Timer::Timer() : running(false) {
 }
 
 void Utils::Timer::start() {
-    startTime = std::chrono::high_resolution_clock::now();
+    startTime = std::chrono::steady_clock::now();
     running = true;
 }
 
 void Utils::Timer::stop() {
-    endTime = std::chrono::high_resolution_clock::now();
+    endTime = std::chrono::steady_clock::now();
     running = false;
 }
 
 double Utils::Timer::elapsedMilliseconds() {
-    auto end = running ? std::chrono::high_resolution_clock::now() : endTime;
-    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - startTime);
-    return duration.count() / 1000.0;
+    auto end = running ? std::chrono::steady_clock::now() : endTime;
+    return std::chrono::duration<double, std::milli>(end - startTime).count();
 }
 
 double Utils::Timer::elapsedMicroseconds() {
-    auto end = running ? std::chrono::high_resolution_clock::now() : endTime;
-    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - startTime);
-    return duration.count();
+    auto end = running ? std::chrono::steady_clock::now() : endTime;
+    return std::chrono::duration<double, std::micro>(end - startTime).count();
 }
 
 void Utils::Timer::reset() {
@@ -44,8 +51,8 @@ void Utils::Timer::reset() {
 
 std::string Utils::toLower(const std::string& str) {
     std::string result = str;
-    for (char& c : result) {
-        c = std::tolower(static_cast<unsigned char>(c));
+    if (!result.empty()) {
+        Tokenizer::toLowerASCII(str.data(), str.length(), &result[0]);
     }
     return result;
 }
@@ -100,8 +107,15 @@ std::string Utils::join(const std::vector<std::string>& vec, const std::string&
 
 // ==================== Logging Utilities ====================
 
+static bool logToStderr = false;
+
+void Utils::setLogToStderr(bool enabled) {
+    logToStderr = enabled;
+}
+
 void Utils::log(const std::string& message, const std::string& level) {
-    std::cout << "[" << getCurrentTimestamp() << "] [" << level << "] " << message << std::endl;
+    std::ostream& out = logToStderr ? std::cerr : std::cout;
+    out << "[" << getCurrentTimestamp() << "] [" << level << "] " << message << std::endl;
 }
 
 void Utils::logError(const std::string& message) {
@@ -155,6 +169,17 @@ std::string Utils::formatDouble(double value, int precision) {
 
 // ==================== Statistics Utilities ====================
 
+std::string Utils::formatBytes(size_t bytes) {
+    const char* units[] = {"B", "KB", "MB", "GB", "TB"};
+    double value = static_cast<double>(bytes);
+    int unit = 0;
+    while (value >= 1024.0 && unit < 4) {
+        value /= 1024.0;
+        unit++;
+    }
+    return unit == 0 ? std::to_string(bytes) + " B" : formatDouble(value, 2) + " " + units[unit];
+}
+
 double Utils::average(const std::vector<double>& values) {
     if (values.empty()) return 0.0;
     
@@ -177,8 +202,33 @@ double Utils::standardDeviation(const std::vector<double>& values) {
 }
 
 double Utils::getMemoryUsageMB() {
-    // This is a placeholder - actual implementation would be platform-specific
-    return 0.0;
+    return getResidentMemoryBytes() / (1024.0 * 1024.0);
+}
+
+size_t Utils::getResidentMemoryBytes() {
+#ifdef __linux__
+    // statm: total program size, then resident pages
+    std::FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (statm == nullptr) return 0;
+    unsigned long totalPages = 0;
+    unsigned long residentPages = 0;
+    int fields = std::fscanf(statm, "%lu %lu", &totalPages, &residentPages);
+    std::fclose(statm);
+    if (fields != 2) return 0;
+    return static_cast<size_t>(residentPages) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
+
+size_t Utils::stringHeapBytes(const std::string& str) {
+    // An inline buffer lies within the string object
+    const char* data = str.data();
+    const char* object = reinterpret_cast<const char*>(&str);
+    if (data >= object && data < object + sizeof(std::string)) {
+        return 0;
+    }
+    return str.capacity() + 1;  // Plus the terminator
 }
 
 // ==================== Display Utilities ====================
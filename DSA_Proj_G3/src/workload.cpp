@@ -0,0 +1,263 @@
+#include "workload.h"
+#include "bloomfilter.h"
+#include "sort.h"
+#include <algorithm>
+#include <cmath>
+
+// ==================== ZIPF DISTRIBUTION ====================
+
+namespace {
+    // log1p(x) / x, stable near 0
+    double helper1(double x) {
+        if (std::fabs(x) > 1e-8) {
+            return std::log1p(x) / x;
+        }
+        return 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+    }
+
+    // expm1(x) / x, stable near 0
+    double helper2(double x) {
+        if (std::fabs(x) > 1e-8) {
+            return std::expm1(x) / x;
+        }
+        return 1.0 + x * 0.5 * (1.0 + x * (1.0 / 3.0) * (1.0 + 0.25 * x));
+    }
+}
+
+ZipfDistribution::ZipfDistribution(uint64_t ranks, double skew)
+    : n(ranks < 1 ? 1 : ranks), exponent(skew > 0 ? skew : 1.0) {
+    hIntegralX1 = hIntegral(1.5) - 1.0;
+    hIntegralN = hIntegral(n + 0.5);
+    threshold = 2.0 - hIntegralInverse(hIntegral(2.5) - h(2.0));
+}
+
+double ZipfDistribution::h(double x) const {
+    return std::exp(-exponent * std::log(x));
+}
+
+double ZipfDistribution::hIntegral(double x) const {
+    double logX = std::log(x);
+    return helper2((1.0 - exponent) * logX) * logX;
+}
+
+double ZipfDistribution::hIntegralInverse(double x) const {
+    double t = x * (1.0 - exponent);
+    if (t < -1.0) {
+        t = -1.0;   // Rounding error guard
+    }
+    return std::exp(helper1(t) * x);
+}
+
+uint64_t ZipfDistribution::sample(std::mt19937_64& rng) const {
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    while (true) {
+        double u = hIntegralN + uniform(rng) * (hIntegralX1 - hIntegralN);
+        double x = hIntegralInverse(u);
+
+        double rounded = std::floor(x + 0.5);
+        uint64_t k = rounded < 1 ? 1 : (rounded > n ? n : static_cast<uint64_t>(rounded));
+
+        // Accept right away in the region where the hat fits exactly,
+        // otherwise compare against the true probability mass
+        if (k - x <= threshold || u >= hIntegral(k + 0.5) - h(static_cast<double>(k))) {
+            return k;
+        }
+    }
+}
+
+// ==================== WORKLOAD GENERATOR ====================
+
+namespace {
+    // Weighted pieces of English-looking syllables
+    const char* const ONSETS[] = {
+        "", "", "b", "c", "d", "f", "g", "h", "k", "l", "m", "n", "p", "r", "r", "s", "s", "t", "t",
+        "v", "w", "y", "z", "bl", "br", "ch", "cl", "cr", "dr", "fl", "fr", "gr", "pl", "pr", "sh",
+        "sl", "sp", "st", "str", "th", "tr", "wh"
+    };
+    const char* const VOWELS[] = {
+        "a", "a", "e", "e", "e", "i", "i", "o", "o", "u", "y", "ai", "au", "ea", "ee", "ie", "io",
+        "oa", "oo", "ou"
+    };
+    const char* const CODAS[] = {
+        "", "", "", "", "b", "ck", "d", "ft", "g", "l", "ll", "m", "mp", "n", "nd", "ng", "nt", "p",
+        "r", "rd", "rk", "rn", "s", "ss", "st", "t", "x"
+    };
+
+    template <size_t N>
+    const char* pick(const char* const (&pieces)[N], std::mt19937_64& rng) {
+        return pieces[rng() % N];
+    }
+
+    // Keys next to each letter on a QWERTY keyboard
+    const char* const QWERTY_NEIGHBOURS[26] = {
+        "qwsz",   "vghn",  "xdfv",   "serfcx", "wsdr",  "drtgvc", "ftyhbv", "gyujnb", "ujko",
+        "huikmn", "jiolm", "kop",    "njk",    "bhjm",  "iklp",   "ol",     "wa",     "edft",
+        "awedxz", "rfgy",  "yhji",   "cfgb",   "qase",  "zsdc",   "tghu",   "asx"
+    };
+
+    char neighbourKey(char ch, std::mt19937_64& rng) {
+        if (ch < 'a' || ch > 'z') {
+            return static_cast<char>('a' + rng() % 26);
+        }
+        const char* keys = QWERTY_NEIGHBOURS[ch - 'a'];
+        return keys[rng() % std::char_traits<char>::length(keys)];
+    }
+}
+
+WorkloadGenerator::DictionaryConfig::DictionaryConfig()
+    : words(100000), zipfExponent(1.0), maxFrequency(1000000),
+      lengthMean(7.5), lengthStddev(2.5), minLength(2), maxLength(20), seed(42) {}
+
+WorkloadGenerator::QueryConfig::QueryConfig()
+    : queries(100000), zipfExponent(1.0), prefixShare(50), keystrokeShare(30), typoShare(20),
+      secondErrorRate(0.1), seed(7) {}
+
+size_t WorkloadGenerator::generateDictionary(const DictionaryConfig& config,
+                                             const std::function<void(const std::string&, int)>& onWord) {
+    std::mt19937_64 rng(config.seed);
+    int minLength = std::max(1, config.minLength);
+    int maxLength = std::max(minLength, config.maxLength);
+    std::normal_distribution<double> lengthDistribution(config.lengthMean, config.lengthStddev);
+
+    // A Bloom Filter keeps the words distinct in O(1) memory per word: a
+    // false positive only throws away a word that was in fact new
+    long long bits = std::min<long long>(static_cast<long long>(config.words) * 12 + 1024, 2000000000LL);
+    BloomFilter seen(static_cast<int>(bits), 4);
+
+    size_t produced = 0;
+    size_t attempts = 0;
+    std::string word;
+    // Short lengths run out of distinct words; give up after enough misses
+    while (produced < config.words && attempts < config.words * 20 + 1000) {
+        attempts++;
+
+        int length = static_cast<int>(std::lround(lengthDistribution(rng)));
+        length = std::min(maxLength, std::max(minLength, length));
+
+        word.clear();
+        while (static_cast<int>(word.size()) < length) {
+            word += pick(ONSETS, rng);
+            word += pick(VOWELS, rng);
+            word += pick(CODAS, rng);
+        }
+        word.resize(length);
+
+        if (seen.containsWord(word)) {
+            continue;
+        }
+        seen.addWord(word);
+
+        produced++;
+        double frequency = config.maxFrequency / std::pow(static_cast<double>(produced), config.zipfExponent);
+        onWord(word, std::max(1, static_cast<int>(std::lround(frequency))));
+    }
+
+    return produced;
+}
+
+WorkloadGenerator::WorkloadGenerator(const std::vector<std::pair<std::string, int>>& dictionary,
+                                     const QueryConfig& cfg)
+    : config(cfg) {
+    // Whole dictionary by descending frequency, ties in dictionary order:
+    // integer keys and a stable order, so radix sort instead of comparisons
+    std::vector<std::pair<std::string, int>> ranked(dictionary);
+    SortAlgorithms::radixSortByFrequency(ranked);
+
+    wordsByRank.reserve(ranked.size());
+    for (auto& entry : ranked) {
+        wordsByRank.push_back(std::move(entry.first));
+    }
+}
+
+std::string WorkloadGenerator::misspell(const std::string& word, std::mt19937_64& rng) {
+    if (word.size() < 2) {
+        return word;
+    }
+
+    // Roughly the single-error mix of typed text
+    std::discrete_distribution<int> errorKind({35, 25, 25, 15});
+
+    for (int attempt = 0; attempt < 4; attempt++) {
+        std::string typo = word;
+        size_t pos = rng() % word.size();
+
+        switch (errorKind(rng)) {
+            case 0:     // Substitute a neighbouring key
+                typo[pos] = neighbourKey(word[pos], rng);
+                break;
+            case 1:     // Drop a letter
+                typo.erase(pos, 1);
+                break;
+            case 2:     // Hit a neighbouring key too, or double the letter
+                typo.insert(pos + 1, 1, rng() % 2 ? neighbourKey(word[pos], rng) : word[pos]);
+                break;
+            default:    // Transpose with the next letter
+                if (pos + 1 == word.size()) pos--;
+                std::swap(typo[pos], typo[pos + 1]);
+                break;
+        }
+
+        if (typo != word) {
+            return typo;
+        }
+    }
+
+    // Transposing equal letters changes nothing; substitution always does
+    std::string typo = word;
+    typo[0] = neighbourKey(word[0], rng);
+    return typo;
+}
+
+const char* WorkloadGenerator::typeName(QueryType type) {
+    switch (type) {
+        case QueryType::Prefix: return "prefix";
+        case QueryType::Keystroke: return "keystroke";
+        default: return "typo";
+    }
+}
+
+size_t WorkloadGenerator::generateQueries(const std::function<void(const Query&)>& onQuery) const {
+    if (wordsByRank.empty()) {
+        return 0;
+    }
+
+    std::mt19937_64 rng(config.seed);
+    ZipfDistribution popularity(wordsByRank.size(), config.zipfExponent);
+    std::discrete_distribution<int> typeDistribution({
+        std::max(0.0, config.prefixShare),
+        std::max(0.0, config.keystrokeShare),
+        std::max(0.0, config.typoShare)});
+    std::bernoulli_distribution secondError(std::min(1.0, std::max(0.0, config.secondErrorRate)));
+
+    size_t produced = 0;
+    Query query;
+    while (produced < config.queries) {
+        query.intended = wordsByRank[popularity.sample(rng) - 1];
+        size_t length = query.intended.size();
+        query.type = static_cast<QueryType>(typeDistribution(rng));
+
+        if (query.type == QueryType::Prefix) {
+            query.text = query.intended.substr(0, 1 + rng() % length);
+            onQuery(query);
+            produced++;
+        } else if (query.type == QueryType::Keystroke) {
+            // The user stops typing somewhere after the second key
+            size_t typed = std::min(length, 2 + rng() % length);
+            for (size_t i = 1; i <= typed && produced < config.queries; i++) {
+                query.text = query.intended.substr(0, i);
+                onQuery(query);
+                produced++;
+            }
+        } else {
+            query.text = misspell(query.intended, rng);
+            if (secondError(rng)) {
+                query.text = misspell(query.text, rng);
+            }
+            onQuery(query);
+            produced++;
+        }
+    }
+
+    return produced;
+}
@@ -0,0 +1,151 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include "../include/batchprocessor.h"
+#include "../include/spellchecker.h"
+#include "../include/utils.h"
+
+// Test counter
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define ASSERT_TEST(condition, message) \
+    if (condition) { \
+        tests_passed++; \
+        std::cout << "✓ " << message << std::endl; \
+    } else { \
+        tests_failed++; \
+        std::cout << "✗ " << message << " FAILED!" << std::endl; \
+    }
+
+const char* DICTIONARY_FILE = "build/test_batchprocessor_dictionary.tmp";
+
+bool contains(const std::string& text, const std::string& part) {
+    return text.find(part) != std::string::npos;
+}
+
+// Output lines with the timing field cut off, for comparing runs
+std::vector<std::string> untimedLines(const std::string& output) {
+    std::vector<std::string> lines = Utils::split(output, '\n');
+    for (std::string& line : lines) {
+        line = line.substr(0, line.find("\"timeTaken\""));
+    }
+    return lines;
+}
+
+// ==================== TEST FUNCTIONS ====================
+
+void testModes(SpellChecker& checker) {
+    std::cout << "\nTesting Batch Modes..." << std::endl;
+
+    BatchProcessor processor(&checker, 1);
+    ASSERT_TEST(processor.getThreadCount() == 1, "One thread answers on the caller");
+
+    std::istringstream prefixes("prog\n\n  app \r\nzzz\n");
+    std::ostringstream autocompleted;
+    BatchProcessor::Stats stats = processor.processStream(prefixes, autocompleted, BatchProcessor::AUTOCOMPLETE);
+
+    std::vector<std::string> lines = Utils::split(autocompleted.str(), '\n');
+    ASSERT_TEST(stats.queries == 3 && lines.size() == 3, "Blank lines skipped, one JSON line per query");
+    ASSERT_TEST(contains(lines[0], "\"query\": \"prog\"") &&
+                contains(lines[0], "\"suggestions\": [\"program\", \"progress\"]"), "Autocomplete ranked by frequency");
+    ASSERT_TEST(contains(lines[1], "\"query\": \"app\"") && contains(lines[1], "\"count\": 2"),
+                "Queries trimmed (including CR)");
+    ASSERT_TEST(contains(lines[2], "\"suggestions\": []") && contains(lines[2], "\"timeTaken\": "),
+                "Unknown prefix answered with its own timing");
+
+    std::istringstream words("apple\nprogrem\n");
+    std::ostringstream checked;
+    processor.processStream(words, checked, BatchProcessor::SPELLCHECK);
+    lines = Utils::split(checked.str(), '\n');
+    ASSERT_TEST(lines.size() == 2 && contains(lines[0], "\"isCorrect\": true") &&
+                contains(lines[1], "\"corrections\": [\"program\", \"progress\"]"), "Spell check with corrections");
+
+    int hits, misses;
+    double hitRate;
+    checker.getCacheStats(hits, misses, hitRate);
+    ASSERT_TEST(hits == 0 && misses == 0, "Batch lookups leave the LRU cache alone");
+}
+
+void testThreads(SpellChecker& checker) {
+    std::cout << "\nTesting Worker Threads..." << std::endl;
+
+    std::string input;
+    const char* queries[] = {"prog", "app", "progrem", "apple", "zz", "pro"};
+    for (int i = 0; i < 5000; i++) {
+        input += queries[i % 6];
+        input += '\n';
+    }
+
+    std::istringstream serialInput(input);
+    std::ostringstream serialOutput;
+    BatchProcessor serial(&checker, 1);
+    serial.processStream(serialInput, serialOutput, BatchProcessor::SPELLCHECK);
+
+    // Small blocks so the run crosses several block boundaries
+    std::istringstream parallelInput(input);
+    std::ostringstream parallelOutput;
+    BatchProcessor parallel(&checker, 4, 10, 512);
+    BatchProcessor::Stats stats = parallel.processStream(parallelInput, parallelOutput, BatchProcessor::SPELLCHECK);
+
+    ASSERT_TEST(parallel.getThreadCount() == 4 && stats.threads == 4, "Configured thread count used");
+    ASSERT_TEST(stats.queries == 5000, "Every query answered");
+    ASSERT_TEST(untimedLines(serialOutput.str()) == untimedLines(parallelOutput.str()),
+                "Same answers in the same order as one thread");
+    ASSERT_TEST(stats.queriesPerSecond() > 0.0, "Throughput reported");
+}
+
+void testFiles(SpellChecker& checker) {
+    std::cout << "\nTesting Files and Modes..." << std::endl;
+
+    BatchProcessor processor(&checker, 2);
+    std::ostringstream output;
+    BatchProcessor::Stats stats = processor.processFile("build/missing_queries.txt", output,
+                                                        BatchProcessor::AUTOCOMPLETE);
+    ASSERT_TEST(stats.queries == 0 && output.str().empty(), "Missing query file reported, nothing written");
+
+    BatchProcessor::Mode mode = BatchProcessor::AUTOCOMPLETE;
+    ASSERT_TEST(BatchProcessor::parseMode("spellcheck", mode) && mode == BatchProcessor::SPELLCHECK,
+                "Mode parsed by name");
+    ASSERT_TEST(!BatchProcessor::parseMode("select", mode) && mode == BatchProcessor::SPELLCHECK,
+                "Unknown mode rejected");
+}
+
+// ==================== MAIN TEST RUNNER ====================
+
+int main() {
+    std::cout << "=====================================" << std::endl;
+    std::cout << "   BATCH PROCESSOR TESTS" << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+    {
+        std::ofstream dictionary(DICTIONARY_FILE);
+        dictionary << "program 200\nprogress 100\napple 50\napplication 40\n";
+    }
+    Utils::setLogToStderr(true);
+    SpellChecker checker;
+    checker.loadDictionary(DICTIONARY_FILE);
+
+    testModes(checker);
+    testThreads(checker);
+    testFiles(checker);
+
+    std::remove(DICTIONARY_FILE);
+
+    std::cout << "\n=====================================" << std::endl;
+    std::cout << "TEST RESULTS:" << std::endl;
+    std::cout << "  Passed: " << tests_passed << std::endl;
+    std::cout << "  Failed: " << tests_failed << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+    if (tests_failed == 0) {
+        std::cout << "\n✓ ALL BATCH PROCESSOR TESTS PASSED!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n✗ SOME TESTS FAILED!" << std::endl;
+        return 1;
+    }
+}
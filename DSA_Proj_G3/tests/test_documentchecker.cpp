@@ -0,0 +1,185 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include "../include/documentchecker.h"
+#include "../include/spellchecker.h"
+#include "../include/utils.h"
+
+// Test counter
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define ASSERT_TEST(condition, message) \
+    if (condition) { \
+        tests_passed++; \
+        std::cout << "✓ " << message << std::endl; \
+    } else { \
+        tests_failed++; \
+        std::cout << "✗ " << message << " FAILED!" << std::endl; \
+    }
+
+const char* DICTIONARY_FILE = "build/test_documentchecker_dictionary.tmp";
+
+// Misspellings reported for a text, in order
+std::vector<DocumentChecker::Misspelling> check(DocumentChecker& checker, const std::string& text,
+                                                DocumentChecker::Stats* stats = nullptr) {
+    std::vector<DocumentChecker::Misspelling> found;
+    DocumentChecker::Stats result = checker.checkText(text, [&found](const DocumentChecker::Misspelling& m) {
+        found.push_back(m);
+    });
+    if (stats != nullptr) *stats = result;
+    return found;
+}
+
+// "word@offset" for each misspelling
+std::string summary(const std::vector<DocumentChecker::Misspelling>& found) {
+    std::string out;
+    for (const DocumentChecker::Misspelling& m : found) {
+        out += m.word + "@" + std::to_string(m.offset) + " ";
+    }
+    return out;
+}
+
+// ==================== TEST FUNCTIONS ====================
+
+void testChunkBoundaries(SpellChecker& spellChecker) {
+    std::cout << "\nTesting Chunk Boundaries..." << std::endl;
+
+    std::string text = "The Qiuck brown fox jumpd over the lazy dgo";
+    std::string expected = "Qiuck@4 jumpd@20 dgo@40 ";
+
+    DocumentChecker whole(&spellChecker);
+    ASSERT_TEST(summary(check(whole, text)) == expected, "Offsets of misspellings in one chunk");
+
+    // Every chunk size from 1 byte up splits some token across chunks
+    bool allMatch = true;
+    for (size_t chunkSize = 1; chunkSize <= 16; chunkSize++) {
+        DocumentChecker chunked(&spellChecker, chunkSize);
+        allMatch = allMatch && summary(check(chunked, text)) == expected;
+    }
+    ASSERT_TEST(allMatch, "Tokens spanning chunk boundaries keep their offsets");
+}
+
+void testLongRuns(SpellChecker& spellChecker) {
+    std::cout << "\nTesting Over-long Runs..." << std::endl;
+
+    std::string run(200, 'q');
+    std::string text = "the " + run + " dgo fox";
+    std::string expected = "dgo@" + std::to_string(4 + run.size() + 1) + " ";
+
+    DocumentChecker whole(&spellChecker);
+    ASSERT_TEST(summary(check(whole, text)) == expected, "Runs over 64 letters are skipped");
+
+    DocumentChecker chunked(&spellChecker, 16);
+    ASSERT_TEST(summary(check(chunked, text)) == expected, "Skipped run spanning several chunks");
+
+    std::string identifiers = "user_id teh0 0xdgo dgo";
+    ASSERT_TEST(summary(check(whole, identifiers)) == "dgo@19 ", "Runs glued to digits or '_' are skipped");
+}
+
+void testDedupWindow(SpellChecker& spellChecker) {
+    std::cout << "\nTesting Dedup Window..." << std::endl;
+
+    DocumentChecker::Stats stats;
+    DocumentChecker checker(&spellChecker);
+    std::vector<DocumentChecker::Misspelling> found = check(checker, "teh dog teh fox Teh teh", &stats);
+    ASSERT_TEST(summary(found) == "teh@0 teh@8 Teh@16 teh@20 ", "Every occurrence reported");
+    ASSERT_TEST(stats.tokensChecked == 6 && stats.uniqueLookups == 3, "Repeated tokens looked up once");
+    ASSERT_TEST(found[3].corrections == found[0].corrections && !found[0].corrections.empty(),
+                "Repeats share the first lookup's corrections");
+
+    // Window of 2, one token per batch: "ab" is the oldest when "ef"
+    // arrives, so it alone is forgotten; "cd" and "ef" are still known
+    DocumentChecker small(&spellChecker, 64 * 1024, 2, 1);
+    check(small, "ab cd ab ef cd ef", &stats);
+    ASSERT_TEST(stats.uniqueLookups == 3, "Window slides: only the oldest token is forgotten");
+
+    check(small, "ab cd ef ab", &stats);
+    ASSERT_TEST(stats.uniqueLookups == 4 && stats.tokensChecked == 4, "Forgotten token looked up again");
+}
+
+void testFinalBatch(SpellChecker& spellChecker) {
+    std::cout << "\nTesting Final Batch..." << std::endl;
+
+    // Far fewer tokens than a batch, the last one right at the end of input
+    DocumentChecker checker(&spellChecker, 64 * 1024, 8192, 256);
+    DocumentChecker::Stats stats;
+    std::vector<DocumentChecker::Misspelling> found = check(checker, "teh fox jumpd\nover dgo", &stats);
+    ASSERT_TEST(summary(found) == "teh@0 jumpd@8 dgo@19 ", "Partial batch flushed at end of input");
+    ASSERT_TEST(stats.misspellings == 3 && stats.bytesProcessed == 22, "Stats cover the whole input");
+
+    DocumentChecker empty(&spellChecker);
+    ASSERT_TEST(check(empty, "", &stats).empty() && stats.tokensChecked == 0, "Empty document");
+}
+
+void testOutputFormat(SpellChecker& spellChecker) {
+    std::cout << "\nTesting NDJSON Output..." << std::endl;
+
+    DocumentChecker checker(&spellChecker);
+    std::vector<DocumentChecker::Misspelling> found = check(checker, "a Qiuck fox");
+    std::string line = found.empty() ? "" : DocumentChecker::misspellingToJSON(found[0]);
+    ASSERT_TEST(line == "{\"offset\": 2, \"word\": \"Qiuck\", \"corrections\": [\"quick\"]}",
+                "One object per misspelling, original spelling kept");
+    ASSERT_TEST(line.find('\n') == std::string::npos, "Misspelling fits on one line");
+
+    DocumentChecker::Misspelling quoted;
+    quoted.offset = 7;
+    quoted.word = "a\"b";
+    ASSERT_TEST(DocumentChecker::misspellingToJSON(quoted) == "{\"offset\": 7, \"word\": \"a\\\"b\", \"corrections\": []}",
+                "Words escaped; no corrections is an empty array");
+
+    DocumentChecker::Stats stats;
+    stats.bytesProcessed = 100;
+    stats.tokensChecked = 20;
+    stats.uniqueLookups = 10;
+    stats.misspellings = 2;
+    std::string summaryLine = DocumentChecker::statsToJSON(stats);
+    ASSERT_TEST(summaryLine.find("\"bytes\": 100") != std::string::npos &&
+                summaryLine.find("\"tokens\": 20") != std::string::npos &&
+                summaryLine.find("\"uniqueLookups\": 10") != std::string::npos &&
+                summaryLine.find("\"misspellings\": 2") != std::string::npos &&
+                summaryLine.find("\"throughputMBps\": 0.00") != std::string::npos &&
+                summaryLine.find('\n') == std::string::npos,
+                "Summary line fields");
+}
+
+// ==================== MAIN TEST RUNNER ====================
+
+int main() {
+    std::cout << "=====================================" << std::endl;
+    std::cout << "   DOCUMENT CHECKER TESTS" << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+    {
+        std::ofstream dictionary(DICTIONARY_FILE);
+        dictionary << "the 500\nquick 100\nbrown 90\nfox 80\njumped 70\nover 60\nlazy 50\ndog 40\n"
+                      "user 30\nid 20\nab 10\ncd 10\nef 10\n";
+    }
+    Utils::setLogToStderr(true);
+    SpellChecker spellChecker;
+    spellChecker.loadDictionary(DICTIONARY_FILE);
+
+    testChunkBoundaries(spellChecker);
+    testLongRuns(spellChecker);
+    testDedupWindow(spellChecker);
+    testFinalBatch(spellChecker);
+    testOutputFormat(spellChecker);
+
+    std::remove(DICTIONARY_FILE);
+
+    std::cout << "\n=====================================" << std::endl;
+    std::cout << "TEST RESULTS:" << std::endl;
+    std::cout << "  Passed: " << tests_passed << std::endl;
+    std::cout << "  Failed: " << tests_failed << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+    if (tests_failed == 0) {
+        std::cout << "\n✓ ALL DOCUMENT CHECKER TESTS PASSED!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n✗ SOME TESTS FAILED!" << std::endl;
+        return 1;
+    }
+}
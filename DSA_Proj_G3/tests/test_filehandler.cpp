@@ -0,0 +1,227 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include "../include/filehandler.h"
+#include "../include/threadpool.h"
+#include "../include/spellchecker.h"
+
+// Test counter
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define ASSERT_TEST(condition, message) \
+    if (condition) { \
+        tests_passed++; \
+        std::cout << "✓ " << message << std::endl; \
+    } else { \
+        tests_failed++; \
+        std::cout << "✗ " << message << " FAILED!" << std::endl; \
+    }
+
+const char* TEMP_FILE = "build/test_filehandler.tmp";
+
+void writeTempFile(const std::string& content) {
+    std::ofstream file(TEMP_FILE, std::ios::binary);
+    file << content;
+}
+
+// ==================== TEST FUNCTIONS ====================
+
+void testScanDictionary() {
+    std::cout << "\nTesting In-Place Dictionary Scan..." << std::endl;
+
+    std::string text =
+        "algorithm 500\n"
+        "by the way 120\r\n"     // Phrase, Windows line ending
+        "\n"
+        "plain\n"                 // No frequency: defaults to 1
+        "negative -3\n"
+        "hello world\n"           // Malformed: frequency is not a number
+        "overflow 99999999999\n"  // Malformed: does not fit an int
+        " 42\n"                   // Malformed: no word
+        "trailing 7 \n"           // Malformed: empty frequency field
+        "last 9";                 // No final newline
+
+    std::vector<std::pair<std::string, int>> entries;
+    int skipped = FileHandler::scanDictionary(text.data(), text.size(),
+        [&entries](std::string_view word, int frequency) {
+            entries.push_back({std::string(word), frequency});
+        });
+
+    ASSERT_TEST(entries.size() == 5, "Valid entries are returned");
+    ASSERT_TEST(skipped == 4, "Malformed lines are counted and skipped");
+    ASSERT_TEST(entries[0].first == "algorithm" && entries[0].second == 500, "word frequency");
+    ASSERT_TEST(entries[1].first == "by the way" && entries[1].second == 120, "Phrase with CRLF");
+    ASSERT_TEST(entries[2].first == "plain" && entries[2].second == 1, "Default frequency");
+    ASSERT_TEST(entries[3].second == -3, "Negative frequency");
+    ASSERT_TEST(entries[4].first == "last" && entries[4].second == 9, "Last line without newline");
+}
+
+void testReadDictionary() {
+    std::cout << "\nTesting Mapped File Readers..." << std::endl;
+
+    writeTempFile("zebra 10\nbad line\napple 20\n");
+    auto words = FileHandler::readDictionary(TEMP_FILE);
+    ASSERT_TEST(words.size() == 2 && words[0].first == "zebra" && words[1].second == 20,
+                "readDictionary skips malformed lines instead of throwing");
+
+    writeTempFile("one\r\n\r\ntwo words\nthree");
+    auto list = FileHandler::readWordList(TEMP_FILE);
+    ASSERT_TEST(list.size() == 3 && list[0] == "one" && list[1] == "two words" && list[2] == "three",
+                "readWordList strips line endings and empty lines");
+
+    writeTempFile("");
+    MappedFile empty;
+    ASSERT_TEST(empty.open(TEMP_FILE) && empty.size() == 0, "Empty file maps to zero bytes");
+    ASSERT_TEST(FileHandler::readDictionary(TEMP_FILE).empty(), "Empty dictionary");
+
+    MappedFile missing;
+    ASSERT_TEST(!missing.open("build/does_not_exist.txt"), "Missing file fails to open");
+    ASSERT_TEST(FileHandler::readDictionary("build/does_not_exist.txt").empty(), "Missing dictionary");
+}
+
+void testParallelScan() {
+    std::cout << "\nTesting Parallel Dictionary Scan..." << std::endl;
+
+    std::string content;
+    for (int i = 0; i < 50000; i++) {
+        content += "word" + std::to_string(i);
+        content += (i % 1000 == 0) ? " x\n" : " " + std::to_string(i) + "\n";
+    }
+    writeTempFile(content);
+
+    MappedFile file;
+    ASSERT_TEST(file.open(TEMP_FILE) && file.size() == content.size(), "File mapped");
+
+    std::vector<std::pair<std::string_view, int>> sequential;
+    int sequentialSkipped = FileHandler::scanDictionary(file.data(), file.size(),
+        [&sequential](std::string_view word, int frequency) {
+            sequential.push_back({word, frequency});
+        });
+
+    ThreadPool pool(3);
+    int skipped = 0;
+    auto parallel = FileHandler::scanDictionaryParallel(file, pool, skipped);
+
+    ASSERT_TEST(parallel == sequential, "Parallel scan matches sequential scan, in file order");
+    ASSERT_TEST(skipped == sequentialSkipped && skipped == 50, "Parallel scan counts malformed lines");
+}
+
+void testScanDelta() {
+    std::cout << "\nTesting Delta Scan..." << std::endl;
+
+    std::string text =
+        "# editorial update\n"
+        "add kubernetes 300\n"
+        "add plain\r\n"           // Default frequency, CRLF
+        "add by the way 40\n"      // Phrase
+        "remove colour\n"
+        "remove by the way\n"
+        "set algorithm 900\n"
+        "set algorithm\n"          // Malformed: frequency required
+        "rename a b\n"             // Malformed: unknown operation
+        "add hello world\n"        // Malformed: as in the dictionary, not a frequency
+        "remove\n";                // Malformed: no word
+
+    std::vector<std::string> changes;
+    int skipped = FileHandler::scanDelta(text.data(), text.size(),
+        [&changes](FileHandler::DeltaOp op, std::string_view word, int frequency) {
+            const char* name = op == FileHandler::DeltaOp::Add ? "add" :
+                               op == FileHandler::DeltaOp::Remove ? "remove" : "set";
+            changes.push_back(std::string(name) + ":" + std::string(word) + ":" + std::to_string(frequency));
+        });
+
+    ASSERT_TEST(skipped == 4, "Malformed delta lines are counted and skipped");
+    ASSERT_TEST(changes.size() == 6, "Valid changes are returned");
+    if (changes.size() != 6) return;
+    ASSERT_TEST(changes[0] == "add:kubernetes:300" && changes[1] == "add:plain:1",
+                "add with and without frequency");
+    ASSERT_TEST(changes[2] == "add:by the way:40" && changes[4] == "remove:by the way:0",
+                "add and remove of a phrase");
+    ASSERT_TEST(changes[5] == "set:algorithm:900", "set frequency");
+}
+
+void testApplyDelta() {
+    std::cout << "\nTesting Delta Application..." << std::endl;
+
+    writeTempFile("color 50\ncolour 20\ncolumn 40\nzebra 5\n");
+    SpellChecker checker;
+    checker.loadDictionary(TEMP_FILE);
+
+    // Warm the cache: one entry the delta touches per kind, one it does not
+    checker.autocomplete("col");
+    checker.getCorrections("colr");
+    checker.autocomplete("zeb");
+    checker.getCorrections("zebr");
+
+    std::string delta = "remove colour\nset column 90\nadd coleslaw 10\nadd zebra 7\nset missing 1\n";
+    SpellChecker::DeltaStats stats = checker.applyDelta(delta.data(), delta.size());
+
+    ASSERT_TEST(stats.added == 1 && stats.removed == 1 && stats.updated == 2 && stats.skipped == 1,
+                "Delta counts");
+    ASSERT_TEST(stats.invalidated == 3, "Only affected cache entries dropped");
+    ASSERT_TEST(!checker.checkSpelling("colour") && checker.checkSpelling("coleslaw"),
+                "Removed and added words");
+
+    auto suggestions = checker.autocomplete("col");
+    ASSERT_TEST(suggestions.size() == 3 && suggestions[0] == "column", "Autocomplete sees new frequencies");
+
+    auto limited = checker.autocomplete("col", 1);
+    ASSERT_TEST(limited.size() == 1 && limited[0] == "column", "Different result limits cached separately");
+
+    std::string reweight = "set color 95\n";
+    checker.applyDelta(reweight.data(), reweight.size());
+    limited = checker.autocomplete("col", 1);
+    suggestions = checker.autocomplete("col");
+    ASSERT_TEST(limited.size() == 1 && limited[0] == "color" && suggestions.size() == 3 && suggestions[0] == "color",
+                "Re-weight drops the entry for every result limit");
+
+    auto corrections = checker.getCorrections("colr");
+    bool removedSuggested = false;
+    for (const auto& word : corrections) removedSuggested |= word == "colour";
+    ASSERT_TEST(!removedSuggested && !corrections.empty(), "Removed word no longer suggested");
+    ASSERT_TEST(checker.getDictionarySize() == 4, "Dictionary size");
+
+    // Cached corrections are kept per distance limit, and a change is
+    // checked against the limit each entry was computed with
+    std::vector<std::string> near = checker.getCorrections("zebrxyz", 2);
+    std::vector<std::string> far = checker.getCorrections("zebrxyz", 3);
+    ASSERT_TEST(near.empty() && far.size() == 1 && far[0] == "zebra", "Different distances cached separately");
+
+    std::string farDelta = "add zebqqqz 1\n";
+    checker.applyDelta(farDelta.data(), farDelta.size());
+    far = checker.getCorrections("zebrxyz", 3);
+    ASSERT_TEST(far.size() == 2, "Word three edits away invalidates a distance-3 entry");
+}
+
+// ==================== MAIN TEST RUNNER ====================
+
+int main() {
+    std::cout << "=====================================" << std::endl;
+    std::cout << "   FILE HANDLER TESTS" << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+    testScanDictionary();
+    testReadDictionary();
+    testParallelScan();
+    testScanDelta();
+    testApplyDelta();
+
+    std::remove(TEMP_FILE);
+
+    std::cout << "\n=====================================" << std::endl;
+    std::cout << "TEST RESULTS:" << std::endl;
+    std::cout << "  Passed: " << tests_passed << std::endl;
+    std::cout << "  Failed: " << tests_failed << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+    if (tests_failed == 0) {
+        std::cout << "\n✓ ALL FILE HANDLER TESTS PASSED!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n✗ SOME TESTS FAILED!" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,356 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <map>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <cmath>
+#include "../include/frequencylog.h"
+#include "../include/spellchecker.h"
+
+// Test counter
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define ASSERT_TEST(condition, message) \
+    if (condition) { \
+        tests_passed++; \
+        std::cout << "✓ " << message << std::endl; \
+    } else { \
+        tests_failed++; \
+        std::cout << "✗ " << message << " FAILED!" << std::endl; \
+    }
+
+const char* LOG_FILE = "build/test_frequency.log";
+const char* SNAPSHOT_FILE = "build/test_frequency.log.snapshot";
+
+FrequencyLog::Config testConfig() {
+    FrequencyLog::Config config;
+    config.logPath = LOG_FILE;
+    config.snapshotPath = SNAPSHOT_FILE;
+    config.flushIntervalMs = 20;
+    return config;
+}
+
+void removeFiles() {
+    std::remove(LOG_FILE);
+    std::remove(SNAPSHOT_FILE);
+}
+
+std::string readFile(const char* path) {
+    std::ifstream file(path, std::ios::binary);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+std::map<std::string, long long> learnedTotals(const FrequencyLog& log) {
+    std::map<std::string, long long> totals;
+    uint32_t now = DecayedScore::nowSeconds();
+    log.forEachLearned([&totals, now](const std::string& word, const DecayedScore& score) {
+        totals[word] = std::llround(score.valueAt(now, DecayedScore::DEFAULT_HALF_LIFE_SECONDS));
+    });
+    return totals;
+}
+
+// ==================== TEST FUNCTIONS ====================
+
+void testGroupCommitAndReplay() {
+    std::cout << "\nTesting Group Commit and Replay..." << std::endl;
+    removeFiles();
+
+    {
+        FrequencyLog log(testConfig());
+        ASSERT_TEST(log.replay() == 0, "Nothing to replay on first start");
+        ASSERT_TEST(log.start(), "Log started");
+
+        for (int i = 0; i < 100; i++) {
+            log.record("hello", 1);
+        }
+        log.record("help", 2);
+        log.record("help", -2);   // Cancels out: not written
+        log.record("world", 3);
+        ASSERT_TEST(log.flush(), "Batch flushed");
+
+        FrequencyLog::Stats stats = log.getStats();
+        ASSERT_TEST(stats.recorded == 103 && stats.flushed == 103 && stats.batches == 1,
+                    "103 records in one group commit");
+    }
+
+    std::string content = readFile(LOG_FILE);
+    ASSERT_TEST(content.rfind("#epoch 1\n#t ", 0) == 0, "Log starts with its epoch, then the batch time");
+    ASSERT_TEST(content.find("hello 100\n") != std::string::npos && content.find("help") == std::string::npos,
+                "Batch written as one summed line per word");
+
+    FrequencyLog restarted(testConfig());
+    restarted.replay();
+    auto totals = learnedTotals(restarted);
+    ASSERT_TEST(totals.size() == 2 && totals["hello"] == 100 && totals["world"] == 3,
+                "Learned totals survive a restart");
+}
+
+void testBackgroundFlush() {
+    std::cout << "\nTesting Background Flusher..." << std::endl;
+    removeFiles();
+
+    FrequencyLog log(testConfig());
+    log.start();
+    log.record("async", 5);
+
+    ASSERT_TEST(log.getStats().flushed == 0, "record() does not write");
+    for (int i = 0; i < 50 && log.getStats().flushed == 0; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_TEST(log.getStats().flushed == 1, "Flusher wrote the batch");
+    ASSERT_TEST(readFile(LOG_FILE).find("async 5\n") != std::string::npos, "Record on disk");
+}
+
+void testCompaction() {
+    std::cout << "\nTesting Compaction..." << std::endl;
+    removeFiles();
+
+    {
+        FrequencyLog::Config config = testConfig();
+        config.compactThresholdBytes = 200;
+        FrequencyLog log(config);
+        log.start();
+
+        // Past the threshold: the flusher compacts on its own
+        for (int i = 0; i < 40; i++) {
+            log.record("word" + std::to_string(i % 10), 1);
+            log.flush();
+        }
+        for (int i = 0; i < 50 && log.getStats().compactions == 0; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        ASSERT_TEST(log.getStats().compactions >= 1, "Log compacted once past the threshold");
+
+        log.record("word0", 6);
+    }
+
+    std::string snapshot = readFile(SNAPSHOT_FILE);
+    ASSERT_TEST(snapshot.rfind("#epoch ", 0) == 0 && snapshot.find("word9 4\n") != std::string::npos,
+                "Snapshot holds the learned totals");
+
+    FrequencyLog restarted(testConfig());
+    restarted.replay();
+    auto totals = learnedTotals(restarted);
+    ASSERT_TEST(totals.size() == 10 && totals["word0"] == 10 && totals["word9"] == 4,
+                "Snapshot plus newer log replayed");
+}
+
+void testCrashRecovery() {
+    std::cout << "\nTesting Crash Recovery..." << std::endl;
+    removeFiles();
+
+    // Crash after the snapshot rename, before the log was reset: the log's
+    // epoch is covered by the snapshot and must not be applied twice
+    { std::ofstream out(SNAPSHOT_FILE); out << "#epoch 3\nhello 10\n"; }
+    { std::ofstream out(LOG_FILE); out << "#epoch 3\nhello 4\n"; }
+    {
+        FrequencyLog log(testConfig());
+        log.replay();
+        ASSERT_TEST(learnedTotals(log)["hello"] == 10, "Compacted log not applied twice");
+        log.start();
+        log.record("hello", 1);
+    }
+    ASSERT_TEST(readFile(LOG_FILE).rfind("#epoch 4\n", 0) == 0, "Stale log replaced by the next epoch");
+
+    // Crash mid-write: the torn last line is ignored and cut off
+    { std::ofstream out(LOG_FILE, std::ios::app); out << "world 7\nhel"; }
+    {
+        FrequencyLog log(testConfig());
+        log.replay();
+        auto totals = learnedTotals(log);
+        ASSERT_TEST(totals["hello"] == 11 && totals["world"] == 7 && totals.count("hel") == 0,
+                    "Torn last line ignored");
+        log.start();
+        log.record("again", 1);
+    }
+    std::string content = readFile(LOG_FILE);
+    ASSERT_TEST(content.find("hel\n") == std::string::npos && content.find("world 7\n#t ") != std::string::npos &&
+                content.find("again 1\n") != std::string::npos,
+                "Torn tail cut before appending");
+}
+
+void testDecay() {
+    std::cout << "\nTesting Decayed Scores..." << std::endl;
+    removeFiles();
+
+    // Two half-lives ago: 8 uses are worth 2 now, 1 use rounds to nothing
+    uint32_t twoHalfLivesAgo = DecayedScore::nowSeconds() - 2 * DecayedScore::DEFAULT_HALF_LIFE_SECONDS;
+    {
+        std::ofstream out(SNAPSHOT_FILE);
+        out << "#epoch 1\n#t " << twoHalfLivesAgo << "\nhello 8\nfad 1\n";
+    }
+
+    FrequencyLog log(testConfig());
+    log.replay();
+    auto totals = learnedTotals(log);
+    ASSERT_TEST(totals["hello"] == 2 && totals["fad"] == 0, "Replayed scores decay by their batch time");
+
+    log.start();
+    log.compact();
+    std::string snapshot = readFile(SNAPSHOT_FILE);
+    ASSERT_TEST(snapshot.find("hello 2\n") != std::string::npos && snapshot.find("fad") == std::string::npos,
+                "Compaction forgets words whose score decayed away");
+    ASSERT_TEST(log.getStats().learnedWords == 1, "Forgotten words leave memory too");
+}
+
+void testSpellCheckerLearning() {
+    std::cout << "\nTesting Learned Ranking..." << std::endl;
+    removeFiles();
+
+    const char* dictionary = "build/test_frequency_dictionary.tmp";
+    { std::ofstream out(dictionary); out << "help 50\nhello 40\n"; }
+
+    {
+        FrequencyLog log(testConfig());
+        log.start();
+
+        SpellChecker checker;
+        checker.loadDictionary(dictionary);
+        checker.setFrequencyLog(&log);
+        for (int i = 0; i < 20; i++) {
+            checker.updateFrequency("hello");
+        }
+        ASSERT_TEST(!checker.updateFrequency("helo"), "Unknown words are not learned");
+    }
+
+    // A fresh load on top of the replayed log ranks the learned word first
+    FrequencyLog log(testConfig());
+    log.replay();
+    SpellChecker checker;
+    checker.loadDictionary(dictionary);
+    ASSERT_TEST(checker.autocomplete("hel")[0] == "help", "Dictionary order before replay");
+    ASSERT_TEST(checker.applyLearnedFrequencies(log) == 1, "Learned score applied");
+    ASSERT_TEST(checker.autocomplete("hel")[0] == "hello", "Learned ranking after restart");
+
+    std::remove(dictionary);
+}
+
+void testNormalizedLearning() {
+    std::cout << "\nTesting Normalized Log Keys..." << std::endl;
+    removeFiles();
+
+    const char* dictionary = "build/test_frequency_dictionary.tmp";
+    { std::ofstream out(dictionary); out << "help 50\nhello 40\n"; }
+
+    double liveScore = 0.0;
+    {
+        FrequencyLog log(testConfig());
+        log.start();
+
+        SpellChecker checker;
+        checker.loadDictionary(dictionary);
+        checker.setFrequencyLog(&log);
+        for (int i = 0; i < 3; i++) checker.updateFrequency("Hello");
+        for (int i = 0; i < 2; i++) checker.updateFrequency("hello");
+        checker.updateFrequency("hel\nlo");
+        checker.updateFrequency("HELLO!");
+        liveScore = checker.getTrie()->getRecentScore("hello");
+        log.flush();
+
+        std::string logText = readFile(LOG_FILE);
+        ASSERT_TEST(logText.find("hello 7\n") != std::string::npos && logText.find("Hello") == std::string::npos &&
+                    logText.find("\nlo ") == std::string::npos,
+                    "Selections logged under one normalized key");
+
+        log.record("bad word", 1);
+        log.record("bad\nword", 1);
+        log.flush();
+        ASSERT_TEST(readFile(LOG_FILE).find("bad") == std::string::npos, "Words with whitespace not logged");
+    }
+
+    FrequencyLog log(testConfig());
+    log.replay();
+    SpellChecker checker;
+    checker.loadDictionary(dictionary);
+    checker.applyLearnedFrequencies(log);
+    double restoredScore = checker.getTrie()->getRecentScore("hello");
+    ASSERT_TEST(std::llround(liveScore) == 7 && std::llround(restoredScore) == std::llround(liveScore),
+                "Learned score after restart matches the live score");
+
+    std::remove(dictionary);
+}
+
+void testSelectionReranksCache() {
+    std::cout << "\nTesting Cached Autocomplete After Selection..." << std::endl;
+
+    const char* dictionary = "build/test_frequency_dictionary.tmp";
+    { std::ofstream out(dictionary); out << "progress 5\nproject 10\nprogram 8\n"; }
+
+    SpellChecker checker;
+    checker.loadDictionary(dictionary);
+    std::vector<std::string> before = checker.autocomplete("pro");
+    ASSERT_TEST(!before.empty() && before[0] == "project", "Prefix cached with the loaded ranking");
+
+    for (int i = 0; i < 50; i++) checker.updateFrequency("progress");
+    std::vector<std::string> after = checker.autocomplete("pro");
+    ASSERT_TEST(!after.empty() && after[0] == "progress" && after == checker.autocompleteUncached("pro"),
+                "Selection re-ranks the cached prefix");
+
+    std::remove(dictionary);
+}
+
+void testMergedRestore() {
+    std::cout << "\nTesting Merged Restore..." << std::endl;
+    removeFiles();
+
+    const char* dictionary = "build/test_frequency_dictionary.tmp";
+    { std::ofstream out(dictionary); out << "help 50\nhello 40\n"; }
+
+    // Entries written before keys were normalized: all three are "hello"
+    uint32_t oneHalfLifeAgo = DecayedScore::nowSeconds() - DecayedScore::DEFAULT_HALF_LIFE_SECONDS;
+    {
+        std::ofstream out(SNAPSHOT_FILE);
+        out << "#epoch 1\n#t " << oneHalfLifeAgo << "\nHello 4\n#t " << DecayedScore::nowSeconds()
+            << "\nhello 2\nHELLO 1\n";
+    }
+
+    FrequencyLog log(testConfig());
+    log.replay();
+    SpellChecker checker;
+    checker.loadDictionary(dictionary);
+    ASSERT_TEST(checker.applyLearnedFrequencies(log) == 3, "Every entry applied");
+    ASSERT_TEST(std::llround(checker.getTrie()->getRecentScore("hello")) == 5,
+                "Entries for the same word are summed, each decayed by its own age");
+
+    std::remove(dictionary);
+}
+
+// ==================== MAIN TEST RUNNER ====================
+
+int main() {
+    std::cout << "=====================================" << std::endl;
+    std::cout << "   FREQUENCY LOG TESTS" << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+    testGroupCommitAndReplay();
+    testBackgroundFlush();
+    testCompaction();
+    testCrashRecovery();
+    testDecay();
+    testSpellCheckerLearning();
+    testNormalizedLearning();
+    testMergedRestore();
+    testSelectionReranksCache();
+
+    removeFiles();
+
+    std::cout << "\n=====================================" << std::endl;
+    std::cout << "TEST RESULTS:" << std::endl;
+    std::cout << "  Passed: " << tests_passed << std::endl;
+    std::cout << "  Failed: " << tests_failed << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+    if (tests_failed == 0) {
+        std::cout << "\n✓ ALL FREQUENCY LOG TESTS PASSED!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n✗ SOME TESTS FAILED!" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,204 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../include/jsonreader.h"
+#include "../include/jsonwriter.h"
+
+// Test counter
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define ASSERT_TEST(condition, message) \
+    if (condition) { \
+        tests_passed++; \
+        std::cout << "✓ " << message << std::endl; \
+    } else { \
+        tests_failed++; \
+        std::cout << "✗ " << message << " FAILED!" << std::endl; \
+    }
+
+// Read {"query": ..., "mode": ...} the way HTTPServer does
+bool readQuery(const std::string& body, std::string& query, std::string& mode) {
+    JSONReader json(body);
+    std::string key;
+    if (!json.beginObject()) return false;
+    while (json.nextMember(key)) {
+        if (key == "query") json.readString(query);
+        else if (key == "mode") json.readString(mode);
+        else json.skipValue();
+    }
+    return json.finish();
+}
+
+// Parse the whole input, skipping every value
+bool isValid(const std::string& text) {
+    JSONReader json(text);
+    json.skipValue();
+    return json.finish();
+}
+
+// ==================== TEST FUNCTIONS ====================
+
+void testObjects() {
+    std::cout << "\nTesting Objects..." << std::endl;
+
+    std::string query, mode;
+    bool parsed = readQuery("{\"query\":\"prog\",\"mode\":\"spellcheck\"}", query, mode);
+    ASSERT_TEST(parsed && query == "prog" && mode == "spellcheck", "Flat object");
+
+    query.clear();
+    mode.clear();
+    parsed = readQuery(" {\n\t\"mode\" :  \"autocomplete\" ,\r\n \"query\":\"ab\" }\n", query, mode);
+    ASSERT_TEST(parsed && query == "ab" && mode == "autocomplete", "Whitespace anywhere; any member order");
+
+    query.clear();
+    parsed = readQuery("{\"note\":\"\\\"query\\\": \\\"fake\\\"\",\"query\":\"real\"}", query, mode);
+    ASSERT_TEST(parsed && query == "real", "Key text inside another value is not matched");
+
+    query.clear();
+    parsed = readQuery("{\"extra\":{\"query\":\"nested\",\"list\":[1,[2,{}],null,true]},\"query\":\"top\"}",
+                       query, mode);
+    ASSERT_TEST(parsed && query == "top", "Nested objects and arrays skipped");
+
+    JSONReader empty("{}");
+    std::string key;
+    ASSERT_TEST(empty.beginObject() && !empty.nextMember(key) && empty.finish(), "Empty object");
+}
+
+void testStrings() {
+    std::cout << "\nTesting Strings..." << std::endl;
+
+    std::string out;
+    JSONReader escapes("\"say \\\"hi\\\" \\\\ \\/ \\b\\f\\n\\r\\t\"");
+    ASSERT_TEST(escapes.readString(out) && out == "say \"hi\" \\ / \b\f\n\r\t", "Short escapes decoded");
+
+    JSONReader unicode("\"caf\\u00e9 \\u20AC \\ud83d\\ude00 caf\xc3\xa9\"");
+    ASSERT_TEST(unicode.readString(out) && out == "caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80 caf\xc3\xa9",
+                "\\u escapes and surrogate pairs decoded to UTF-8");
+
+    JSONReader lone("\"\\ud83d!\"");
+    ASSERT_TEST(lone.readString(out) && out == "\xef\xbf\xbd!", "Lone surrogate becomes U+FFFD");
+
+    // Round trip through the writer
+    std::string original = "tab\there \"quoted\" back\\slash \x01 caf\xc3\xa9";
+    std::string json;
+    JSONWriter::appendString(json, original);
+    JSONReader roundTrip(json);
+    ASSERT_TEST(roundTrip.readString(out) && out == original && roundTrip.finish(), "Reads what JSONWriter writes");
+}
+
+void testValues() {
+    std::cout << "\nTesting Values..." << std::endl;
+
+    JSONReader json("[12, -0.5, 1e3, true, false, null, \"s\"]");
+    double number = 0;
+    long long integer = 0;
+    bool flag = false;
+    std::string text;
+
+    bool read = json.beginArray();
+    read = read && json.nextElement() && json.readInt(integer) && integer == 12;
+    read = read && json.nextElement() && json.readNumber(number) && number == -0.5;
+    read = read && json.nextElement() && json.readNumber(number) && number == 1000;
+    read = read && json.nextElement() && json.readBool(flag) && flag;
+    read = read && json.nextElement() && json.readBool(flag) && !flag;
+    read = read && json.nextElement() && json.readNull();
+    read = read && json.nextElement() && json.peek() == JSONReader::STRING && json.readString(text);
+    read = read && !json.nextElement() && json.finish();
+    ASSERT_TEST(read, "Numbers, booleans, null and strings in an array");
+
+    JSONReader fraction("1.5");
+    ASSERT_TEST(!fraction.readInt(integer) && !fraction.ok(), "readInt rejects a fraction");
+
+    JSONReader exponent("1e3");
+    ASSERT_TEST(!exponent.readInt(integer), "readInt rejects an exponent");
+
+    JSONReader mismatch("\"5\"");
+    ASSERT_TEST(!mismatch.readNumber(number) && !mismatch.ok(), "Reading the wrong type fails");
+
+    JSONReader raw("{\"id\": 42, \"tag\": {\"a\": [1, 2]}, \"s\": \"x\\\"y\"}");
+    std::string key;
+    std::vector<std::string> values;
+    raw.beginObject();
+    while (raw.nextMember(key)) {
+        values.push_back(std::string(raw.rawValue()));
+    }
+    ASSERT_TEST(raw.finish() && values.size() == 3 && values[0] == "42" &&
+                values[1] == "{\"a\": [1, 2]}" && values[2] == "\"x\\\"y\"",
+                "rawValue returns values as written");
+}
+
+void testMalformed() {
+    std::cout << "\nTesting Malformed Input..." << std::endl;
+
+    ASSERT_TEST(isValid("{\"a\":[1,2,{\"b\":null}],\"c\":\"d\"}"), "Well-formed document accepted");
+
+    ASSERT_TEST(!isValid(""), "Empty input");
+    ASSERT_TEST(!isValid("{\"a\":1,}"), "Trailing comma in object");
+    ASSERT_TEST(!isValid("[1,2,]"), "Trailing comma in array");
+    ASSERT_TEST(!isValid("[1 2]"), "Missing comma");
+    ASSERT_TEST(!isValid("{\"a\" 1}"), "Missing colon");
+    ASSERT_TEST(!isValid("{a:1}"), "Unquoted key");
+    ASSERT_TEST(!isValid("{\"a\":\"open}"), "Unterminated string");
+    ASSERT_TEST(!isValid("\"line\nbreak\""), "Raw control character in string");
+    ASSERT_TEST(!isValid("\"\\x41\""), "Unknown escape");
+    ASSERT_TEST(!isValid("\"\\u12g4\""), "Bad \\u escape");
+    ASSERT_TEST(!isValid("[1}"), "Mismatched brackets");
+    ASSERT_TEST(!isValid("{\"a\":1"), "Unclosed object");
+    ASSERT_TEST(!isValid("{\"a\":1} x"), "Trailing garbage");
+    ASSERT_TEST(!isValid("01") && !isValid("1.") && !isValid("-") && !isValid("1e"), "Invalid numbers");
+    ASSERT_TEST(!isValid("tru") && !isValid("nul"), "Truncated literals");
+
+    std::string query, mode;
+    ASSERT_TEST(!readQuery("{\"query\":42}", query, mode), "Non-string query rejected");
+}
+
+void testDepthAndErrors() {
+    std::cout << "\nTesting Depth Limit and Sticky Errors..." << std::endl;
+
+    std::string deepest(JSONReader::MAX_DEPTH, '[');
+    deepest += std::string(JSONReader::MAX_DEPTH, ']');
+    ASSERT_TEST(isValid(deepest), "MAX_DEPTH levels accepted");
+
+    std::string tooDeep(JSONReader::MAX_DEPTH + 1, '[');
+    tooDeep += std::string(JSONReader::MAX_DEPTH + 1, ']');
+    ASSERT_TEST(!isValid(tooDeep), "MAX_DEPTH + 1 levels rejected");
+
+    JSONReader json("[oops, 1]");
+    long long integer = 0;
+    json.beginArray();
+    json.nextElement();
+    json.skipValue();
+    size_t errorAt = json.position();
+    bool stuck = !json.nextElement() && !json.readInt(integer) && json.peek() == JSONReader::INVALID;
+    ASSERT_TEST(stuck && !json.ok() && !json.finish(), "Errors are sticky");
+    ASSERT_TEST(errorAt == 1, "Position reports where the error was found");
+}
+
+// ==================== MAIN TEST RUNNER ====================
+
+int main() {
+    std::cout << "=====================================" << std::endl;
+    std::cout << "   JSON READER TESTS" << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+    testObjects();
+    testStrings();
+    testValues();
+    testMalformed();
+    testDepthAndErrors();
+
+    std::cout << "\n=====================================" << std::endl;
+    std::cout << "TEST RESULTS:" << std::endl;
+    std::cout << "  Passed: " << tests_passed << std::endl;
+    std::cout << "  Failed: " << tests_failed << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+    if (tests_failed == 0) {
+        std::cout << "\n✓ ALL JSON READER TESTS PASSED!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n✗ SOME TESTS FAILED!" << std::endl;
+        return 1;
+    }
+}
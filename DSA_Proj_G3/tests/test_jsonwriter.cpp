@@ -0,0 +1,141 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <cmath>
+#include "../include/jsonwriter.h"
+#include "../include/filehandler.h"
+
+// Test counter
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define ASSERT_TEST(condition, message) \
+    if (condition) { \
+        tests_passed++; \
+        std::cout << "✓ " << message << std::endl; \
+    } else { \
+        tests_failed++; \
+        std::cout << "✗ " << message << " FAILED!" << std::endl; \
+    }
+
+// ==================== TEST FUNCTIONS ====================
+
+void testStructure() {
+    std::cout << "\nTesting Structure..." << std::endl;
+
+    std::string out;
+    JSONWriter json(out);
+    json.beginObject();
+    json.field("query", "prog").field("count", 2);
+    json.key("suggestions").beginArray();
+    json.beginObject().field("word", "program").field("score", 10).endObject();
+    json.beginObject().field("word", "progress").field("score", 9).endObject();
+    json.endArray();
+    json.key("empty").beginObject().endObject();
+    json.key("none").beginArray().endArray();
+    json.endObject();
+
+    ASSERT_TEST(out == "{\"query\":\"prog\",\"count\":2,\"suggestions\":[{\"word\":\"program\",\"score\":10},"
+                       "{\"word\":\"progress\",\"score\":9}],\"empty\":{},\"none\":[]}",
+                "Commas placed at every nesting level");
+
+    std::string spaced;
+    JSONWriter pretty(spaced, JSONWriter::SPACED);
+    pretty.beginObject().field("a", true).key("b").stringArray({"x", "y"}).endObject();
+    ASSERT_TEST(spaced == "{\"a\": true, \"b\": [\"x\", \"y\"]}", "Spaced separators");
+
+    std::string appended = "data: ";
+    JSONWriter tail(appended);
+    tail.beginArray().value(false).null().raw("{\"pre\":1}").endArray();
+    ASSERT_TEST(appended == "data: [false,null,{\"pre\":1}]", "Appends to existing content; raw values");
+}
+
+void testEscaping() {
+    std::cout << "\nTesting Escaping..." << std::endl;
+
+    std::string out;
+    JSONWriter::appendString(out, "say \"hi\" \\ back\n\t\x01");
+    ASSERT_TEST(out == "\"say \\\"hi\\\" \\\\ back\\n\\t\\u0001\"", "Quotes, backslashes and control characters");
+
+    out.clear();
+    JSONWriter::appendString(out, "caf\xc3\xa9");
+    ASSERT_TEST(out == "\"caf\xc3\xa9\"", "UTF-8 bytes copied as is");
+
+    out.clear();
+    JSONWriter json(out);
+    json.beginObject().field("a\"b", "").endObject();
+    ASSERT_TEST(out == "{\"a\\\"b\":\"\"}", "Keys escaped too");
+
+    ASSERT_TEST(FileHandler::escapeJSON("x\"y") == "x\\\"y", "FileHandler::escapeJSON uses the same escapes");
+}
+
+void testNumbers() {
+    std::cout << "\nTesting Numbers..." << std::endl;
+
+    std::string out;
+    JSONWriter json(out);
+    json.beginArray();
+    json.value(0).value(-42).value(std::numeric_limits<int64_t>::min()).value(std::numeric_limits<uint64_t>::max());
+    json.endArray();
+    ASSERT_TEST(out == "[0,-42,-9223372036854775808,18446744073709551615]", "Integers of every width");
+
+    out.clear();
+    JSONWriter doubles(out);
+    doubles.beginArray().value(0.014586).value(2.5).value(1e-05).value(1234567.0).endArray();
+    ASSERT_TEST(out == "[0.014586,2.5,1e-05,1.23457e+06]", "Doubles as std::ostream prints them");
+
+    out.clear();
+    JSONWriter fixed(out);
+    fixed.beginArray().fixed(67.45, 1).fixed(3.0, 3).fixed(0.125, 2).endArray();
+    ASSERT_TEST(out == "[67.5,3.000,0.12]", "Fixed decimals");
+
+    out.clear();
+    JSONWriter invalid(out);
+    invalid.beginArray().value(std::numeric_limits<double>::infinity()).fixed(std::nan(""), 2).endArray();
+    ASSERT_TEST(out == "[null,null]", "Infinity and NaN written as null");
+}
+
+void testReuse() {
+    std::cout << "\nTesting Buffer Reuse..." << std::endl;
+
+    std::string buffer;
+    const void* data = nullptr;
+    bool stable = true;
+    for (int i = 0; i < 1000; i++) {
+        buffer.clear();
+        JSONWriter json(buffer);
+        json.beginObject().field("query", "prog").field("count", i).endObject();
+        if (i == 1) data = buffer.data();
+        if (i > 1) stable = stable && buffer.data() == data;
+    }
+    ASSERT_TEST(stable, "Cleared buffer is reused without reallocating");
+}
+
+// ==================== MAIN TEST RUNNER ====================
+
+int main() {
+    std::cout << "=====================================" << std::endl;
+    std::cout << "   JSON WRITER TESTS" << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+    testStructure();
+    testEscaping();
+    testNumbers();
+    testReuse();
+
+    std::cout << "\n=====================================" << std::endl;
+    std::cout << "TEST RESULTS:" << std::endl;
+    std::cout << "  Passed: " << tests_passed << std::endl;
+    std::cout << "  Failed: " << tests_failed << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+    if (tests_failed == 0) {
+        std::cout << "\n✓ ALL JSON WRITER TESTS PASSED!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n✗ SOME TESTS FAILED!" << std::endl;
+        return 1;
+    }
+}
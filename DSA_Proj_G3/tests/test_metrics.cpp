@@ -0,0 +1,160 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include "../include/metrics.h"
+
+// Test counter
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define ASSERT_TEST(condition, message) \
+    if (condition) { \
+        tests_passed++; \
+        std::cout << "✓ " << message << std::endl; \
+    } else { \
+        tests_failed++; \
+        std::cout << "✗ " << message << " FAILED!" << std::endl; \
+    }
+
+bool contains(const std::string& text, const std::string& part) {
+    return text.find(part) != std::string::npos;
+}
+
+// ==================== TEST FUNCTIONS ====================
+
+void testCounter() {
+    std::cout << "\nTesting Sharded Counter..." << std::endl;
+
+    Metrics::Counter counter;
+    ASSERT_TEST(counter.value() == 0, "New counter is zero");
+
+    counter.add();
+    counter.add(4);
+    ASSERT_TEST(counter.value() == 5, "Adds are summed");
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&counter]() {
+            for (int i = 0; i < 100000; i++) {
+                counter.add();
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    ASSERT_TEST(counter.value() == 800005, "No adds lost across threads");
+
+    counter.reset();
+    ASSERT_TEST(counter.value() == 0, "Reset clears every shard");
+}
+
+void testBuckets() {
+    std::cout << "\nTesting Histogram Buckets..." << std::endl;
+
+    bool contiguous = true;
+    for (int i = 0; i + 1 < Metrics::Histogram::BUCKETS; i++) {
+        contiguous = contiguous &&
+            Metrics::Histogram::bucketUpperBound(i) == Metrics::Histogram::bucketLowerBound(i + 1);
+    }
+    ASSERT_TEST(contiguous, "Buckets cover the range without gaps");
+
+    bool consistent = true;
+    bool precise = true;
+    for (uint64_t value = 1; value < (uint64_t(1) << 36); value = value * 3 + 1) {
+        int index = Metrics::Histogram::bucketIndex(value);
+        uint64_t low = Metrics::Histogram::bucketLowerBound(index);
+        uint64_t high = Metrics::Histogram::bucketUpperBound(index);
+        consistent = consistent && low <= value && value < high;
+        precise = precise && (high - low) * 16 <= low + 16;
+    }
+    ASSERT_TEST(consistent, "Values land in the bucket that holds them");
+    ASSERT_TEST(precise, "Bucket width within 6.25% of its values");
+    ASSERT_TEST(Metrics::Histogram::bucketIndex(uint64_t(1) << 50) == Metrics::Histogram::BUCKETS - 1,
+                "Values past the range land in the last bucket");
+}
+
+void testQuantiles() {
+    std::cout << "\nTesting Histogram Quantiles..." << std::endl;
+
+    Metrics::Histogram histogram;
+    ASSERT_TEST(histogram.valueAtQuantile(0.5) == 0, "Empty histogram reports 0");
+
+    // 1..10000 microseconds
+    for (uint64_t us = 1; us <= 10000; us++) {
+        histogram.record(us * 1000);
+    }
+    auto within = [](uint64_t actual, double expected) {
+        return actual >= expected && actual <= expected * 1.0625 + 1;
+    };
+    ASSERT_TEST(histogram.getCount() == 10000, "Count of recorded values");
+    ASSERT_TEST(histogram.getSumNs() == 10000ULL * 10001 / 2 * 1000, "Sum of recorded values");
+    ASSERT_TEST(within(histogram.valueAtQuantile(0.5), 5000000), "p50 within 6.25%");
+    ASSERT_TEST(within(histogram.valueAtQuantile(0.99), 9900000), "p99 within 6.25%");
+    ASSERT_TEST(within(histogram.valueAtQuantile(1.0), 10000000), "Max within 6.25%");
+
+    uint64_t below = histogram.countAtOrBelow(1000000);
+    ASSERT_TEST(below <= 1000 && below >= 940, "Count at or below a limit");
+
+    histogram.reset();
+    ASSERT_TEST(histogram.getCount() == 0 && histogram.valueAtQuantile(0.9) == 0, "Reset clears the histogram");
+}
+
+void testExposition() {
+    std::cout << "\nTesting Exposition Format..." << std::endl;
+
+    Metrics::Counter& requests = Metrics::counter("test_requests_total", "path=" + Metrics::labelValue("/a"), "Test requests");
+    Metrics::Counter& same = Metrics::counter("test_requests_total", "path=" + Metrics::labelValue("/a"), "Ignored");
+    requests.add(3);
+    ASSERT_TEST(&requests == &same, "Same name and labels give the same counter");
+
+    Metrics::Gauge& memory = Metrics::gauge("test_memory_bytes", "", "Test memory");
+    memory.set(4096);
+    memory.set(1024);
+
+    Metrics::Histogram& latency = Metrics::histogram("test_latency_seconds", "", "Test latency");
+    latency.record(2000000);  // 2 ms
+
+    std::string text = Metrics::exposition();
+    ASSERT_TEST(contains(text, "# HELP test_requests_total Test requests\n"), "HELP line from the first registration");
+    ASSERT_TEST(contains(text, "# TYPE test_requests_total counter\n"), "Counter TYPE line");
+    ASSERT_TEST(contains(text, "test_requests_total{path=\"/a\"} 3\n"), "Counter sample with labels");
+    ASSERT_TEST(contains(text, "# TYPE test_memory_bytes gauge\n") &&
+                contains(text, "test_memory_bytes 1024\n"), "Gauge holds the last value set");
+    ASSERT_TEST(contains(text, "# TYPE test_latency_seconds histogram\n"), "Histogram TYPE line");
+    ASSERT_TEST(contains(text, "test_latency_seconds_bucket{le=\"0.001\"} 0\n") &&
+                contains(text, "test_latency_seconds_bucket{le=\"0.0025\"} 1\n") &&
+                contains(text, "test_latency_seconds_bucket{le=\"+Inf\"} 1\n"), "Cumulative le buckets");
+    ASSERT_TEST(contains(text, "test_latency_seconds_sum 0.002\n") &&
+                contains(text, "test_latency_seconds_count 1\n"), "Sum in seconds and count");
+    ASSERT_TEST(contains(text, "test_latency_quantile_seconds{quantile=\"0.99\"}"), "Quantile gauges");
+    ASSERT_TEST(Metrics::labelValue("a\"b\\") == "\"a\\\"b\\\\\"", "Label values escaped");
+}
+
+// ==================== MAIN TEST RUNNER ====================
+
+int main() {
+    std::cout << "=====================================" << std::endl;
+    std::cout << "   METRICS TESTS" << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+    testCounter();
+    testBuckets();
+    testQuantiles();
+    testExposition();
+
+    std::cout << "\n=====================================" << std::endl;
+    std::cout << "TEST RESULTS:" << std::endl;
+    std::cout << "  Passed: " << tests_passed << std::endl;
+    std::cout << "  Failed: " << tests_failed << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+    if (tests_failed == 0) {
+        std::cout << "\n✓ ALL METRICS TESTS PASSED!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n✗ SOME TESTS FAILED!" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,221 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <chrono>
+#include "../include/querydaemon.h"
+#include "../include/spellchecker.h"
+#include "../include/utils.h"
+
+// Test counter
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define ASSERT_TEST(condition, message) \
+    if (condition) { \
+        tests_passed++; \
+        std::cout << "✓ " << message << std::endl; \
+    } else { \
+        tests_failed++; \
+        std::cout << "✗ " << message << " FAILED!" << std::endl; \
+    }
+
+const char* DICTIONARY_FILE = "build/test_querydaemon_dictionary.tmp";
+
+bool contains(const std::string& text, const std::string& part) {
+    return text.find(part) != std::string::npos;
+}
+
+// ==================== TEST FUNCTIONS ====================
+
+void testRequests(QueryDaemon& daemon) {
+    std::cout << "\nTesting Requests..." << std::endl;
+
+    std::string first = daemon.handleRequest("{\"query\": \"prog\", \"mode\": \"autocomplete\", \"id\": \"1\"}");
+    ASSERT_TEST(first.compare(0, 11, "{\"id\": \"1\",") == 0, "Id echoed first");
+    ASSERT_TEST(contains(first, "\"suggestions\": [\"program\", \"progress\"]") &&
+                contains(first, "\"cacheHit\": false"), "Autocomplete ranked by frequency");
+
+    std::string again = daemon.handleRequest("{\"query\":\"prog\"}");
+    ASSERT_TEST(contains(again, "\"type\": \"autocomplete\"") && contains(again, "\"cacheHit\": true"),
+                "Autocomplete is the default mode; repeat served from the cache");
+
+    std::string wrong = daemon.handleRequest("{\"mode\": \"spellcheck\", \"query\": \"progrem\"}");
+    ASSERT_TEST(contains(wrong, "\"isCorrect\": false") && contains(wrong, "\"corrections\": [\"program\", \"progress\"]"),
+                "Spell check with corrections");
+
+    std::string right = daemon.handleRequest("{ \"query\" : \"apple\" , \"mode\" : \"spellcheck\" }");
+    ASSERT_TEST(contains(right, "\"isCorrect\": true"), "Whitespace around tokens accepted");
+
+    std::string escaped = daemon.handleRequest("{\"query\": \"say \\\"hi\\\"\", \"mode\": \"spellcheck\", \"id\": 7}");
+    ASSERT_TEST(contains(escaped, "\"query\": \"say \\\"hi\\\"\"") && contains(escaped, "\"id\": \"7\""),
+                "Escaped quotes decoded and re-escaped; numeric id echoed");
+
+    std::string selected = daemon.handleRequest("{\"query\": \"progress\", \"mode\": \"select\"}");
+    ASSERT_TEST(contains(selected, "\"learned\": true"), "Select records a use");
+}
+
+void testErrors(QueryDaemon& daemon) {
+    std::cout << "\nTesting Errors..." << std::endl;
+
+    ASSERT_TEST(daemon.handleRequest("prog") == "{\"error\": \"Malformed JSON request\"}", "Not JSON");
+    ASSERT_TEST(contains(daemon.handleRequest("{\"query\": \"prog\""), "Malformed"), "Unterminated object");
+    ASSERT_TEST(contains(daemon.handleRequest("{\"mode\": \"autocomplete\"}"), "Missing query"), "Missing query");
+    ASSERT_TEST(contains(daemon.handleRequest("{\"query\": \"a\", \"mode\": \"x\", \"id\": \"9\"}"), "\"id\": \"9\", \"error\""),
+                "Invalid mode reported with its id");
+}
+
+void testStream(QueryDaemon& daemon) {
+    std::cout << "\nTesting Stream Transport..." << std::endl;
+
+    std::istringstream in("{\"query\": \"app\", \"id\": \"a\"}\n\n{\"query\": \"ap\", \"id\": \"b\"}\nbad\n");
+    std::ostringstream out;
+    size_t answered = daemon.serveStream(in, out);
+
+    std::vector<std::string> lines = Utils::split(out.str(), '\n');
+    ASSERT_TEST(answered == 3, "Blank lines skipped, every other line answered");
+    ASSERT_TEST(lines.size() == 3 && contains(lines[0], "\"id\": \"a\"") && contains(lines[1], "\"id\": \"b\"") &&
+                contains(lines[2], "error"), "One response line per request, in order");
+}
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+
+const char* SOCKET_FILE = "build/test_querydaemon.sock";
+
+void testSocketPath(QueryDaemon& daemon) {
+    std::cout << "\nTesting Socket Path..." << std::endl;
+
+    { std::ofstream file(SOCKET_FILE); file << "not a socket\n"; }
+    bool served = daemon.serveSocket(SOCKET_FILE);
+    std::ifstream kept(SOCKET_FILE);
+    std::string content;
+    std::getline(kept, content);
+    ASSERT_TEST(!served && content == "not a socket", "Regular file at the socket path is left alone");
+    std::remove(SOCKET_FILE);
+}
+
+// Connect to the daemon, waiting for it to start listening
+int connectClient() {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, SOCKET_FILE, sizeof(address.sun_path) - 1);
+
+    for (int attempt = 0; attempt < 100; attempt++) {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0) return fd;
+        close(fd);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    return -1;
+}
+
+// Read until a newline, the peer closes, or the timeout passes
+std::string readLine(int fd, int timeoutMs) {
+    std::string line;
+    char ch;
+    pollfd waiting{fd, POLLIN, 0};
+    while (poll(&waiting, 1, timeoutMs) > 0 && recv(fd, &ch, 1, 0) == 1 && ch != '\n') {
+        line += ch;
+    }
+    return line;
+}
+
+void testSocketClients(QueryDaemon& daemon) {
+    std::cout << "\nTesting Socket Clients..." << std::endl;
+
+    std::remove(SOCKET_FILE);
+    std::thread server([&daemon]() { daemon.serveSocket(SOCKET_FILE); });
+
+    // A client that sends requests but never reads its answers
+    int stalled = connectClient();
+    std::string request = "{\"query\": \"app\"}\n";
+    size_t queued = 0;
+    for (int i = 0; i < 100000; i++) {
+        ssize_t n = send(stalled, request.data(), request.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (n <= 0) break;
+        queued += n;
+    }
+
+    int active = connectClient();
+    std::string ask = "{\"query\": \"prog\", \"id\": \"live\"}\n";
+    send(active, ask.data(), ask.size(), MSG_NOSIGNAL);
+    std::string answer = readLine(active, 5000);
+    ASSERT_TEST(queued > 0 && contains(answer, "\"id\": \"live\"") && contains(answer, "program"),
+                "A client that stops reading does not stall the others");
+
+    // A line that never ends
+    int flooding = connectClient();
+    std::string chunk(64 * 1024, 'x');
+    for (int i = 0; i < 32; i++) {
+        if (send(flooding, chunk.data(), chunk.size(), MSG_NOSIGNAL) <= 0) break;
+    }
+    char byte;
+    pollfd waiting{flooding, POLLIN, 0};
+    bool dropped = poll(&waiting, 1, 5000) > 0 && recv(flooding, &byte, 1, 0) <= 0;
+    ASSERT_TEST(dropped, "Client with an over-long line is disconnected");
+
+    // Half-closed clients still get their answers
+    int halfClosed = connectClient();
+    send(halfClosed, ask.data(), ask.size(), MSG_NOSIGNAL);
+    shutdown(halfClosed, SHUT_WR);
+    ASSERT_TEST(contains(readLine(halfClosed, 5000), "\"id\": \"live\""), "Answers sent after the client stops sending");
+
+    QueryDaemon::stop();
+    server.join();
+    close(stalled);
+    close(active);
+    close(flooding);
+    close(halfClosed);
+    ASSERT_TEST(std::ifstream(SOCKET_FILE).fail(), "Socket file removed on stop");
+}
+
+#endif
+
+// ==================== MAIN TEST RUNNER ====================
+
+int main() {
+    std::cout << "=====================================" << std::endl;
+    std::cout << "   QUERY DAEMON TESTS" << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+    {
+        std::ofstream dictionary(DICTIONARY_FILE);
+        dictionary << "program 200\nprogress 100\napple 50\napplication 40\n";
+    }
+    Utils::setLogToStderr(true);
+    SpellChecker checker;
+    checker.loadDictionary(DICTIONARY_FILE);
+    QueryDaemon daemon(&checker);
+
+    testRequests(daemon);
+    testErrors(daemon);
+    testStream(daemon);
+#ifndef _WIN32
+    testSocketPath(daemon);
+    testSocketClients(daemon);
+#endif
+
+    std::remove(DICTIONARY_FILE);
+
+    std::cout << "\n=====================================" << std::endl;
+    std::cout << "TEST RESULTS:" << std::endl;
+    std::cout << "  Passed: " << tests_passed << std::endl;
+    std::cout << "  Failed: " << tests_failed << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+    if (tests_failed == 0) {
+        std::cout << "\n✓ ALL QUERY DAEMON TESTS PASSED!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n✗ SOME TESTS FAILED!" << std::endl;
+        return 1;
+    }
+}
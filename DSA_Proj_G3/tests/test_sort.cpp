@@ -1,7 +1,10 @@
 #include <iostream>
 #include <cassert>
 #include <chrono>
+#include <functional>
+#include <mutex>
 #include "../include/sort.h"
+#include "../include/threadpool.h"
 
 using namespace SortAlgorithms;
 
@@ -178,6 +181,204 @@ void testPerformance() {
     ASSERT_TEST(duration.count() < 100, "Performance acceptable (<100ms)");
 }
 
+// ==================== ADVERSARIAL INPUT BENCHMARKS ====================
+
+// Inputs that make last-element-pivot quicksort quadratic
+enum class InputShape { Sorted, Reversed, AllEqual };
+
+const char* shapeName(InputShape shape) {
+    switch (shape) {
+        case InputShape::Sorted: return "sorted";
+        case InputShape::Reversed: return "reverse-sorted";
+        default: return "all-equal";
+    }
+}
+
+// (word, frequency) pairs as stored in the dictionary: "sorted" means
+// descending frequency, the order sortByFrequency produces
+std::vector<std::pair<std::string, int>> makeFrequencyInput(int n, InputShape shape) {
+    std::vector<std::pair<std::string, int>> arr;
+    for (int i = 0; i < n; i++) {
+        int rank = shape == InputShape::Reversed ? i : n - i;
+        int frequency = shape == InputShape::AllEqual ? 7 : rank;
+        arr.push_back({"w" + std::to_string(1000000 + (shape == InputShape::Reversed ? n - i : i)),
+                       frequency});
+    }
+    return arr;
+}
+
+bool isSortedByFrequency(const std::vector<std::pair<std::string, int>>& arr) {
+    for (size_t i = 1; i < arr.size(); i++) {
+        if (arr[i - 1].second < arr[i].second) return false;
+        if (arr[i - 1].second == arr[i].second && compareStrings(arr[i - 1].first, arr[i].first) > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename Fn>
+long long timeMs(Fn fn) {
+    auto start = std::chrono::high_resolution_clock::now();
+    fn();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+}
+
+void testAdversarialInputs() {
+    std::cout << "\nTesting Introsort / Radix Sort on Adversarial Inputs..." << std::endl;
+    
+    const int N = 100000;
+    const InputShape shapes[] = {InputShape::Sorted, InputShape::Reversed, InputShape::AllEqual};
+    
+    for (InputShape shape : shapes) {
+        std::string name = shapeName(shape);
+        
+        // Frequency introsort
+        auto byFrequency = makeFrequencyInput(N, shape);
+        long long ms = timeMs([&]() { sortByFrequency(byFrequency); });
+        std::cout << "  ⏱️  sortByFrequency, " << N << " " << name << ": " << ms << "ms" << std::endl;
+        ASSERT_TEST(isSortedByFrequency(byFrequency) && byFrequency.size() == static_cast<size_t>(N),
+                    "sortByFrequency on " + name + " input");
+        ASSERT_TEST(ms < 2000, "sortByFrequency on " + name + " input stays O(n log n)");
+        
+        // Radix sort: same frequency order, input order kept on ties
+        auto radix = makeFrequencyInput(N, shape);
+        auto original = radix;
+        ms = timeMs([&]() { radixSortByFrequency(radix); });
+        std::cout << "  ⏱️  radixSortByFrequency, " << N << " " << name << ": " << ms << "ms" << std::endl;
+        bool ordered = true;
+        for (size_t i = 1; i < radix.size(); i++) {
+            if (radix[i - 1].second < radix[i].second) ordered = false;
+        }
+        ASSERT_TEST(ordered, "radixSortByFrequency on " + name + " input");
+        if (shape == InputShape::AllEqual) {
+            ASSERT_TEST(radix == original, "radixSortByFrequency is stable");
+        }
+        
+        // Lexicographic introsort
+        std::vector<std::string> words;
+        for (const auto& entry : makeFrequencyInput(N, shape)) {
+            words.push_back(shape == InputShape::AllEqual ? std::string("same") : entry.first);
+        }
+        if (shape == InputShape::Sorted) sortLexicographic(words);
+        ms = timeMs([&]() { sortLexicographic(words); });
+        std::cout << "  ⏱️  sortLexicographic, " << N << " " << name << ": " << ms << "ms" << std::endl;
+        bool lexOrdered = true;
+        for (size_t i = 1; i < words.size(); i++) {
+            if (compareStrings(words[i - 1], words[i]) > 0) lexOrdered = false;
+        }
+        ASSERT_TEST(lexOrdered && ms < 2000, "sortLexicographic on " + name + " input");
+        
+        // Correction ranking introsort
+        std::vector<CorrectionCandidate> candidates;
+        for (const auto& entry : makeFrequencyInput(N, shape)) {
+            candidates.push_back(CorrectionCandidate(entry.first, 1, entry.second));
+        }
+        ms = timeMs([&]() { sortByRank(candidates); });
+        std::cout << "  ⏱️  sortByRank, " << N << " " << name << ": " << ms << "ms" << std::endl;
+        bool rankOrdered = true;
+        for (size_t i = 1; i < candidates.size(); i++) {
+            if (candidates[i - 1].frequency < candidates[i].frequency) rankOrdered = false;
+        }
+        ASSERT_TEST(rankOrdered && ms < 2000, "sortByRank on " + name + " input");
+    }
+    
+    // Negative frequencies order below zero
+    std::vector<std::pair<std::string, int>> mixed = {{"a", -5}, {"b", 3}, {"c", 0}, {"d", -1}};
+    radixSortByFrequency(mixed);
+    ASSERT_TEST(mixed[0].first == "b" && mixed[1].first == "c" && mixed[2].first == "d" &&
+                mixed[3].first == "a", "radixSortByFrequency handles negative keys");
+}
+
+// ==================== PARALLEL SORTS ====================
+
+void testParallelSorts() {
+    std::cout << "\nTesting Parallel Merge Sort / Sample Sort..." << std::endl;
+    
+    ThreadPool pool(4);
+    const int N = 200000;
+    
+    // Pseudo-random words (fixed seed) with plenty of duplicates
+    std::vector<std::string> input;
+    unsigned int state = 12345;
+    for (int i = 0; i < N; i++) {
+        state = state * 1103515245u + 12345u;
+        input.push_back("w" + std::to_string((state >> 8) % (N / 4)));
+    }
+    
+    std::vector<std::string> expected = input;
+    long long sequentialMs = timeMs([&]() { sortLexicographic(expected); });
+    
+    std::vector<std::string> merged = input;
+    long long mergeMs = timeMs([&]() { parallelMergeSortLexicographic(merged, pool); });
+    
+    std::vector<std::string> sampled = input;
+    long long sampleMs = timeMs([&]() { sampleSortLexicographic(sampled, pool); });
+    
+    std::cout << "  ⏱️  " << N << " words: introsort " << sequentialMs << "ms, parallel merge sort "
+              << mergeMs << "ms, sample sort " << sampleMs << "ms (" << pool.getConcurrency()
+              << " threads)" << std::endl;
+    ASSERT_TEST(merged == expected, "parallelMergeSortLexicographic matches introsort");
+    ASSERT_TEST(sampled == expected, "sampleSortLexicographic matches introsort");
+    
+    // Adversarial shapes and sizes around the parallel threshold
+    const InputShape shapes[] = {InputShape::Sorted, InputShape::Reversed, InputShape::AllEqual};
+    for (InputShape shape : shapes) {
+        for (int n : {0, 1, 100, 20000, 50001}) {
+            auto entries = makeFrequencyInput(n, shape);
+            sampleSortByWord(entries, pool);
+            bool ordered = entries.size() == static_cast<size_t>(n);
+            for (size_t i = 1; i < entries.size(); i++) {
+                if (compareStrings(entries[i - 1].first, entries[i].first) > 0) ordered = false;
+            }
+            
+            std::vector<std::string> words(n, "same");
+            if (shape != InputShape::AllEqual) {
+                for (int i = 0; i < n; i++) words[i] = makeFrequencyInput(1, shape)[0].first + std::to_string(i);
+            }
+            std::vector<std::string> check = words;
+            sortLexicographic(check);
+            parallelMergeSortLexicographic(words, pool);
+            
+            if (!ordered || words != check) {
+                ASSERT_TEST(false, std::string("Parallel sorts on ") + shapeName(shape) + " input, n = " + std::to_string(n));
+            }
+        }
+    }
+    ASSERT_TEST(true, "Parallel sorts on sorted, reverse-sorted and all-equal inputs");
+    
+    // Dictionary pre-processing: duplicates merged, highest frequency kept
+    std::vector<std::pair<std::string, int>> dictionary = {
+        {"auto", 790}, {"also", 950}, {"Auto", 850}, {"zebra", 10}, {"also", 470}};
+    sampleSortByWord(dictionary, pool);
+    int removed = removeDuplicateWords(dictionary);
+    ASSERT_TEST(removed == 2 && dictionary.size() == 3 &&
+                dictionary[0].first == "also" && dictionary[0].second == 950 &&
+                dictionary[1].second == 850 && dictionary[2].first == "zebra",
+                "removeDuplicateWords keeps one entry per word");
+    
+    // Nested batches must not deadlock a small pool
+    ThreadPool tiny(1);
+    int total = 0;
+    std::mutex totalMutex;
+    std::vector<std::function<void()>> outer;
+    for (int i = 0; i < 4; i++) {
+        outer.push_back([&]() {
+            std::vector<std::function<void()>> inner;
+            for (int j = 0; j < 4; j++) {
+                inner.push_back([&]() {
+                    std::lock_guard<std::mutex> lock(totalMutex);
+                    total++;
+                });
+            }
+            tiny.runAll(inner);
+        });
+    }
+    tiny.runAll(outer);
+    ASSERT_TEST(total == 16, "ThreadPool runs nested batches");
+}
+
 // ==================== MAIN TEST RUNNER ====================
 
 int main() {
@@ -190,6 +391,8 @@ int main() {
     testCorrectionRanking();
     testEdgeCases();
     testPerformance();
+    testAdversarialInputs();
+    testParallelSorts();
     
     std::cout << "\n=====================================" << std::endl;
     std::cout << "TEST RESULTS:" << std::endl;
@@ -0,0 +1,176 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "../include/tokenizer.h"
+
+// Test counter
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define ASSERT_TEST(condition, message) \
+    if (condition) { \
+        tests_passed++; \
+        std::cout << "✓ " << message << std::endl; \
+    } else { \
+        tests_failed++; \
+        std::cout << "✗ " << message << " FAILED!" << std::endl; \
+    }
+
+const char* IMPLEMENTATIONS[] = {"scalar", "sse2", "avx2"};
+
+// Tokenizer output flattened for comparison: "offset:text:lettersOnly|..."
+std::string describe(const std::string& input) {
+    std::string normalized;
+    std::vector<Tokenizer::Token> tokens;
+    Tokenizer::tokenize(input.data(), input.size(), normalized, tokens);
+
+    std::string out = normalized + "#";
+    for (const Tokenizer::Token& token : tokens) {
+        out += std::to_string(token.offset) + ":" + std::string(token.text) + ":" +
+               (token.lettersOnly ? "1" : "0") + "|";
+    }
+    return out;
+}
+
+// Byte-at-a-time reference for describe()
+std::string reference(const std::string& input) {
+    std::string normalized;
+    for (char ch : input) {
+        normalized += (ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch | 0x20) : ch;
+    }
+
+    std::string out = normalized + "#";
+    size_t i = 0;
+    while (i < input.size()) {
+        auto isWord = [&normalized](size_t at) {
+            char ch = normalized[at];
+            return (ch >= 'a' && ch <= 'z') || (ch >= '0' && ch <= '9') || ch == '_';
+        };
+        if (!isWord(i)) {
+            i++;
+            continue;
+        }
+
+        size_t start = i;
+        bool lettersOnly = true;
+        while (i < input.size() && isWord(i)) {
+            char ch = normalized[i];
+            if (ch < 'a' || ch > 'z') lettersOnly = false;
+            i++;
+        }
+        out += std::to_string(start) + ":" + normalized.substr(start, i - start) + ":" +
+               (lettersOnly ? "1" : "0") + "|";
+    }
+    return out;
+}
+
+// Deterministic mix of letters, digits, '_', separators and bytes >= 0x80
+std::string generate(size_t length, uint32_t seed) {
+    const char alphabet[] = "abcXYZq09_ .,\n\t-\x80\xc3\xa9\xff\x7f";
+    std::string text;
+    for (size_t i = 0; i < length; i++) {
+        seed = seed * 1103515245u + 12345u;
+        text += alphabet[(seed >> 16) % (sizeof(alphabet) - 1)];
+    }
+    return text;
+}
+
+// ==================== TEST FUNCTIONS ====================
+
+void testImplementation(const char* name, const std::vector<std::string>& inputs) {
+    std::cout << "\nTesting " << name << " Implementation..." << std::endl;
+
+    bool allMatch = true;
+    std::string firstMismatch;
+    for (const std::string& input : inputs) {
+        if (describe(input) != reference(input)) {
+            if (allMatch) firstMismatch = input;
+            allMatch = false;
+        }
+    }
+    ASSERT_TEST(allMatch, std::string(name) + ": tokens and normalized text match the byte-wise reference" +
+                          (allMatch ? "" : " (input \"" + firstMismatch + "\")"));
+
+    std::string normalized;
+    std::vector<Tokenizer::Token> tokens;
+    Tokenizer::tokenize("", 0, normalized, tokens);
+    ASSERT_TEST(normalized.empty() && tokens.empty(), std::string(name) + ": empty input");
+
+    std::string separators(200, ' ');
+    for (size_t i = 0; i < separators.size(); i += 3) separators[i] = ',';
+    Tokenizer::tokenize(separators.data(), separators.size(), normalized, tokens);
+    ASSERT_TEST(tokens.empty() && normalized == separators, std::string(name) + ": all-separator input");
+
+    // A word across every 16 / 32 / 64-byte boundary position
+    bool straddles = true;
+    for (size_t start = 1; start < 70; start++) {
+        std::string text = std::string(start, ' ') + "HeLLo_7" + std::string(70, '.');
+        Tokenizer::tokenize(text.data(), text.size(), normalized, tokens);
+        straddles = straddles && tokens.size() == 1 && tokens[0].offset == start &&
+                    tokens[0].text == "hello_7" && !tokens[0].lettersOnly;
+    }
+    ASSERT_TEST(straddles, std::string(name) + ": tokens straddling vector boundaries");
+
+    std::string high = "caf\xc3\xa9 \xff\x80word\x80";
+    Tokenizer::tokenize(high.data(), high.size(), normalized, tokens);
+    ASSERT_TEST(tokens.size() == 2 && tokens[0].text == "caf" && tokens[1].text == "word" &&
+                tokens[1].offset == 8 && normalized == high,
+                std::string(name) + ": bytes >= 0x80 split tokens and are copied as is");
+
+    bool lowered = true;
+    for (size_t length = 0; length < 100; length++) {
+        std::string text = generate(length, static_cast<uint32_t>(length) + 7);
+        std::string out(length, '\0');
+        Tokenizer::toLowerASCII(text.data(), length, &out[0]);
+        std::string expected = reference(text);
+        lowered = lowered && out == expected.substr(0, length);
+    }
+    ASSERT_TEST(lowered, std::string(name) + ": toLowerASCII for every tail length");
+}
+
+// ==================== MAIN TEST RUNNER ====================
+
+int main() {
+    std::cout << "=====================================" << std::endl;
+    std::cout << "   TOKENIZER TESTS" << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+    std::string selected = Tokenizer::implementationName();
+    std::cout << "Selected for this CPU: " << selected << std::endl;
+
+    // Every length up to three 64-byte blocks, plus a few long inputs
+    std::vector<std::string> inputs;
+    for (size_t length = 0; length <= 200; length++) {
+        inputs.push_back(generate(length, static_cast<uint32_t>(length)));
+    }
+    for (uint32_t seed = 1; seed <= 20; seed++) {
+        inputs.push_back(generate(4096 + seed, seed * 977));
+    }
+
+    for (const char* name : IMPLEMENTATIONS) {
+        if (!Tokenizer::setImplementation(name)) {
+            std::cout << "\nSkipped " << name << ": not available on this CPU / build" << std::endl;
+            continue;
+        }
+        testImplementation(name, inputs);
+    }
+
+    Tokenizer::setImplementation(selected);
+    ASSERT_TEST(selected == Tokenizer::implementationName(), "Selected implementation restored");
+    ASSERT_TEST(!Tokenizer::setImplementation("neon64"), "Unknown implementation rejected");
+
+    std::cout << "\n=====================================" << std::endl;
+    std::cout << "TEST RESULTS:" << std::endl;
+    std::cout << "  Passed: " << tests_passed << std::endl;
+    std::cout << "  Failed: " << tests_failed << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+    if (tests_failed == 0) {
+        std::cout << "\n✓ ALL TOKENIZER TESTS PASSED!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n✗ SOME TESTS FAILED!" << std::endl;
+        return 1;
+    }
+}
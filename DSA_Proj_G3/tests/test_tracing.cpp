@@ -0,0 +1,135 @@
+#include <iostream>
+#include <string>
+#include <thread>
+#include "../include/tracing.h"
+
+// Test counter
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define ASSERT_TEST(condition, message) \
+    if (condition) { \
+        tests_passed++; \
+        std::cout << "✓ " << message << std::endl; \
+    } else { \
+        tests_failed++; \
+        std::cout << "✗ " << message << " FAILED!" << std::endl; \
+    }
+
+size_t countOf(const std::string& text, const std::string& part) {
+    size_t count = 0;
+    for (size_t pos = text.find(part); pos != std::string::npos; pos = text.find(part, pos + 1)) {
+        count++;
+    }
+    return count;
+}
+
+// ==================== TEST FUNCTIONS ====================
+
+void testDisabled() {
+    std::cout << "\nTesting Disabled Tracing..." << std::endl;
+
+    Tracing::setEnabled(false);
+    {
+        Tracing::Span span("ignored");
+    }
+    ASSERT_TEST(!Tracing::isEnabled(), "Tracing starts off");
+    ASSERT_TEST(Tracing::bufferedEvents() == 0, "Spans record nothing while off");
+}
+
+void testSpans() {
+    std::cout << "\nTesting Spans..." << std::endl;
+
+    Tracing::setEnabled(true);
+    {
+        Tracing::Span outer("request");
+        {
+            Tracing::Span inner("trie");
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+    Tracing::setEnabled(false);
+
+    ASSERT_TEST(Tracing::bufferedEvents() == 2, "One event per span");
+
+    std::string json = Tracing::chromeTraceJSON();
+    ASSERT_TEST(json.compare(0, 16, "{\"traceEvents\":[") == 0, "Chrome trace document");
+    ASSERT_TEST(countOf(json, "\"ph\":\"X\"") == 2, "Spans are complete events");
+    ASSERT_TEST(countOf(json, "\"name\":\"thread_name\"") == 1, "Thread named once");
+
+    // The inner span closes first, so it is recorded first
+    size_t trie = json.find("\"name\":\"trie\"");
+    size_t request = json.find("\"name\":\"request\"");
+    ASSERT_TEST(trie != std::string::npos && request != std::string::npos && trie < request,
+                "Events in recording order");
+
+    size_t dur = json.find("\"dur\":", trie);
+    double trieUs = std::stod(json.substr(dur + 6));
+    ASSERT_TEST(trieUs >= 2000.0 && trieUs < 1000000.0, "Duration in microseconds");
+
+    Tracing::clear();
+    ASSERT_TEST(Tracing::bufferedEvents() == 0, "Clear drops buffered events");
+}
+
+void testRingAndThreads() {
+    std::cout << "\nTesting Per-Thread Rings..." << std::endl;
+
+    Tracing::Config config;
+    config.enabled = true;
+    config.ringEvents = 8;
+    Tracing::configure(config);
+
+    // A new thread gets a new ring with the configured size
+    std::thread worker([]() {
+        for (int i = 0; i < 20; i++) {
+            Tracing::Span span("bktree");
+        }
+    });
+    worker.join();
+    Tracing::setEnabled(false);
+
+    std::string json = Tracing::chromeTraceJSON();
+    ASSERT_TEST(Tracing::bufferedEvents() == 8, "Full ring keeps only its newest events");
+    ASSERT_TEST(countOf(json, "\"name\":\"thread_name\"") == 2, "Each thread has its own ring");
+    ASSERT_TEST(countOf(json, "\"tid\":2") == 9, "Worker events carry the worker's thread id");
+
+    Tracing::clear();
+}
+
+void testConfig() {
+    std::cout << "\nTesting Configuration..." << std::endl;
+
+    Tracing::Config defaults;
+    ASSERT_TEST(!defaults.enabled && defaults.ringEvents == 16384, "Off by default, 16384 events per thread");
+
+    ASSERT_TEST(Tracing::writeChromeTrace("build/test_trace.json"), "Trace written to a file");
+    ASSERT_TEST(!Tracing::writeChromeTrace("build/missing/dir/trace.json"), "Unwritable path reported");
+    std::remove("build/test_trace.json");
+}
+
+// ==================== MAIN TEST RUNNER ====================
+
+int main() {
+    std::cout << "=====================================" << std::endl;
+    std::cout << "   TRACING TESTS" << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+    testDisabled();
+    testSpans();
+    testRingAndThreads();
+    testConfig();
+
+    std::cout << "\n=====================================" << std::endl;
+    std::cout << "TEST RESULTS:" << std::endl;
+    std::cout << "  Passed: " << tests_passed << std::endl;
+    std::cout << "  Failed: " << tests_failed << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+    if (tests_failed == 0) {
+        std::cout << "\n✓ ALL TRACING TESTS PASSED!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n✗ SOME TESTS FAILED!" << std::endl;
+        return 1;
+    }
+}
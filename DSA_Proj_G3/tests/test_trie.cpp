@@ -1,7 +1,10 @@
 #include "../include/trie.h"
 #include <iostream>
 #include <cassert>
+#include <cmath>
 #include <vector>
+#include <string>
+#include <chrono>
 
 void testInsertAndSearch() {
     std::cout << "Testing Trie Insert and Search..." << std::endl;
@@ -82,6 +85,104 @@ void testSuggestWords() {
     std::cout << "✓ Suggest Words tests passed!" << std::endl;
 }
 
+void testTopKByFrequency() {
+    std::cout << "Testing Trie Top-K by Frequency..." << std::endl;
+    
+    Trie trie;
+    
+    trie.insertWord("code", 150);
+    trie.insertWord("coding", 140);
+    trie.insertWord("coder", 140);
+    trie.insertWord("codec", 120);
+    trie.insertWord("cod", 10);
+    trie.insertWord("cold", 500);
+    
+    auto top = trie.topKByFrequency("COD", 3);
+    
+    // Frequencies come with the words; ties break alphabetically
+    assert(top.size() == 3);
+    assert(top[0].first == "code" && top[0].second == 150);
+    assert(top[1].first == "coder" && top[1].second == 140);
+    assert(top[2].first == "coding" && top[2].second == 140);
+    
+    // k larger than the match count returns every match
+    assert(trie.topKByFrequency("cod", 10).size() == 5);
+    assert(trie.topKByFrequency("cod", 0).empty());
+    assert(trie.topKByFrequency("xyz", 5).empty());
+    
+    // All-equal frequencies: alphabetical order
+    Trie flat;
+    flat.insertWord("bb", 1);
+    flat.insertWord("ba", 1);
+    flat.insertWord("bc", 1);
+    flat.insertWord("b", 1);
+    auto equal = flat.topKByFrequency("b", 3);
+    assert(equal.size() == 3);
+    assert(equal[0].first == "b" && equal[1].first == "ba" && equal[2].first == "bb");
+    
+    std::cout << "✓ Top-K by Frequency tests passed!" << std::endl;
+}
+
+void testBulkBuild() {
+    std::cout << "Testing Trie Sorted Bulk Build..." << std::endl;
+    
+    std::vector<std::pair<std::string, int>> sorted = {
+        {"auto", 90}, {"autocomplete", 95}, {"automatic", 80}, {"code", 150},
+        {"coder", 130}, {"coding", 140}, {"computer", 120}};
+    
+    Trie bulk(sorted);
+    Trie incremental;
+    for (const auto& entry : sorted) {
+        incremental.insertWord(entry.first, entry.second);
+    }
+    
+    assert(bulk.getWordCount() == 7);
+    assert(bulk.searchWord("autocomplete") == true);
+    assert(bulk.searchWord("autoc") == false);
+    assert(bulk.topKByFrequency("co", 10) == incremental.topKByFrequency("co", 10));
+    assert(bulk.topKByFrequency("auto", 10) == incremental.topKByFrequency("auto", 10));
+    
+    // Later inserts and updates mix heap nodes with bulk-built ones
+    bulk.insertWord("autobahn", 10);
+    bulk.updateFrequency("code", 5);
+    assert(bulk.searchWord("autobahn") == true);
+    assert(bulk.topKByFrequency("cod", 1)[0].second == 155);
+    
+    // Unsorted input and duplicates are still handled (last one wins)
+    std::vector<std::pair<std::string, int>> shuffled = {{"zebra", 1}, {"apple", 2}, {"zeal", 3}, {"apple", 4}};
+    Trie unsorted;
+    unsorted.buildSorted(shuffled);
+    assert(unsorted.getWordCount() == 3);
+    assert(unsorted.topKByFrequency("apple", 1)[0].second == 4);
+    assert(unsorted.searchWord("zeal") == true);
+    
+    // Timing: 200k words, incremental vs bulk
+    std::vector<std::pair<std::string, int>> large;
+    for (int i = 0; i < 200000; i++) {
+        large.push_back({"w" + std::to_string(1000000 + i), i});
+    }
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    {
+        Trie byInsert;
+        for (const auto& entry : large) byInsert.insertWord(entry.first, entry.second);
+    }
+    auto middle = std::chrono::high_resolution_clock::now();
+    {
+        Trie byBulk(large);
+        assert(byBulk.searchWord("w1199999") == true);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    
+    std::cout << "  200k words: insertWord "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(middle - start).count()
+              << "ms, buildSorted "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(end - middle).count()
+              << "ms (including teardown)" << std::endl;
+    
+    std::cout << "✓ Sorted Bulk Build tests passed!" << std::endl;
+}
+
 void testFrequencyUpdate() {
     std::cout << "Testing Trie Frequency Update..." << std::endl;
     
@@ -99,6 +200,74 @@ void testFrequencyUpdate() {
     std::cout << "✓ Frequency Update tests passed!" << std::endl;
 }
 
+void testRemoveWord() {
+    std::cout << "Testing Trie Remove and Set Frequency..." << std::endl;
+    
+    Trie trie;
+    trie.insertWord("car", 10);
+    trie.insertWord("card", 20);
+    trie.insertWord("care", 30);
+    
+    // Removing a word that others extend keeps the path
+    assert(trie.removeWord("car") == true);
+    assert(trie.searchWord("car") == false);
+    assert(trie.searchWord("card") == true);
+    assert(trie.removeWord("car") == false);
+    assert(trie.removeWord("ca") == false);
+    
+    // Removing a leaf prunes only its own branch
+    assert(trie.removeWord("card") == true);
+    assert(trie.searchPrefix("car").size() == 1);
+    assert(trie.getWordCount() == 1);
+    
+    assert(trie.setFrequency("care", 5) == true);
+    assert(trie.topKByFrequency("c", 1)[0].second == 5);
+    assert(trie.setFrequency("card", 5) == false);
+    
+    // Bulk-built nodes are unlinked, then reused paths are rebuilt on insert
+    std::vector<std::pair<std::string, int>> sorted = {{"code", 150}, {"coder", 130}, {"coding", 140}};
+    Trie bulk(sorted);
+    assert(bulk.removeWord("coder") == true);
+    assert(bulk.removeWord("coding") == true);
+    assert(bulk.topKByFrequency("cod", 10).size() == 1);
+    bulk.insertWord("coding", 1);
+    assert(bulk.searchWord("coding") == true);
+    
+    std::cout << "✓ Remove and Set Frequency tests passed!" << std::endl;
+}
+
+void testRecencyRanking() {
+    std::cout << "Testing Trie Time-Decayed Ranking..." << std::endl;
+    
+    uint32_t now = 1000000;
+    Trie trie;
+    trie.setClock([&now]() { return now; });
+    trie.setRecency(3600, 10);   // 1 hour half-life, a fresh use = 10 points
+    trie.insertWord("help", 100);
+    trie.insertWord("hello", 50);
+    
+    assert(trie.topKByFrequency("hel", 1)[0].first == "help");
+    
+    // 10 uses: 50 + 10 * 10 = 150 beats 100; the frequency is unchanged
+    for (int i = 0; i < 10; i++) {
+        assert(trie.recordUse("hello") == true);
+    }
+    assert(trie.topKByFrequency("hel", 1)[0] == std::make_pair(std::string("hello"), 150));
+    assert(trie.searchPrefix("hello")[0].second == 50);
+    assert(trie.recordUse("helo") == false);
+    
+    // Two half-lives later the burst is worth a quarter: 50 + 25 < 100
+    now += 2 * 3600;
+    assert(std::abs(trie.getRecentScore("hello") - 2.5) < 1e-3);
+    assert(trie.topKByFrequency("hel", 1)[0].first == "help");
+    
+    // A new use decays the old score first, then adds
+    trie.recordUse("hello");
+    assert(std::abs(trie.getRecentScore("hello") - 3.5) < 1e-3);
+    
+    std::cout << "✓ Time-Decayed Ranking tests passed!" << std::endl;
+}
+
 void testWordCount() {
     std::cout << "Testing Trie Word Count..." << std::endl;
     
@@ -130,6 +299,39 @@ void testCaseInsensitive() {
     std::cout << "✓ Case Insensitivity tests passed!" << std::endl;
 }
 
+void testMemoryBytes() {
+    std::cout << "Testing Trie Memory Accounting..." << std::endl;
+    
+    Trie trie;
+    size_t empty = trie.getMemoryBytes();
+    assert(empty >= sizeof(Trie) + sizeof(TrieNode));
+    
+    // "car" adds three nodes, "cart" one more
+    trie.insertWord("car", 1);
+    assert(trie.getMemoryBytes() == empty + 3 * sizeof(TrieNode));
+    trie.insertWord("cart", 1);
+    assert(trie.getMemoryBytes() == empty + 4 * sizeof(TrieNode));
+    
+    // Pruned nodes are given back; shared ones stay
+    trie.removeWord("cart");
+    assert(trie.getMemoryBytes() == empty + 3 * sizeof(TrieNode));
+    trie.removeWord("car");
+    assert(trie.getMemoryBytes() == empty);
+    
+    // A bulk build allocates whole blocks, however few nodes it uses
+    Trie bulk;
+    size_t before = bulk.getMemoryBytes();
+    bulk.buildSorted(std::vector<std::pair<std::string, int>>{{"ab", 1}, {"ac", 1}});
+    size_t after = bulk.getMemoryBytes();
+    assert(after - before >= 1024 * sizeof(TrieNode));
+    
+    // Removed bulk-built nodes stay in their block
+    bulk.removeWord("ac");
+    assert(bulk.getMemoryBytes() == after);
+    
+    std::cout << "✓ Memory Accounting tests passed!" << std::endl;
+}
+
 int main() {
     std::cout << "====================================" << std::endl;
     std::cout << "    TRIE DATA STRUCTURE TESTS      " << std::endl;
@@ -140,9 +342,14 @@ int main() {
         testInsertAndSearch();
         testPrefixSearch();
         testSuggestWords();
+        testTopKByFrequency();
+        testBulkBuild();
         testFrequencyUpdate();
+        testRemoveWord();
+        testRecencyRanking();
         testWordCount();
         testCaseInsensitive();
+        testMemoryBytes();
         
         std::cout << std::endl;
         std::cout << "====================================" << std::endl;
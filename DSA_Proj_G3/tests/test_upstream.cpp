@@ -0,0 +1,477 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <fstream>
+#include <cstdio>
+#include "../include/upstreamclient.h"
+#include "../include/queryrouter.h"
+#include "../include/lrucache.h"
+#include "../include/trie.h"
+#include "../include/hashtable.h"
+#include "../include/dictionaryindex.h"
+
+// Test counter
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define ASSERT_TEST(condition, message) \
+    if (condition) { \
+        tests_passed++; \
+        std::cout << "✓ " << message << std::endl; \
+    } else { \
+        tests_failed++; \
+        std::cout << "✗ " << message << " FAILED!" << std::endl; \
+    }
+
+#ifndef _WIN32
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <mutex>
+
+using Clock = std::chrono::steady_clock;
+
+long long elapsedMs(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+}
+
+// ==================== STAND-IN UPSTREAM ====================
+
+/**
+ * Minimal keep-alive HTTP server imitating Datamuse and DictionaryAPI
+ *
+ * Routes (any prefix before them is ignored):
+ * - /sug?s=...          -> two suggestions
+ * - /words?sp=...       -> one correction (chunked encoding)
+ * - /entries/en/known   -> a definition
+ * - /entries/en/<other> -> 404 "No Definitions Found"
+ * Prefixes:
+ * - /slow/...           -> answer after 500 ms
+ * - /fail/...           -> 500 Internal Server Error
+ */
+class StandInServer {
+private:
+    int listenSocket;
+    int port;
+    std::thread acceptThread;
+    std::vector<std::thread> connectionThreads;
+    std::mutex threadsMutex;
+
+    void respond(int client, int status, const std::string& body, bool chunked) {
+        std::string statusText = status == 200 ? "OK" : (status == 404 ? "Not Found" : "Internal Server Error");
+        std::string response = "HTTP/1.1 " + std::to_string(status) + " " + statusText + "\r\n"
+                               "Content-Type: application/json\r\n";
+        if (chunked) {
+            // Split the body in two chunks to exercise the decoder
+            size_t half = body.length() / 2;
+            char sizes[64];
+            response += "Transfer-Encoding: chunked\r\n\r\n";
+            snprintf(sizes, sizeof(sizes), "%zx\r\n", half);
+            response += sizes + body.substr(0, half) + "\r\n";
+            snprintf(sizes, sizeof(sizes), "%zx\r\n", body.length() - half);
+            response += sizes + body.substr(half) + "\r\n0\r\n\r\n";
+        } else {
+            response += "Content-Length: " + std::to_string(body.length()) + "\r\n\r\n" + body;
+        }
+        send(client, response.c_str(), response.length(), MSG_NOSIGNAL);
+    }
+
+    void serve(int client) {
+        std::string buffer;
+        char chunk[4096];
+
+        while (true) {
+            size_t headerEnd;
+            while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+                ssize_t n = recv(client, chunk, sizeof(chunk), 0);
+                if (n <= 0) {
+                    close(client);
+                    return;
+                }
+                buffer.append(chunk, static_cast<size_t>(n));
+            }
+
+            std::string requestLine = buffer.substr(0, buffer.find("\r\n"));
+            buffer.erase(0, headerEnd + 4);
+            requests++;
+
+            size_t pathStart = requestLine.find(' ') + 1;
+            std::string path = requestLine.substr(pathStart, requestLine.find(' ', pathStart) - pathStart);
+
+            if (path.compare(0, 6, "/slow/") == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(500));
+            }
+
+            if (path.compare(0, 6, "/fail/") == 0) {
+                respond(client, 500, "{\"error\":\"upstream broken\"}", false);
+            } else if (path.find("/sug?") != std::string::npos) {
+                respond(client, 200, "[{\"word\":\"hello\",\"score\":3000},{\"word\":\"help\",\"score\":2500}]", false);
+            } else if (path.find("/words?") != std::string::npos) {
+                respond(client, 200, "[{\"word\":\"spelling\",\"score\":1200}]", true);
+            } else if (path.find("/entries/en/known") != std::string::npos) {
+                respond(client, 200, "[{\"word\":\"known\",\"phonetic\":\"/noun/\",\"meanings\":[{\"definitions\":"
+                                     "[{\"definition\":\"Recognized by many.\"}]}]}]", false);
+            } else {
+                respond(client, 404, "{\"title\":\"No Definitions Found\"}", false);
+            }
+        }
+    }
+
+public:
+    std::atomic<int> requests;
+    std::atomic<int> connections;
+
+    StandInServer() : listenSocket(-1), port(0), requests(0), connections(0) {
+        listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+
+        sockaddr_in address;
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;  // Any free port
+        bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        listen(listenSocket, 16);
+
+        socklen_t length = sizeof(address);
+        getsockname(listenSocket, reinterpret_cast<sockaddr*>(&address), &length);
+        port = ntohs(address.sin_port);
+
+        acceptThread = std::thread([this]() {
+            while (true) {
+                int client = accept(listenSocket, nullptr, nullptr);
+                if (client < 0) return;
+                connections++;
+                std::lock_guard<std::mutex> lock(threadsMutex);
+                connectionThreads.emplace_back(&StandInServer::serve, this, client);
+            }
+        });
+    }
+
+    ~StandInServer() {
+        shutdown(listenSocket, SHUT_RDWR);
+        close(listenSocket);
+        acceptThread.join();
+        for (std::thread& thread : connectionThreads) {
+            thread.join();
+        }
+    }
+
+    std::string url(const std::string& prefix = "") const {
+        return "http://127.0.0.1:" + std::to_string(port) + prefix;
+    }
+};
+
+UpstreamClient::Config standInConfig(const StandInServer& server, const std::string& prefix) {
+    UpstreamClient::Config config;
+    config.datamuseBaseUrl = server.url(prefix);
+    config.dictionaryBaseUrl = server.url(prefix + "/entries/en");
+    config.timeoutMs = 2000;
+    return config;
+}
+
+// ==================== TEST FUNCTIONS ====================
+
+void testMergeRanked() {
+    std::cout << "\nTesting Rank Fusion..." << std::endl;
+
+    std::vector<std::pair<std::string, int>> local = {{"apple", 900}, {"apply", 500}, {"ape", 10}};
+    std::vector<std::pair<std::string, int>> remote = {{"Apply", 3000}, {"appetite", 2000}};
+
+    auto merged = QueryRouter::mergeRanked(local, remote, 10);
+
+    ASSERT_TEST(merged.size() == 4, "Duplicates merged case-insensitively");
+    ASSERT_TEST(merged[0].first == "apply", "Word ranked by both lists comes first");
+    ASSERT_TEST(merged[1].first == "apple" && merged[2].first == "appetite" && merged[3].first == "ape",
+                "Remaining words ordered by rank");
+    ASSERT_TEST(QueryRouter::mergeRanked(local, remote, 2).size() == 2, "Result limited to maxResults");
+}
+
+void testTimeToLiveCache() {
+    std::cout << "\nTesting LRU Cache Time-To-Live..." << std::endl;
+
+    LRUCache cache(10, 50);
+    std::string value;
+    cache.put("prefix", "body");
+
+    ASSERT_TEST(cache.get("prefix", value) && value == "body", "Fresh entry is a hit");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(80));
+    ASSERT_TEST(!cache.get("prefix", value), "Expired entry is a miss");
+    ASSERT_TEST(cache.getSize() == 0, "Expired entry is removed");
+
+    LRUCache forever(10);
+    forever.put("prefix", "body");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_TEST(forever.get("prefix", value), "Entries without TTL never expire");
+}
+
+void testFetchAndCache(StandInServer& server) {
+    std::cout << "\nTesting Fetch, Cache and Connection Reuse..." << std::endl;
+
+    UpstreamClient client(standInConfig(server, ""));
+    int requestsBefore = server.requests;
+    int connectionsBefore = server.connections;
+
+    auto deadline = client.defaultDeadline();
+    auto pending = client.fetchAutocompleteAsync("hel", 10, deadline);
+    auto result = UpstreamClient::await(pending, deadline);
+
+    ASSERT_TEST(result.ok && !result.cached, "Autocomplete fetched from upstream");
+    ASSERT_TEST(result.suggestions.size() == 2 && result.suggestions[0].word == "hello" &&
+                result.suggestions[0].score == 3000, "Suggestions parsed");
+
+    deadline = client.defaultDeadline();
+    pending = client.fetchAutocompleteAsync("hel", 10, deadline);
+    ASSERT_TEST(pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready,
+                "Cache hit completes without waiting");
+    result = UpstreamClient::await(pending, deadline);
+    ASSERT_TEST(result.ok && result.cached && result.suggestions.size() == 2, "Second call served from cache");
+    ASSERT_TEST(server.requests == requestsBefore + 1, "Cache hit sends no request");
+
+    deadline = client.defaultDeadline();
+    auto spelling = client.fetchSpellingAsync("speling", 10, deadline);
+    auto corrections = UpstreamClient::await(spelling, deadline);
+    ASSERT_TEST(corrections.ok && corrections.suggestions.size() == 1 &&
+                corrections.suggestions[0].word == "spelling", "Chunked response decoded");
+
+    ASSERT_TEST(server.connections == connectionsBefore + 1, "Keep-alive connection reused");
+    ASSERT_TEST(client.getStats().connectionsReused >= 1, "Reuse counted in stats");
+}
+
+void testDefinitions(StandInServer& server) {
+    std::cout << "\nTesting Definitions..." << std::endl;
+
+    UpstreamClient client(standInConfig(server, ""));
+
+    auto deadline = client.defaultDeadline();
+    auto known = client.fetchDefinitionAsync("known", deadline);
+    auto unknown = client.fetchDefinitionAsync("qzxv", deadline);
+
+    auto knownResult = UpstreamClient::await(known, deadline);
+    auto unknownResult = UpstreamClient::await(unknown, deadline);
+
+    ASSERT_TEST(knownResult.ok && knownResult.entry.found &&
+                knownResult.entry.definition == "Recognized by many.", "Definition parsed");
+    ASSERT_TEST(unknownResult.ok && !unknownResult.entry.found, "404 means not found, not an error");
+    ASSERT_TEST(client.getDictionaryState() == CircuitBreaker::State::Closed, "404 does not trip the breaker");
+}
+
+void testDeadline(StandInServer& server) {
+    std::cout << "\nTesting Deadlines..." << std::endl;
+
+    UpstreamClient::Config config = standInConfig(server, "/slow");
+    config.timeoutMs = 100;
+    UpstreamClient client(config);
+
+    auto start = Clock::now();
+    auto deadline = client.defaultDeadline();
+    auto pending = client.fetchAutocompleteAsync("slow", 10, deadline);
+    auto result = UpstreamClient::await(pending, deadline);
+    long long waited = elapsedMs(start);
+
+    ASSERT_TEST(!result.ok, "Slow upstream reported as unavailable");
+    ASSERT_TEST(waited < 300, "Caller waited about the deadline (" + std::to_string(waited) + "ms)");
+
+    // Let the worker observe its own timeout
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_TEST(client.getStats().timeouts == 1, "Timeout counted");
+}
+
+void testCircuitBreaker(StandInServer& server) {
+    std::cout << "\nTesting Circuit Breaker..." << std::endl;
+
+    UpstreamClient::Config config = standInConfig(server, "/fail");
+    config.failureThreshold = 2;
+    config.breakerOpenMs = 200;
+    UpstreamClient client(config);
+
+    int requestsBefore = server.requests;
+    for (int i = 0; i < 2; i++) {
+        auto deadline = client.defaultDeadline();
+        auto pending = client.fetchAutocompleteAsync("fail" + std::to_string(i), 10, deadline);
+        auto result = UpstreamClient::await(pending, deadline);
+        ASSERT_TEST(!result.ok && result.error == "HTTP 500", "Server error reported");
+    }
+
+    ASSERT_TEST(client.getDatamuseState() == CircuitBreaker::State::Open, "Breaker opened after threshold");
+
+    auto start = Clock::now();
+    auto deadline = client.defaultDeadline();
+    auto pending = client.fetchAutocompleteAsync("fail9", 10, deadline);
+    ASSERT_TEST(pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready,
+                "Open breaker answers immediately");
+    auto result = UpstreamClient::await(pending, deadline);
+    ASSERT_TEST(!result.ok && result.error == "Circuit open" && elapsedMs(start) < 50,
+                "Open breaker short-circuits");
+    ASSERT_TEST(server.requests == requestsBefore + 2, "No request sent while open");
+
+    // Other upstreams have their own breaker
+    ASSERT_TEST(client.getDictionaryState() == CircuitBreaker::State::Closed, "Breakers are per upstream");
+
+    // After the cool-down one trial request goes through
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    deadline = client.defaultDeadline();
+    pending = client.fetchAutocompleteAsync("fail10", 10, deadline);
+    result = UpstreamClient::await(pending, deadline);
+    ASSERT_TEST(server.requests == requestsBefore + 3, "Trial request sent after cool-down");
+    ASSERT_TEST(client.getDatamuseState() == CircuitBreaker::State::Open, "Failed trial reopens the breaker");
+}
+
+void testLocalFirstRouting(StandInServer& server) {
+    std::cout << "\nTesting Local-First Routing..." << std::endl;
+
+    SpellChecker* spellchecker = new SpellChecker();
+    spellchecker->addWord("hello", 100);
+    spellchecker->addWord("helmet", 50);
+    DictionaryManager dictionaries(std::make_shared<DictionaryIndex>(spellchecker, "test"));
+
+    // Slow upstream: the local answer must not wait for it
+    UpstreamClient::Config slowConfig = standInConfig(server, "/slow");
+    UpstreamClient slowClient(slowConfig);
+
+    QueryRouter::Config routerConfig;
+    routerConfig.remoteBudgetMs = 20;
+    routerConfig.prefetchIntervalMs = 0;
+    QueryRouter slowRouter(&dictionaries, &slowClient, routerConfig);
+
+    auto start = Clock::now();
+    QueryRouter::Answer answer = slowRouter.autocomplete("hel");
+    long long waited = elapsedMs(start);
+
+    ASSERT_TEST(answer.source == "local" && answer.suggestions.size() == 2, "Local answer returned");
+    ASSERT_TEST(waited < 100, "Answered within the budget (" + std::to_string(waited) + "ms)");
+
+    // The late remote answer is cached and merged next time
+    std::this_thread::sleep_for(std::chrono::milliseconds(600));
+    answer = slowRouter.autocomplete("hel");
+    ASSERT_TEST(answer.source == "local+datamuse", "Late remote result merged from cache");
+    ASSERT_TEST(answer.suggestions.size() == 3 && answer.suggestions[0].first == "hello",
+                "Merged ranking puts shared words first");
+
+    // Prefetching refreshes popular prefixes once their cache entry expires
+    UpstreamClient::Config fastConfig = standInConfig(server, "");
+    fastConfig.cacheTtlMs = 100;
+    UpstreamClient fastClient(fastConfig);
+
+    routerConfig.remoteBudgetMs = 0;
+    QueryRouter fastRouter(&dictionaries, &fastClient, routerConfig);
+
+    fastRouter.autocomplete("hel");
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    ASSERT_TEST(fastRouter.prefetchPopular() == 1, "Expired popular prefix prefetched");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    answer = fastRouter.autocomplete("hel");
+    ASSERT_TEST(answer.source == "local+datamuse", "Prefetched result used with zero budget");
+    ASSERT_TEST(fastClient.getStats().prefetches == 1, "Prefetch counted");
+
+    size_t hitsBefore = fastClient.getStats().cacheHits;
+    answer = fastRouter.autocomplete("HeL");
+    ASSERT_TEST(answer.source == "local+datamuse" && fastClient.getStats().cacheHits == hitsBefore + 1,
+                "Mixed-case query shares the prefetched entry");
+}
+
+void testDictionaryReload() {
+    std::cout << "\nTesting Dictionary Reload..." << std::endl;
+
+    const char* file = "build/test_reload.tmp";
+    { std::ofstream out(file); out << "hello 100\nhelmet 50\n"; }
+
+    DictionaryManager dictionaries(file);
+    ASSERT_TEST(dictionaries.acquire() == nullptr, "Nothing published before the first load");
+    ASSERT_TEST(dictionaries.reload() && dictionaries.getStats().generation == 1, "Initial load");
+
+    ASSERT_TEST(dictionaries.acquire()->getEngine()->getSuggestions("hel").size() == 2,
+                "Served from generation 1");
+
+    // A query in flight keeps its snapshot across the swap
+    std::shared_ptr<DictionaryIndex> inFlight = dictionaries.acquire();
+    { std::ofstream out(file); out << "hello 100\nhelmet 50\nhelp 70\n"; }
+    ASSERT_TEST(dictionaries.reload(), "Reload published");
+    ASSERT_TEST(inFlight->getWordCount() == 2 && inFlight->getEngine()->getSuggestions("hel").size() == 2,
+                "Old snapshot still usable after the swap");
+    ASSERT_TEST(dictionaries.acquire()->getEngine()->getSuggestions("hel").size() == 3,
+                "New queries see generation 2");
+
+    // Background reload via the signal-safe flag
+    { std::ofstream out(file); out << "help 70\n"; }
+    dictionaries.requestReload();
+    for (int i = 0; i < 50 && dictionaries.getStats().generation < 3; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    ASSERT_TEST(dictionaries.getStats().generation == 3 && dictionaries.acquire()->getWordCount() == 1,
+                "Requested reload runs in the background");
+
+    // A broken dictionary keeps the current index
+    std::remove(file);
+    ASSERT_TEST(!dictionaries.reload(), "Reload of a missing file fails");
+    DictionaryManager::Stats stats = dictionaries.getStats();
+    ASSERT_TEST(stats.generation == 3 && stats.reloads == 2 && stats.failedReloads == 1 &&
+                dictionaries.acquire()->getWordCount() == 1, "Failed reload keeps serving");
+}
+
+void testUnreachableUpstream() {
+    std::cout << "\nTesting Unreachable Upstream..." << std::endl;
+
+    UpstreamClient::Config config;
+    config.datamuseBaseUrl = "http://127.0.0.1:1";  // Nothing listens here
+    config.timeoutMs = 500;
+    UpstreamClient client(config);
+
+    auto start = Clock::now();
+    auto deadline = client.defaultDeadline();
+    auto pending = client.fetchAutocompleteAsync("offline", 10, deadline);
+    auto result = UpstreamClient::await(pending, deadline);
+
+    ASSERT_TEST(!result.ok && !result.error.empty(), "Connection failure reported");
+    ASSERT_TEST(elapsedMs(start) < 500, "Refused connection fails fast");
+}
+
+#endif // !_WIN32
+
+// ==================== MAIN TEST RUNNER ====================
+
+int main() {
+    std::cout << "=====================================" << std::endl;
+    std::cout << "   UPSTREAM CLIENT TESTS" << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+#ifdef _WIN32
+    std::cout << "\nSkipped: the stand-in server uses POSIX sockets" << std::endl;
+#else
+    testTimeToLiveCache();
+    testMergeRanked();
+
+    {
+        StandInServer server;
+        testFetchAndCache(server);
+        testDefinitions(server);
+        testDeadline(server);
+        testCircuitBreaker(server);
+        testLocalFirstRouting(server);
+    }
+
+    testDictionaryReload();
+    testUnreachableUpstream();
+#endif
+
+    std::cout << "\n=====================================" << std::endl;
+    std::cout << "TEST RESULTS:" << std::endl;
+    std::cout << "  Passed: " << tests_passed << std::endl;
+    std::cout << "  Failed: " << tests_failed << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+    if (tests_failed == 0) {
+        std::cout << "\n✓ ALL UPSTREAM CLIENT TESTS PASSED!" << std::endl;
+        std::cout << "=====================================" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n✗ SOME TESTS FAILED!" << std::endl;
+        std::cout << "=====================================" << std::endl;
+        return 1;
+    }
+}
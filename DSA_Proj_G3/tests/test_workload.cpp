@@ -0,0 +1,175 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+#include "../include/workload.h"
+#include "../include/editdistance.h"
+
+// Test counter
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define ASSERT_TEST(condition, message) \
+    if (condition) { \
+        tests_passed++; \
+        std::cout << "✓ " << message << std::endl; \
+    } else { \
+        tests_failed++; \
+        std::cout << "✗ " << message << " FAILED!" << std::endl; \
+    }
+
+std::vector<std::pair<std::string, int>> generate(const WorkloadGenerator::DictionaryConfig& config) {
+    std::vector<std::pair<std::string, int>> words;
+    WorkloadGenerator::generateDictionary(config, [&words](const std::string& word, int frequency) {
+        words.push_back({word, frequency});
+    });
+    return words;
+}
+
+// ==================== TEST FUNCTIONS ====================
+
+void testZipfDistribution() {
+    std::cout << "\nTesting Zipf Distribution..." << std::endl;
+
+    std::mt19937_64 rng(1);
+    ZipfDistribution zipf(1000, 1.0);
+    std::map<uint64_t, int> counts;
+    bool inRange = true;
+    const int draws = 200000;
+    for (int i = 0; i < draws; i++) {
+        uint64_t rank = zipf.sample(rng);
+        inRange = inRange && rank >= 1 && rank <= 1000;
+        counts[rank]++;
+    }
+
+    // H(1000) ~ 7.485: rank 1 gets ~13.4%, rank 2 half of that
+    double top = counts[1] / static_cast<double>(draws);
+    double ratio = counts[1] / static_cast<double>(counts[2]);
+    ASSERT_TEST(inRange, "Ranks stay within 1..n");
+    ASSERT_TEST(top > 0.12 && top < 0.15, "Rank 1 drawn with probability 1/H(n)");
+    ASSERT_TEST(ratio > 1.8 && ratio < 2.2, "P(1) / P(2) = 2 for exponent 1");
+
+    ZipfDistribution single(1, 1.0);
+    ASSERT_TEST(single.sample(rng) == 1, "Single rank always drawn");
+}
+
+void testDictionary() {
+    std::cout << "\nTesting Dictionary Generation..." << std::endl;
+
+    WorkloadGenerator::DictionaryConfig config;
+    config.words = 20000;
+    config.minLength = 4;
+    config.maxLength = 9;
+    auto words = generate(config);
+
+    std::set<std::string> distinct;
+    bool lengthsOk = true;
+    bool lettersOk = true;
+    for (const auto& entry : words) {
+        distinct.insert(entry.first);
+        lengthsOk = lengthsOk && entry.first.size() >= 4 && entry.first.size() <= 9;
+        for (char ch : entry.first) {
+            lettersOk = lettersOk && ch >= 'a' && ch <= 'z';
+        }
+    }
+    ASSERT_TEST(words.size() == 20000 && distinct.size() == 20000, "Requested number of distinct words");
+    ASSERT_TEST(lengthsOk && lettersOk, "Lowercase words within the length bounds");
+    ASSERT_TEST(words[0].second == 1000000 && words[1].second == 500000 && words.back().second == 50,
+                "Zipf frequencies by rank");
+
+    auto again = generate(config);
+    config.seed = 43;
+    auto other = generate(config);
+    ASSERT_TEST(again == words && other != words, "Same seed, same dictionary");
+}
+
+void testMisspell() {
+    std::cout << "\nTesting Misspellings..." << std::endl;
+
+    std::mt19937_64 rng(3);
+    bool changed = true;
+    bool close = true;
+    for (int i = 0; i < 2000; i++) {
+        std::string word = i % 2 ? "spelling" : "ball";
+        std::string typo = WorkloadGenerator::misspell(word, rng);
+        changed = changed && typo != word;
+        // One error: distance 1, or 2 for a transposition
+        close = close && EditDistance::calculate(word, typo) <= 2;
+    }
+    ASSERT_TEST(changed, "Every typo differs from the word");
+    ASSERT_TEST(close, "Typos are one error away");
+    ASSERT_TEST(WorkloadGenerator::misspell("a", rng) == "a", "Single letters are left alone");
+}
+
+void testQueries() {
+    std::cout << "\nTesting Query Streams..." << std::endl;
+
+    std::vector<std::pair<std::string, int>> dictionary = {
+        {"rare", 1}, {"common", 1000}, {"medium", 50}
+    };
+    WorkloadGenerator::QueryConfig config;
+    config.queries = 5000;
+    WorkloadGenerator generator(dictionary, config);
+
+    std::map<WorkloadGenerator::QueryType, int> types;
+    std::map<std::string, int> intended;
+    bool prefixesOk = true;
+    bool keystrokesInOrder = true;
+    std::string lastKeystroke;
+    size_t produced = generator.generateQueries([&](const WorkloadGenerator::Query& query) {
+        types[query.type]++;
+        intended[query.intended]++;
+        if (query.type != WorkloadGenerator::QueryType::Typo) {
+            prefixesOk = prefixesOk && !query.text.empty() && query.intended.compare(0, query.text.size(), query.text) == 0;
+        }
+        if (query.type == WorkloadGenerator::QueryType::Keystroke) {
+            // Each key either extends the previous query or starts a new word
+            keystrokesInOrder = keystrokesInOrder && (query.text.size() == 1 ||
+                query.text.size() == lastKeystroke.size() + 1);
+            lastKeystroke = query.text;
+        } else {
+            lastKeystroke.clear();
+        }
+    });
+
+    ASSERT_TEST(produced == 5000, "Exact number of queries");
+    ASSERT_TEST(prefixesOk, "Prefix and keystroke queries are prefixes of the intended word");
+    ASSERT_TEST(keystrokesInOrder, "Keystroke sessions grow one character at a time");
+    ASSERT_TEST(intended["common"] > intended["medium"] && intended["medium"] > intended["rare"],
+                "Frequent words are queried most");
+    ASSERT_TEST(types[WorkloadGenerator::QueryType::Prefix] > 0 &&
+                types[WorkloadGenerator::QueryType::Keystroke] > 0 &&
+                types[WorkloadGenerator::QueryType::Typo] > 0, "All query types present");
+
+    WorkloadGenerator empty({}, config);
+    ASSERT_TEST(empty.generateQueries([](const WorkloadGenerator::Query&) {}) == 0,
+                "No queries from an empty dictionary");
+}
+
+// ==================== MAIN TEST RUNNER ====================
+
+int main() {
+    std::cout << "=====================================" << std::endl;
+    std::cout << "   WORKLOAD GENERATOR TESTS" << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+    testZipfDistribution();
+    testDictionary();
+    testMisspell();
+    testQueries();
+
+    std::cout << "\n=====================================" << std::endl;
+    std::cout << "TEST RESULTS:" << std::endl;
+    std::cout << "  Passed: " << tests_passed << std::endl;
+    std::cout << "  Failed: " << tests_failed << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+    if (tests_failed == 0) {
+        std::cout << "\n✓ ALL WORKLOAD GENERATOR TESTS PASSED!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n✗ SOME TESTS FAILED!" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,640 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../include/filehandler.h"
+#include "../include/utils.h"
+
+/**
+ * HTTP load generator for the /query endpoint (POSIX sockets; Linux/macOS)
+ *
+ * Replays a query file against a running server:
+ * - Closed loop (default): each of --concurrency workers sends its next
+ *   request as soon as the previous answer arrives
+ * - Open loop (--qps R): requests are scheduled at a fixed rate no matter
+ *   how fast the server answers; latency is measured from the scheduled
+ *   send time, so a stalled server is charged for every request it kept
+ *   waiting (no coordinated omission). Service time (actual send to
+ *   answer) is reported next to it.
+ *
+ * --stub runs a local stand-in for Datamuse / DictionaryAPI and --spawn
+ * starts the server pointed at it, so results do not depend on the network:
+ *   loadgen --spawn ./autocomplete_server --stub --queries build/queries.tsv --qps 500
+ *
+ * Query files are workloadgen output (type <TAB> text <TAB> intended; typos
+ * are sent as spellcheck, the rest as autocomplete) or one query per line.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+// ==================== HTTP CLIENT ====================
+
+/**
+ * Send one request on a new connection (the server closes it after every
+ * answer) and read the whole response
+ * @return: HTTP status code, or -1 if the connection or I/O failed
+ */
+int sendRequest(const sockaddr_in& target, const std::string& request, int timeoutMs) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    timeval timeout;
+    timeout.tv_sec = timeoutMs / 1000;
+    timeout.tv_usec = (timeoutMs % 1000) * 1000;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    int noDelay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+    if (connect(fd, reinterpret_cast<const sockaddr*>(&target), sizeof(target)) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    size_t sent = 0;
+    while (sent < request.size()) {
+        ssize_t n = send(fd, request.data() + sent, request.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            close(fd);
+            return -1;
+        }
+        sent += n;
+    }
+
+    std::string response;
+    char buffer[8192];
+    size_t expected = std::string::npos;
+    while (expected == std::string::npos || response.size() < expected) {
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) {
+            break;  // Closed by the server (or timed out)
+        }
+        response.append(buffer, n);
+
+        size_t headerEnd = response.find("\r\n\r\n");
+        if (expected == std::string::npos && headerEnd != std::string::npos) {
+            std::string headers = Utils::toLower(response.substr(0, headerEnd));
+            size_t pos = headers.find("content-length:");
+            if (pos != std::string::npos) {
+                expected = headerEnd + 4 + std::strtoul(headers.c_str() + pos + 15, nullptr, 10);
+            }
+        }
+    }
+    close(fd);
+
+    if (response.compare(0, 5, "HTTP/") != 0 || response.find(' ') == std::string::npos) {
+        return -1;
+    }
+    return std::atoi(response.c_str() + response.find(' ') + 1);
+}
+
+// ==================== UPSTREAM STUB ====================
+
+/**
+ * Keep-alive HTTP server standing in for Datamuse and DictionaryAPI
+ * Answers are derived from the query text, so every run sees the same data:
+ * - /sug?s=<p>          -> <p>, <p>s, <p>ing
+ * - /words?sp=<w>       -> <w>
+ * - /entries/en/<w>     -> one definition
+ */
+class UpstreamStub {
+private:
+    int listenSocket;
+    int port;
+    int delayMs;
+    std::thread acceptThread;
+    std::vector<std::thread> connectionThreads;
+    std::vector<int> clients;
+    std::mutex clientsMutex;
+
+    static std::string parameter(const std::string& path, const std::string& name) {
+        size_t query = path.find('?');
+        if (query == std::string::npos) return "";
+        size_t pos = path.find(name + "=", query);
+        if (pos == std::string::npos) return "";
+        pos += name.size() + 1;
+        return path.substr(pos, path.find('&', pos) - pos);
+    }
+
+    void respond(int client, int status, const std::string& body) {
+        std::string response = "HTTP/1.1 " + std::to_string(status) + (status == 200 ? " OK" : " Not Found") +
+                               "\r\nContent-Type: application/json\r\nContent-Length: " +
+                               std::to_string(body.size()) + "\r\n\r\n" + body;
+        send(client, response.data(), response.size(), MSG_NOSIGNAL);
+    }
+
+    void serve(int client) {
+        std::string buffer;
+        char chunk[4096];
+
+        while (true) {
+            size_t headerEnd;
+            while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+                ssize_t n = recv(client, chunk, sizeof(chunk), 0);
+                if (n <= 0) {
+                    return;
+                }
+                buffer.append(chunk, n);
+            }
+
+            std::string requestLine = buffer.substr(0, buffer.find("\r\n"));
+            buffer.erase(0, headerEnd + 4);
+            requests++;
+
+            size_t pathStart = requestLine.find(' ') + 1;
+            std::string path = requestLine.substr(pathStart, requestLine.find(' ', pathStart) - pathStart);
+
+            if (delayMs > 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+            }
+
+            if (path.find("/sug?") != std::string::npos) {
+                std::string prefix = parameter(path, "s");
+                respond(client, 200, "[{\"word\":\"" + prefix + "\",\"score\":3000},"
+                                     "{\"word\":\"" + prefix + "s\",\"score\":2000},"
+                                     "{\"word\":\"" + prefix + "ing\",\"score\":1000}]");
+            } else if (path.find("/words?") != std::string::npos) {
+                respond(client, 200, "[{\"word\":\"" + parameter(path, "sp") + "\",\"score\":1000}]");
+            } else if (path.find("/entries/en/") != std::string::npos) {
+                std::string word = path.substr(path.rfind('/') + 1);
+                respond(client, 200, "[{\"word\":\"" + word + "\",\"meanings\":[{\"definitions\":"
+                                     "[{\"definition\":\"Stand-in definition.\"}]}]}]");
+            } else {
+                respond(client, 404, "{\"title\":\"No Definitions Found\"}");
+            }
+        }
+    }
+
+public:
+    std::atomic<long long> requests;
+
+    /**
+     * Start listening on a free loopback port
+     * @param delay: Added to every answer, to imitate remote latency
+     */
+    explicit UpstreamStub(int delay) : listenSocket(-1), port(0), delayMs(delay), requests(0) {
+        listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        if (bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            listen(listenSocket, SOMAXCONN) != 0) {
+            Utils::logError("Upstream stub could not listen");
+            return;
+        }
+
+        socklen_t length = sizeof(address);
+        getsockname(listenSocket, reinterpret_cast<sockaddr*>(&address), &length);
+        port = ntohs(address.sin_port);
+
+        acceptThread = std::thread([this]() {
+            while (true) {
+                int client = accept(listenSocket, nullptr, nullptr);
+                if (client < 0) return;
+                std::lock_guard<std::mutex> lock(clientsMutex);
+                clients.push_back(client);
+                connectionThreads.emplace_back(&UpstreamStub::serve, this, client);
+            }
+        });
+    }
+
+    ~UpstreamStub() {
+        shutdown(listenSocket, SHUT_RDWR);
+        close(listenSocket);
+        if (acceptThread.joinable()) {
+            acceptThread.join();
+        }
+        for (int client : clients) {
+            shutdown(client, SHUT_RDWR);
+        }
+        for (std::thread& thread : connectionThreads) {
+            thread.join();
+        }
+        for (int client : clients) {
+            close(client);
+        }
+    }
+
+    int getPort() const { return port; }
+};
+
+// ==================== SERVER PROCESS ====================
+
+/**
+ * Start the server binary with its port and upstream URLs set
+ * @return: Child pid, or -1 on failure
+ */
+pid_t spawnServer(const std::string& binary, int port, int stubPort, const std::string& logFile) {
+    pid_t pid = fork();
+    if (pid != 0) {
+        return pid;
+    }
+
+    setenv("AUTOCOMPLETE_PORT", std::to_string(port).c_str(), 1);
+    if (stubPort > 0) {
+        std::string stub = "http://127.0.0.1:" + std::to_string(stubPort);
+        setenv("AUTOCOMPLETE_DATAMUSE_URL", stub.c_str(), 1);
+        setenv("AUTOCOMPLETE_DICTIONARY_URL", (stub + "/entries/en").c_str(), 1);
+    }
+    // Replayed queries must not end up in the learned frequencies
+    setenv("AUTOCOMPLETE_FREQUENCY_LOG", "off", 0);
+
+    int log = open(logFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (log >= 0) {
+        dup2(log, STDOUT_FILENO);
+        dup2(log, STDERR_FILENO);
+        close(log);
+    }
+
+    execl(binary.c_str(), binary.c_str(), static_cast<char*>(nullptr));
+    _exit(127);
+}
+
+/**
+ * Poll GET /health until the server answers
+ * @return: false if it exited or did not come up in time
+ */
+bool waitForServer(const sockaddr_in& target, pid_t pid, int timeoutMs) {
+    const std::string health = "GET /health HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n";
+    Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    while (Clock::now() < deadline) {
+        if (sendRequest(target, health, 1000) == 200) {
+            return true;
+        }
+        int status;
+        if (pid > 0 && waitpid(pid, &status, WNOHANG) == pid) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    return false;
+}
+
+// ==================== LOAD ====================
+
+/**
+ * Load settings
+ */
+struct LoadConfig {
+    std::string host = "127.0.0.1";
+    int port = 8080;
+    int concurrency = 8;
+    double qps = 0;             // 0 = closed loop
+    double durationSeconds = 10;
+    double warmupSeconds = 1;   // Requests scheduled before this are not recorded
+    long long maxRequests = 0;  // 0 = until the duration is over
+    int timeoutMs = 5000;
+};
+
+/**
+ * Measurements of one worker (merged at the end)
+ */
+struct WorkerResult {
+    std::vector<double> latencyUs;  // From the scheduled send time (every request)
+    std::vector<double> serviceUs;  // From the actual send time (every request)
+    std::vector<double> errorUs;    // latencyUs of HTTP errors and failures only
+    long long ok = 0;
+    long long httpErrors = 0;       // Non-2xx answers
+    long long failures = 0;         // Connect / I/O failures and timeouts
+};
+
+/**
+ * Summary of a sorted latency sample
+ */
+struct LatencySummary {
+    double mean = 0, p50 = 0, p90 = 0, p99 = 0, p999 = 0, max = 0;
+};
+
+double percentile(const std::vector<double>& sorted, double percent) {
+    if (sorted.empty()) return 0;
+    size_t rank = static_cast<size_t>(percent / 100.0 * sorted.size());
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+LatencySummary summarize(std::vector<double>& samplesUs) {
+    LatencySummary summary;
+    if (samplesUs.empty()) {
+        return summary;
+    }
+    std::sort(samplesUs.begin(), samplesUs.end());
+    summary.mean = Utils::average(samplesUs) / 1000.0;
+    summary.p50 = percentile(samplesUs, 50) / 1000.0;
+    summary.p90 = percentile(samplesUs, 90) / 1000.0;
+    summary.p99 = percentile(samplesUs, 99) / 1000.0;
+    summary.p999 = percentile(samplesUs, 99.9) / 1000.0;
+    summary.max = samplesUs.back() / 1000.0;
+    return summary;
+}
+
+/**
+ * Build one POST /query request per query line
+ */
+std::vector<std::string> loadRequests(const std::string& filename, const LoadConfig& config) {
+    std::vector<std::string> requests;
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        Utils::logError("Cannot open query file " + filename);
+        return requests;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+
+        std::string mode = "autocomplete";
+        std::string text = line;
+        std::vector<std::string> fields = Utils::split(line, '\t');
+        if (fields.size() >= 2) {
+            mode = fields[0] == "typo" ? "spellcheck" : "autocomplete";
+            text = fields[1];
+        }
+
+        std::string body = "{\"query\":\"" + FileHandler::escapeJSON(text) + "\",\"mode\":\"" + mode + "\"}";
+        requests.push_back("POST /query HTTP/1.1\r\nHost: " + config.host + ":" + std::to_string(config.port) +
+                           "\r\nContent-Type: application/json\r\nContent-Length: " +
+                           std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body);
+    }
+    return requests;
+}
+
+/**
+ * Run the load and merge the worker results
+ * @return: Merged result; elapsedSeconds is the measured window
+ */
+WorkerResult runLoad(const LoadConfig& config, const sockaddr_in& target,
+                     const std::vector<std::string>& requests, double& elapsedSeconds) {
+    std::atomic<long long> nextRequest(0);
+    std::vector<WorkerResult> results(config.concurrency);
+    std::vector<std::thread> workers;
+
+    Clock::time_point start = Clock::now();
+    Clock::time_point measureFrom = start + std::chrono::microseconds(static_cast<long long>(config.warmupSeconds * 1e6));
+    Clock::time_point end = measureFrom + std::chrono::microseconds(static_cast<long long>(config.durationSeconds * 1e6));
+    double intervalUs = config.qps > 0 ? 1e6 / config.qps : 0;
+
+    for (int w = 0; w < config.concurrency; w++) {
+        workers.emplace_back([&, w]() {
+            WorkerResult& result = results[w];
+            while (true) {
+                long long i = nextRequest++;
+                if (config.maxRequests > 0 && i >= config.maxRequests) break;
+
+                Clock::time_point scheduled;
+                if (intervalUs > 0) {
+                    // Open loop: request i is due at a fixed time
+                    scheduled = start + std::chrono::microseconds(static_cast<long long>(i * intervalUs));
+                    if (scheduled >= end) break;
+                    std::this_thread::sleep_until(scheduled);
+                } else {
+                    scheduled = Clock::now();
+                    if (scheduled >= end) break;
+                }
+
+                Clock::time_point sent = Clock::now();
+                int status = sendRequest(target, requests[i % requests.size()], config.timeoutMs);
+                Clock::time_point done = Clock::now();
+
+                if (scheduled < measureFrom) continue;
+
+                // Failures and timeouts stay in the percentiles: leaving
+                // them out would make an overloaded server look faster
+                double latencyUs = std::chrono::duration<double, std::micro>(done - scheduled).count();
+                result.latencyUs.push_back(latencyUs);
+                result.serviceUs.push_back(std::chrono::duration<double, std::micro>(done - sent).count());
+
+                if (status >= 200 && status < 300) {
+                    result.ok++;
+                } else {
+                    if (status < 0) result.failures++;
+                    else result.httpErrors++;
+                    result.errorUs.push_back(latencyUs);
+                }
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    Clock::time_point finished = Clock::now();   // Late answers count against throughput
+    elapsedSeconds = std::max(1e-9, std::chrono::duration<double>(finished - measureFrom).count());
+
+    WorkerResult merged;
+    for (WorkerResult& result : results) {
+        merged.latencyUs.insert(merged.latencyUs.end(), result.latencyUs.begin(), result.latencyUs.end());
+        merged.serviceUs.insert(merged.serviceUs.end(), result.serviceUs.begin(), result.serviceUs.end());
+        merged.errorUs.insert(merged.errorUs.end(), result.errorUs.begin(), result.errorUs.end());
+        merged.ok += result.ok;
+        merged.httpErrors += result.httpErrors;
+        merged.failures += result.failures;
+    }
+    return merged;
+}
+
+void printSummary(const std::string& label, const LatencySummary& s) {
+    std::cout << std::left << std::setw(16) << label << std::right << std::fixed << std::setprecision(3)
+              << std::setw(10) << s.mean << std::setw(10) << s.p50 << std::setw(10) << s.p90
+              << std::setw(10) << s.p99 << std::setw(10) << s.p999 << std::setw(10) << s.max << std::endl;
+}
+
+std::string summaryJSON(const LatencySummary& s) {
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(3)
+         << "{\"mean\": " << s.mean << ", \"p50\": " << s.p50 << ", \"p90\": " << s.p90
+         << ", \"p99\": " << s.p99 << ", \"p999\": " << s.p999 << ", \"max\": " << s.max << "}";
+    return json.str();
+}
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " --queries <file> [options]\n"
+              << "  --host <ip>              Server address (default: 127.0.0.1)\n"
+              << "  --port <n>               Server port (default: 8080)\n"
+              << "  --concurrency <n>        Parallel connections (default: 8)\n"
+              << "  --qps <r>                Open loop at r requests/s (default: closed loop)\n"
+              << "  --duration <s>           Measured seconds (default: 10)\n"
+              << "  --warmup <s>             Unmeasured seconds first (default: 1)\n"
+              << "  --requests <n>           Stop after n requests (default: no limit)\n"
+              << "  --timeout-ms <n>         Per-request timeout (default: 5000)\n"
+              << "  --stub                   Serve the upstream APIs from a local stub\n"
+              << "  --stub-delay-ms <n>      Stub answer delay (default: 0)\n"
+              << "  --spawn <binary>         Start the server (pointed at the stub) for the run\n"
+              << "  --server-log <file>      Output of the spawned server (default: build/loadtest_server.log)\n"
+              << "  --json <file>            Also write the report as JSON\n";
+}
+
+int main(int argc, char* argv[]) {
+    Utils::setLogToStderr(true);
+
+    LoadConfig config;
+    std::string queryFile;
+    std::string spawnBinary;
+    std::string serverLog = "build/loadtest_server.log";
+    std::string jsonFile;
+    bool useStub = false;
+    int stubDelayMs = 0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--queries" && hasValue) queryFile = argv[++i];
+        else if (arg == "--host" && hasValue) config.host = argv[++i];
+        else if (arg == "--port" && hasValue) config.port = std::atoi(argv[++i]);
+        else if (arg == "--concurrency" && hasValue) config.concurrency = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--qps" && hasValue) config.qps = std::atof(argv[++i]);
+        else if (arg == "--duration" && hasValue) config.durationSeconds = std::atof(argv[++i]);
+        else if (arg == "--warmup" && hasValue) config.warmupSeconds = std::max(0.0, std::atof(argv[++i]));
+        else if (arg == "--requests" && hasValue) config.maxRequests = std::atoll(argv[++i]);
+        else if (arg == "--timeout-ms" && hasValue) config.timeoutMs = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--stub") useStub = true;
+        else if (arg == "--stub-delay-ms" && hasValue) stubDelayMs = std::atoi(argv[++i]);
+        else if (arg == "--spawn" && hasValue) spawnBinary = argv[++i];
+        else if (arg == "--server-log" && hasValue) serverLog = argv[++i];
+        else if (arg == "--json" && hasValue) jsonFile = argv[++i];
+        else if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        else {
+            Utils::logError("Unknown or incomplete option: " + arg);
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (queryFile.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    std::vector<std::string> requests = loadRequests(queryFile, config);
+    if (requests.empty()) {
+        Utils::logError("No queries in " + queryFile);
+        return 1;
+    }
+
+    sockaddr_in target = {};
+    target.sin_family = AF_INET;
+    target.sin_port = htons(config.port);
+    if (inet_pton(AF_INET, config.host.c_str(), &target.sin_addr) != 1) {
+        Utils::logError("Not an IPv4 address: " + config.host);
+        return 1;
+    }
+
+    UpstreamStub* stub = nullptr;
+    if (useStub) {
+        stub = new UpstreamStub(stubDelayMs);
+        Utils::logInfo("Upstream stub on http://127.0.0.1:" + std::to_string(stub->getPort()));
+    }
+
+    pid_t server = -1;
+    if (!spawnBinary.empty()) {
+        server = spawnServer(spawnBinary, config.port, stub ? stub->getPort() : 0, serverLog);
+        if (server < 0 || !waitForServer(target, server, 30000)) {
+            Utils::logError("Server did not start (see " + serverLog + ")");
+            if (server > 0) {
+                kill(server, SIGKILL);
+                waitpid(server, nullptr, 0);
+            }
+            delete stub;
+            return 1;
+        }
+        Utils::logInfo("Started " + spawnBinary + " (pid " + std::to_string(server) + ")");
+    } else if (!waitForServer(target, -1, 2000)) {
+        Utils::logError("No server answering on " + config.host + ":" + std::to_string(config.port));
+        delete stub;
+        return 1;
+    }
+
+    Utils::logInfo("Replaying " + std::to_string(requests.size()) + " queries, " +
+                   std::to_string(config.concurrency) + " connections, " +
+                   (config.qps > 0 ? "open loop at " + Utils::formatDouble(config.qps, 0) + " QPS" : "closed loop"));
+
+    double elapsed = 0;
+    WorkerResult result = runLoad(config, target, requests, elapsed);
+
+    if (server > 0) {
+        kill(server, SIGTERM);
+        waitpid(server, nullptr, 0);
+    }
+    long long upstreamRequests = stub ? stub->requests.load() : 0;
+    delete stub;
+
+    long long total = result.ok + result.httpErrors + result.failures;
+    double throughput = (result.ok + result.httpErrors) / elapsed;
+    double errorRate = total > 0 ? 100.0 * (result.httpErrors + result.failures) / total : 0.0;
+    LatencySummary latency = summarize(result.latencyUs);
+    LatencySummary service = summarize(result.serviceUs);
+    LatencySummary errorLatency = summarize(result.errorUs);
+
+    std::cout << "\nMode:        " << (config.qps > 0 ? "open loop, target " + Utils::formatDouble(config.qps, 0) + " QPS"
+                                                      : std::string("closed loop"))
+              << ", " << config.concurrency << " connections\n";
+    std::cout << "Requests:    " << total << " (" << result.ok << " ok, " << result.httpErrors
+              << " HTTP errors, " << result.failures << " failed)\n";
+    std::cout << "Throughput:  " << Utils::formatDouble(throughput, 1) << " req/s over "
+              << Utils::formatDouble(elapsed, 2) << " s\n";
+    if (useStub) {
+        std::cout << "Upstream:    " << upstreamRequests << " stub requests\n";
+    }
+    std::cout << "\n" << std::left << std::setw(16) << "latency (ms)" << std::right
+              << std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p90"
+              << std::setw(10) << "p99" << std::setw(10) << "p99.9" << std::setw(10) << "max" << std::endl;
+    printSummary("response", latency);
+    if (config.qps > 0) {
+        printSummary("service", service);
+    }
+    if (!result.errorUs.empty()) {
+        printSummary("errors only", errorLatency);
+    }
+    std::cout << "(all requests, failures and timeouts included; error rate "
+              << Utils::formatDouble(errorRate, 2) << "%)\n";
+
+    if (!jsonFile.empty()) {
+        std::ofstream out(jsonFile);
+        if (!out.is_open()) {
+            Utils::logError("Cannot write " + jsonFile);
+            return 1;
+        }
+        out << "{\n"
+            << "  \"timestamp\": \"" << Utils::getCurrentTimestamp() << "\",\n"
+            << "  \"mode\": \"" << (config.qps > 0 ? "open" : "closed") << "\",\n"
+            << "  \"targetQps\": " << config.qps << ",\n"
+            << "  \"concurrency\": " << config.concurrency << ",\n"
+            << "  \"durationSeconds\": " << elapsed << ",\n"
+            << "  \"requests\": " << total << ",\n"
+            << "  \"ok\": " << result.ok << ",\n"
+            << "  \"httpErrors\": " << result.httpErrors << ",\n"
+            << "  \"failures\": " << result.failures << ",\n"
+            << "  \"errorRate\": " << errorRate << ",\n"
+            << "  \"throughput\": " << throughput << ",\n"
+            << "  \"latencyMs\": " << summaryJSON(latency) << ",\n"
+            << "  \"serviceTimeMs\": " << summaryJSON(service) << ",\n"
+            << "  \"errorLatencyMs\": " << summaryJSON(errorLatency) << "\n"
+            << "}\n";
+    }
+
+    return result.ok > 0 ? 0 : 2;
+}
@@ -0,0 +1,163 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include "../include/workload.h"
+#include "../include/filehandler.h"
+#include "../include/utils.h"
+
+/**
+ * Workload generator for benchmarks and load tests
+ *
+ * Dictionary ("word frequency" lines, like data/dictionary.txt):
+ *   workloadgen dict --words 1000000 --out build/dict_1m.txt
+ *
+ * Queries (one per line: type <TAB> text <TAB> intended word):
+ *   workloadgen queries --dict build/dict_1m.txt --count 500000 --out build/queries.tsv
+ *
+ * Output goes to stdout without --out; progress and timings to stderr.
+ */
+
+void printUsage(const char* program) {
+    std::cerr << "Usage:\n"
+              << "  " << program << " dict [options]\n"
+              << "    --words <n>            Distinct words (default: 100000)\n"
+              << "    --zipf <s>             Frequency skew (default: 1.0)\n"
+              << "    --max-frequency <n>    Frequency of the top word (default: 1000000)\n"
+              << "    --length-mean <x>      Mean word length (default: 7.5)\n"
+              << "    --length-stddev <x>    Word length spread (default: 2.5)\n"
+              << "    --min-length <n>       Shortest word (default: 2)\n"
+              << "    --max-length <n>       Longest word (default: 20)\n"
+              << "  " << program << " queries --dict <file> [options]\n"
+              << "    --count <n>            Query lines (default: 100000)\n"
+              << "    --zipf <s>             Popularity skew (default: 1.0)\n"
+              << "    --mix <p,k,t>          Prefix / keystroke / typo weights (default: 50,30,20)\n"
+              << "    --second-error <x>     Chance of a second typo (default: 0.1)\n"
+              << "  Common:\n"
+              << "    --seed <n>             Random seed (default: 42 for dict, 7 for queries)\n"
+              << "    --out <file>           Output file (default: stdout)\n";
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || (std::string(argv[1]) != "dict" && std::string(argv[1]) != "queries")) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    Utils::setLogToStderr(true);
+
+    std::string command = argv[1];
+    std::string outFile;
+    std::string dictFile;
+    WorkloadGenerator::DictionaryConfig dictConfig;
+    WorkloadGenerator::QueryConfig queryConfig;
+
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--out" && hasValue) {
+            outFile = argv[++i];
+        }
+        else if (arg == "--seed" && hasValue) {
+            dictConfig.seed = queryConfig.seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--zipf" && hasValue) {
+            dictConfig.zipfExponent = queryConfig.zipfExponent = std::atof(argv[++i]);
+        }
+        else if (arg == "--words" && hasValue) {
+            dictConfig.words = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--max-frequency" && hasValue) {
+            dictConfig.maxFrequency = std::atoi(argv[++i]);
+        }
+        else if (arg == "--length-mean" && hasValue) {
+            dictConfig.lengthMean = std::atof(argv[++i]);
+        }
+        else if (arg == "--length-stddev" && hasValue) {
+            dictConfig.lengthStddev = std::atof(argv[++i]);
+        }
+        else if (arg == "--min-length" && hasValue) {
+            dictConfig.minLength = std::atoi(argv[++i]);
+        }
+        else if (arg == "--max-length" && hasValue) {
+            dictConfig.maxLength = std::atoi(argv[++i]);
+        }
+        else if (arg == "--dict" && hasValue) {
+            dictFile = argv[++i];
+        }
+        else if (arg == "--count" && hasValue) {
+            queryConfig.queries = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--mix" && hasValue) {
+            std::vector<std::string> weights = Utils::split(argv[++i], ',');
+            if (weights.size() != 3) {
+                Utils::logError("--mix needs three weights: prefix,keystroke,typo");
+                return 1;
+            }
+            queryConfig.prefixShare = std::atof(weights[0].c_str());
+            queryConfig.keystrokeShare = std::atof(weights[1].c_str());
+            queryConfig.typoShare = std::atof(weights[2].c_str());
+        }
+        else if (arg == "--second-error" && hasValue) {
+            queryConfig.secondErrorRate = std::atof(argv[++i]);
+        }
+        else {
+            Utils::logError("Unknown or incomplete option: " + arg);
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::ofstream file;
+    if (!outFile.empty()) {
+        file.open(outFile);
+        if (!file.is_open()) {
+            Utils::logError("Cannot write " + outFile);
+            return 1;
+        }
+    }
+    std::ostream& out = outFile.empty() ? std::cout : file;
+
+    Utils::Timer timer;
+    timer.start();
+    size_t produced = 0;
+
+    if (command == "dict") {
+        produced = WorkloadGenerator::generateDictionary(dictConfig,
+            [&out](const std::string& word, int frequency) {
+                out << word << ' ' << frequency << '\n';
+            });
+        if (produced < dictConfig.words) {
+            Utils::logWarning("Only " + std::to_string(produced) +
+                              " distinct words fit the length distribution");
+        }
+    } else {
+        if (dictFile.empty()) {
+            Utils::logError("queries needs --dict <file>");
+            return 1;
+        }
+        std::vector<std::pair<std::string, int>> dictionary = FileHandler::readDictionary(dictFile);
+        if (dictionary.empty()) {
+            Utils::logError("No words loaded from " + dictFile);
+            return 1;
+        }
+
+        WorkloadGenerator generator(dictionary, queryConfig);
+        produced = generator.generateQueries([&out](const WorkloadGenerator::Query& query) {
+            out << WorkloadGenerator::typeName(query.type) << '\t' << query.text << '\t'
+                << query.intended << '\n';
+        });
+    }
+
+    out.flush();
+    timer.stop();
+    if (!out) {
+        Utils::logError("Write failed");
+        return 1;
+    }
+    Utils::logInfo("Generated " + std::to_string(produced) + " " +
+                   (command == "dict" ? "words" : "queries") + " in " +
+                   Utils::formatDouble(timer.elapsedMilliseconds(), 0) + " ms");
+    return 0;
+}